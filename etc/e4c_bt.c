@@ -0,0 +1,223 @@
+/*
+ *
+ * @file		e4c_bt.c
+ *
+ * exceptions4c backtrace source code file
+ *
+ * @version		1.0
+ * @author		Copyright (c) 2012 Guillermo Calvo
+ *
+ * This is free software: you can redistribute it and/or modify it under the
+ * terms of the **GNU Lesser General Public License** as published by the
+ * *Free Software Foundation*, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * **WITHOUT ANY WARRANTY**; without even the implied warranty of
+ * **MERCHANTABILITY** or **FITNESS FOR A PARTICULAR PURPOSE**. See the
+ * [GNU Lesser General Public License](http://www.gnu.org/licenses/lgpl.html)
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * this file is undocumented on purpose (everything is documented in the header)
+ */
+
+
+# ifndef _GNU_SOURCE
+#	define _GNU_SOURCE
+# endif
+
+# include <stdlib.h>
+# include <string.h>
+# include <unistd.h>
+# include <execinfo.h>
+# include <dlfcn.h>
+# include "e4c_bt.h"
+
+
+/* (the frames of the library that may precede the ones of the client) */
+# ifndef E4C_BT_LIBRARY_FRAMES
+#	define E4C_BT_LIBRARY_FRAMES					8
+# endif
+
+/* (function pointers are compared as integers, since ISO C cannot convert them to void *) */
+# define IS_ENTRY_POINT(ADDRESS) ( \
+			(size_t)(ADDRESS) == (size_t)e4c_exception_throw_verbatim_ \
+		||	(size_t)(ADDRESS) == (size_t)e4c_exception_throw_payload_ \
+		||	(size_t)(ADDRESS) == (size_t)e4c_exception_throw_format_ \
+		||	(size_t)(ADDRESS) == (size_t)e4c_exception_rethrow_foreign_ \
+		)
+
+
+# define WRITE_TEXT(FD, TEXT) \
+			( (void)!write( (FD), (TEXT), strlen(TEXT) ) )
+
+
+typedef struct backtrace_struct e4c_backtrace;
+
+struct backtrace_struct{
+
+	/*@dependent@*/ /*@notnull@*/
+	e4c_bt_pool *		pool;
+	/*@dependent@*/ /*@null@*/
+	e4c_backtrace *		next;
+	int					size;
+	int					skip;
+	/* (as many frames as the depth of the pool) */
+	void *				frames[1];
+};
+
+struct e4c_bt_pool_{
+
+	int					depth;
+	size_t				stride;
+	/*@dependent@*/ /*@null@*/
+	e4c_backtrace * volatile	available;
+	/*@only@*/ /*@notnull@*/
+	char *				storage;
+};
+
+
+void e4c_bt_print(const e4c_exception * exception, int fd){
+
+	const e4c_backtrace *	trace = exception->custom_data;
+	int						size;
+
+	if(trace != NULL && trace->size > trace->skip){
+
+		size = trace->size - trace->skip;
+
+		if(size > trace->pool->depth - E4C_BT_LIBRARY_FRAMES){
+			size = trace->pool->depth - E4C_BT_LIBRARY_FRAMES;
+		}
+
+		backtrace_symbols_fd(trace->frames + trace->skip, size, fd);
+	}
+}
+
+void e4c_bt_print_exception(const e4c_exception * exception){
+
+	/* (the same as the default uncaught handler) */
+	e4c_print_exception(exception);
+
+	for(; exception != NULL; exception = exception->cause){
+
+		if(exception->custom_data != NULL){
+
+			WRITE_TEXT(STDERR_FILENO, "Backtrace of ");
+			WRITE_TEXT(STDERR_FILENO, exception->name);
+			WRITE_TEXT(STDERR_FILENO, ":\n");
+
+			e4c_bt_print(exception, STDERR_FILENO);
+
+			WRITE_TEXT(STDERR_FILENO, "\n");
+		}
+	}
+}
+
+e4c_bt_pool * e4c_bt_create_pool(int size, int depth){
+
+	e4c_bt_pool *	pool;
+	e4c_backtrace *	trace;
+	void *			preload[1];
+	int				index;
+
+	if(size <= 0 || depth <= 0){
+		return(NULL);
+	}
+
+	pool = malloc( sizeof(*pool) );
+
+	if(pool == NULL){
+		return(NULL);
+	}
+
+	pool->depth		= depth + E4C_BT_LIBRARY_FRAMES;
+	pool->stride	= sizeof(e4c_backtrace) + (size_t)(pool->depth - 1) * sizeof(void *);
+	pool->available	= NULL;
+	pool->storage	= malloc( (size_t)size * pool->stride );
+
+	if(pool->storage == NULL){
+		free(pool);
+		return(NULL);
+	}
+
+	/* link every backtrace into the list of available ones */
+	for(index = size - 1; index >= 0; index--){
+
+		trace			= (e4c_backtrace *)(pool->storage + (size_t)index * pool->stride);
+		trace->pool		= pool;
+		trace->next		= pool->available;
+		trace->size		= 0;
+		trace->skip		= 0;
+		pool->available	= trace;
+	}
+
+	/* the first call to backtrace loads libgcc (which allocates memory) */
+	(void)backtrace(preload, 1);
+
+	return(pool);
+}
+
+void e4c_bt_destroy_pool(e4c_bt_pool * pool){
+
+	if(pool != NULL){
+		free(pool->storage);
+		free(pool);
+	}
+}
+
+void * e4c_bt_initialize(const e4c_exception * exception){
+
+	e4c_bt_pool *	pool		= exception->custom_data;
+	e4c_backtrace *	trace;
+	Dl_info			info;
+	int				index;
+
+	if(pool == NULL){
+		/* (the exception is not traced) */
+		return(NULL);
+	}
+
+	/* (only the thread of the exception context takes backtraces, so there is no ABA problem) */
+	do{
+		trace = pool->available;
+		if(trace == NULL){
+			/* (the exception is not traced) */
+			return(NULL);
+		}
+	}while( !__sync_bool_compare_and_swap(&pool->available, trace, trace->next) );
+
+	trace->next		= NULL;
+	trace->size		= backtrace(trace->frames, pool->depth);
+
+	/* skip this function, and then up to the function that threw the exception */
+	trace->skip		= 1;
+	for(index = 1; index < trace->size && index < E4C_BT_LIBRARY_FRAMES; index++){
+		/* (the return address may lie just past the end of a function that does not return) */
+		if(dladdr( (char *)trace->frames[index] - 1, &info) != 0 && IS_ENTRY_POINT(info.dli_saddr) ){
+			trace->skip = index + 1;
+		}
+	}
+
+	return(trace);
+}
+
+void e4c_bt_finalize(void * custom_data){
+
+	e4c_backtrace * trace = custom_data;
+	e4c_backtrace * next;
+
+	if(trace != NULL){
+		/* (any thread may release the exception, so the backtrace is returned atomically) */
+		do{
+			next		= trace->pool->available;
+			trace->next	= next;
+		}while( !__sync_bool_compare_and_swap(&trace->pool->available, next, trace) );
+	}
+}
@@ -0,0 +1,296 @@
+/**
+ *
+ * @file        e4c_bt.h
+ *
+ * exceptions4c backtrace header file
+ *
+ * @version     1.0
+ * @author      Copyright (c) 2012 Guillermo Calvo
+ *
+ * @section e4c_bt_h exceptions4c backtrace header file
+ *
+ * This extension allows **exceptions4c** to attach a backtrace to every
+ * exception, through the [backtrace functionality](http://www.gnu.org/software/libc/manual/html_node/Backtraces.html)
+ * of the GNU C library:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * Uncaught NotEnoughMemoryException: False alarm!
+ *
+ *     thrown at myfunc (foobar.c:9)
+ *
+ * Backtrace of NotEnoughMemoryException:
+ * ./foobar(myfunc+0x4d)[0x401a2d]
+ * ./foobar(main+0x9c)[0x401b0c]
+ * /lib/libc.so.6(__libc_start_main+0xf5)[0x7f5e2c1e3b45]
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Unlike `e4c_st_g.h`, it does not need the program to be instrumented, so it
+ * is cheap enough to be left enabled in production. The backtraces are not
+ * allocated through `malloc`; each exception context takes them from its own
+ * pool, which is passed as the custom data of the context:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ * int main(int argc, char *argv[]){
+ *
+ *     e4c_bt_pool * pool = e4c_bt_create_pool(16, 32);
+ *
+ *     e4c_using_context(true){
+ *
+ *         e4c_context_set_handlers(
+ *             e4c_bt_print_exception,
+ *             pool,
+ *             e4c_bt_initialize,
+ *             e4c_bt_finalize
+ *         );
+ *
+ *         // ...
+ *     }
+ *
+ *     e4c_bt_destroy_pool(pool);
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The uncaught handler prints the exception just like the default one does,
+ * and then the backtrace of the exception and of its causes. The backtraces
+ * are written through `backtrace_symbols_fd`, which does not allocate memory
+ * either, so they can be printed even when the program has run out of memory.
+ * To get the names of the functions, the program needs to be linked with the
+ * `-rdynamic` flag (and with `-ldl` on older systems).
+ *
+ * Each backtrace starts at the function that threw the exception; the frames
+ * of the library are left out. They are told apart through `dladdr`, so they
+ * are printed too if the library was not linked with `-rdynamic` either, or
+ * if the exception was thrown by a signal.
+ *
+ * A pool must not be shared by different exception contexts (or threads), and
+ * it must not be destroyed while any of the exceptions that took a backtrace
+ * from it is still alive. Those exceptions may be released by other threads
+ * (see `#e4c_exception_release`), since backtraces are returned to the pool
+ * atomically. When the pool runs out of backtraces, new exceptions are simply
+ * not traced.
+ *
+ * This module is based on an example contributed by Tal Liron.
+ *
+ * @section license License
+ *
+ * > This is free software: you can redistribute it and/or modify it under the
+ * > terms of the **GNU Lesser General Public License** as published by the
+ * > *Free Software Foundation*, either version 3 of the License, or (at your
+ * > option) any later version.
+ * >
+ * > This software is distributed in the hope that it will be useful, but
+ * > **WITHOUT ANY WARRANTY**; without even the implied warranty of
+ * > **MERCHANTABILITY** or **FITNESS FOR A PARTICULAR PURPOSE**. See the
+ * > [GNU Lesser General Public License](http://www.gnu.org/licenses/lgpl.html)
+ * > for more details.
+ * >
+ * > You should have received a copy of the GNU Lesser General Public License
+ * > along with this software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+# ifndef EXCEPTIONS4C_BACKTRACE
+# define EXCEPTIONS4C_BACKTRACE
+
+
+# ifndef EXCEPTIONS4C
+#	include "e4c.h"
+# endif
+
+
+/*@-exportany@*/
+
+
+/**
+ * Represents a pool of backtraces
+ *
+ * @see     #e4c_bt_create_pool
+ */
+typedef struct e4c_bt_pool_ e4c_bt_pool;
+
+
+/**
+ * Creates a pool of backtraces
+ *
+ * @param   size
+ *          The number of backtraces in the pool
+ * @param   depth
+ *          The maximum number of frames of each backtrace
+ * @return  The new pool, or `NULL` if there is not enough memory
+ *
+ * This function allocates, at once, the memory of all the backtraces that
+ * can be taken from the pool. The pool can hold as many backtraces as
+ * exceptions can be alive at the same time in the exception context (an
+ * exception and each of its causes take one backtrace each).
+ *
+ * @see     #e4c_bt_destroy_pool
+ * @see     #e4c_bt_initialize
+ */
+/*@unused@*/ extern
+/*@only@*/ /*@null@*/
+e4c_bt_pool * e4c_bt_create_pool(
+	int size,
+	int depth
+)
+/*@globals
+	internalState
+@*/
+/*@modifies
+	internalState
+@*/
+;
+
+/**
+ * Destroys a pool of backtraces
+ *
+ * @param   pool
+ *          The pool to be destroyed
+ *
+ * This function releases the memory of the pool. No exception holding a
+ * backtrace taken from it can be alive any longer.
+ *
+ * @see     #e4c_bt_create_pool
+ */
+/*@unused@*/ extern
+void e4c_bt_destroy_pool(
+	/*@only@*/ /*@null@*/
+	e4c_bt_pool * pool
+)
+/*@modifies
+	pool
+@*/
+;
+
+/**
+ * Prints the backtrace of an exception
+ *
+ * @param   exception
+ *          The exception whose backtrace will be printed
+ * @param   fd
+ *          The file descriptor to which it will be written
+ *
+ * This function writes the backtrace of the exception (not of its causes)
+ * through `backtrace_symbols_fd`. Nothing is printed if the exception was not
+ * traced.
+ *
+ * This function is async-signal-safe: it neither allocates memory nor uses
+ * the standard I/O streams.
+ *
+ * @see     #e4c_bt_print_exception
+ */
+/*@unused@*/ extern
+void e4c_bt_print(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception * exception,
+	int fd
+)
+/*@globals
+	fileSystem
+@*/
+/*@modifies
+	fileSystem
+@*/
+;
+
+/**
+ * Prints a fatal error message and backtrace regarding the uncaught exception
+ *
+ * @param   exception
+ *          The uncaught exception
+ *
+ * This function prints the exception the same way `#e4c_print_exception`
+ * does, followed by the backtraces of the exception and of its causes, to the
+ * standard error output.
+ *
+ * It must be passed to `#e4c_context_set_handlers` as the handler for uncaught
+ * exceptions, along with `#e4c_bt_initialize` and `#e4c_bt_finalize`.
+ *
+ * @see     #e4c_context_set_handlers
+ * @see     #e4c_bt_print
+ * @see     #e4c_print_exception
+ * @see     #e4c_uncaught_handler
+ */
+/*@unused@*/ extern
+void e4c_bt_print_exception(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception * exception
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/**
+ * Takes the backtrace of a newly created exception
+ *
+ * @param   exception
+ *          The newly created exception
+ * @return  The backtrace to be assigned to the exception
+ *
+ * This function captures the backtrace at the moment the exception is being
+ * thrown, into a backtrace taken from the pool. It expects that the initial
+ * value of the custom data is the pool of the exception context.
+ *
+ * It must be passed to `#e4c_context_set_handlers` as the handler for
+ * initializing the custom data of an exception, along with `#e4c_bt_finalize`
+ * and `#e4c_bt_print_exception`.
+ *
+ * @see     #e4c_context_set_handlers
+ * @see     #e4c_bt_finalize
+ * @see     #e4c_bt_create_pool
+ * @see     #e4c_initialize_handler
+ */
+/*@unused@*/ extern
+/*@null@*/
+void * e4c_bt_initialize(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception * exception
+)
+/*@globals
+	internalState
+@*/
+/*@modifies
+	internalState
+@*/
+;
+
+/**
+ * Returns the backtrace of an exception which is about to be destroyed
+ *
+ * @param   custom_data
+ *          The backtrace to be returned to its pool
+ *
+ * It must be passed to `#e4c_context_set_handlers` as the handler for
+ * finalizing the custom data of an exception, along with `#e4c_bt_initialize`
+ * and `#e4c_bt_print_exception`.
+ *
+ * @see     #e4c_context_set_handlers
+ * @see     #e4c_bt_initialize
+ * @see     #e4c_finalize_handler
+ */
+/*@unused@*/ extern
+void e4c_bt_finalize(
+	/*@null@*/
+	void * custom_data
+)
+/*@globals
+	internalState
+@*/
+/*@modifies
+	internalState
+@*/
+;
+
+
+/*@=exportany@*/
+
+
+# endif
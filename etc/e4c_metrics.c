@@ -0,0 +1,573 @@
+/*
+ *
+ * @file		e4c_metrics.c
+ *
+ * exceptions4c metrics exporter source code file
+ *
+ * @version		1.0
+ * @author		Copyright (c) 2012 Guillermo Calvo
+ *
+ * This is free software: you can redistribute it and/or modify it under the
+ * terms of the **GNU Lesser General Public License** as published by the
+ * *Free Software Foundation*, either version 3 of the License, or (at your
+ * option) any later version.
+ *
+ * This software is distributed in the hope that it will be useful, but
+ * **WITHOUT ANY WARRANTY**; without even the implied warranty of
+ * **MERCHANTABILITY** or **FITNESS FOR A PARTICULAR PURPOSE**. See the
+ * [GNU Lesser General Public License](http://www.gnu.org/licenses/lgpl.html)
+ * for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public License
+ * along with this software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+/*
+ * this file is undocumented on purpose (everything is documented in the header)
+ */
+
+
+# include <stdio.h>
+# include <stddef.h>
+# include <stdarg.h>
+# include <string.h>
+# include <errno.h>
+# include <time.h>
+# include <pthread.h>
+# include <poll.h>
+# include <unistd.h>
+# include <sys/socket.h>
+# include <sys/time.h>
+# include <sys/un.h>
+# include "e4c_metrics.h"
+
+
+# ifndef E4C_METRICS_MAX_SITES
+#	define E4C_METRICS_MAX_SITES				256
+# endif
+
+# ifndef E4C_METRICS_BUFFER_SIZE
+#	define E4C_METRICS_BUFFER_SIZE				65536
+# endif
+
+# ifndef E4C_METRICS_MAX_PATH_LENGTH
+#	define E4C_METRICS_MAX_PATH_LENGTH			260
+# endif
+
+# ifndef E4C_METRICS_POLL_MILLISECONDS
+#	define E4C_METRICS_POLL_MILLISECONDS		250
+# endif
+
+# ifndef E4C_METRICS_CLIENT_MILLISECONDS
+#	define E4C_METRICS_CLIENT_MILLISECONDS		1000
+# endif
+
+
+# define HTTP_RESPONSE_HEADER \
+			"HTTP/1.0 200 OK\r\n" \
+			"Content-Type: text/plain; version=0.0.4\r\n" \
+			"Connection: close\r\n" \
+			"\r\n"
+
+# define COUNTER(STATISTIC, OFFSET) \
+			( *(const unsigned long *)( (const char *)(STATISTIC) + (OFFSET) ) )
+
+
+typedef struct metrics_event_struct e4c_metrics_event;
+typedef struct metrics_exporter_struct e4c_metrics_exporter;
+
+struct metrics_event_struct{
+
+	/*@observer@*/ /*@notnull@*/
+	const char *		name;
+	/*@observer@*/ /*@notnull@*/
+	const char *		help;
+	size_t				offset;
+};
+
+struct metrics_exporter_struct{
+
+	pthread_t			thread;
+	E4C_BOOL			running;
+	E4C_BOOL			stopping;
+	int					socket;
+	int					interval;
+	char				path[E4C_METRICS_MAX_PATH_LENGTH];
+	char				temporary_path[E4C_METRICS_MAX_PATH_LENGTH + 4];
+	char				buffer[E4C_METRICS_BUFFER_SIZE];
+};
+
+
+static
+/*@observer@*/
+const e4c_metrics_event events[] = {
+	{"thrown",		"Number of exceptions thrown",							offsetof(e4c_statistic, thrown)},
+	{"caught",		"Number of exceptions caught",							offsetof(e4c_statistic, caught)},
+	{"retried",		"Number of times a try block was retried",				offsetof(e4c_statistic, retried)},
+	{"reacquired",	"Number of times a with block was reacquired",			offsetof(e4c_statistic, reacquired)},
+	{"uncaught",	"Number of exceptions left uncaught",					offsetof(e4c_statistic, uncaught)}
+};
+
+static e4c_metrics_exporter exporter;
+
+static pthread_mutex_t exporter_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_cond_t exporter_stopped = PTHREAD_COND_INITIALIZER;
+
+
+static size_t _e4c_metrics_append(char * buffer, size_t size, size_t length, const char * format, ...){
+
+	va_list	arguments_list;
+	int		written;
+
+	/* (there must always be room for the null character) */
+	if(length + 1 >= size){
+		return(length);
+	}
+
+	va_start(arguments_list, format);
+	written = vsnprintf(buffer + length, size - length, format, arguments_list);
+	va_end(arguments_list);
+
+	if(written < 0 || (size_t)written >= size - length){
+		/* leave out the truncated text */
+		buffer[length] = '\0';
+		return(size);
+	}
+
+	return(length + (size_t)written);
+}
+
+static size_t _e4c_metrics_append_label(char * buffer, size_t size, size_t length, const char * name, const char * value){
+
+	length = _e4c_metrics_append(buffer, size, length, "%s=\"", name);
+
+	for(; value != NULL && *value != '\0'; value++){
+
+		/* backslash, double-quote and line feed must be escaped */
+		if(*value == '\\' || *value == '"'){
+			length = _e4c_metrics_append(buffer, size, length, "\\%c", *value);
+		}else if(*value == '\n'){
+			length = _e4c_metrics_append(buffer, size, length, "\\n");
+		}else{
+			length = _e4c_metrics_append(buffer, size, length, "%c", *value);
+		}
+	}
+
+	return( _e4c_metrics_append(buffer, size, length, "\"") );
+}
+
+static const char * _e4c_metrics_type_name(const e4c_statistic * statistic){
+
+	/* (the sites that could not be counted separately have no type) */
+	if(statistic->type == NULL || statistic->type->name == NULL){
+		return("(other)");
+	}
+
+	return(statistic->type->name);
+}
+
+static size_t _e4c_metrics_format_sites(char * buffer, size_t size, size_t length, const e4c_statistic * statistics, int count, const e4c_metrics_event * event){
+
+	size_t	checkpoint;
+	int		index;
+
+	length = _e4c_metrics_append(buffer, size, length, "# HELP e4c_site_%s_total %s, per type and site.\n", event->name, event->help);
+	length = _e4c_metrics_append(buffer, size, length, "# TYPE e4c_site_%s_total counter\n", event->name);
+
+	for(index = 0; index < count; index++){
+
+		checkpoint = length;
+
+		length = _e4c_metrics_append(buffer, size, length, "e4c_site_%s_total{", event->name);
+		length = _e4c_metrics_append_label(buffer, size, length, "type", _e4c_metrics_type_name(&statistics[index]) );
+		length = _e4c_metrics_append(buffer, size, length, ",");
+		length = _e4c_metrics_append_label(buffer, size, length, "file", statistics[index].file);
+		length = _e4c_metrics_append(buffer, size, length, ",line=\"%d\"} %lu\n", statistics[index].line, COUNTER(&statistics[index], event->offset) );
+
+		/* leave out the whole line if it does not fit */
+		if(length >= size){
+			buffer[checkpoint] = '\0';
+			return(checkpoint);
+		}
+	}
+
+	return(length);
+}
+
+static size_t _e4c_metrics_format_types(char * buffer, size_t size, size_t length, const e4c_statistic * statistics, int count, const e4c_metrics_event * event){
+
+	size_t			checkpoint;
+	unsigned long	total;
+	int				index;
+	int				other;
+
+	length = _e4c_metrics_append(buffer, size, length, "# HELP e4c_type_%s_total %s, per type.\n", event->name, event->help);
+	length = _e4c_metrics_append(buffer, size, length, "# TYPE e4c_type_%s_total counter\n", event->name);
+
+	for(index = 0; index < count; index++){
+
+		/* skip the types already added up */
+		for(other = 0; other < index; other++){
+			if(statistics[other].type == statistics[index].type){
+				break;
+			}
+		}
+		if(other < index){
+			continue;
+		}
+
+		/* add up all the sites of this type */
+		for(total = 0UL, other = index; other < count; other++){
+			if(statistics[other].type == statistics[index].type){
+				total += COUNTER(&statistics[other], event->offset);
+			}
+		}
+
+		checkpoint = length;
+
+		length = _e4c_metrics_append(buffer, size, length, "e4c_type_%s_total{", event->name);
+		length = _e4c_metrics_append_label(buffer, size, length, "type", _e4c_metrics_type_name(&statistics[index]) );
+		length = _e4c_metrics_append(buffer, size, length, "} %lu\n", total);
+
+		/* leave out the whole line if it does not fit */
+		if(length >= size){
+			buffer[checkpoint] = '\0';
+			return(checkpoint);
+		}
+	}
+
+	return(length);
+}
+
+size_t e4c_metrics_format(char * buffer, size_t size){
+
+	e4c_statistic	statistics[E4C_METRICS_MAX_SITES];
+	size_t			length		= 0;
+	size_t			event;
+	int				count;
+	int				index;
+	unsigned long	uncaught	= 0UL;
+	long			frames		= 0L;
+	long			exceptions	= 0L;
+
+	if(buffer == NULL){
+		E4C_THROW(NullPointerException, "Null buffer.");
+	}
+
+	if(size == 0){
+		return(0);
+	}
+
+	buffer[0] = '\0';
+
+	/* take a snapshot of the counters (without stopping the other threads) */
+	count = e4c_get_statistics(statistics, E4C_METRICS_MAX_SITES);
+	e4c_get_live_objects(&frames, &exceptions);
+
+	for(index = 0; index < count; index++){
+		uncaught += statistics[index].uncaught;
+	}
+
+	for(event = 0; event < sizeof(events) / sizeof(events[0]); event++){
+		length = _e4c_metrics_format_sites(buffer, size, length, statistics, count, &events[event]);
+		length = _e4c_metrics_format_types(buffer, size, length, statistics, count, &events[event]);
+	}
+
+	length = _e4c_metrics_append(buffer, size, length, "# HELP e4c_uncaught_total Number of exceptions left uncaught.\n# TYPE e4c_uncaught_total counter\ne4c_uncaught_total %lu\n", uncaught);
+	length = _e4c_metrics_append(buffer, size, length, "# HELP e4c_live_frames Number of exception frames currently alive.\n# TYPE e4c_live_frames gauge\ne4c_live_frames %ld\n", frames);
+	length = _e4c_metrics_append(buffer, size, length, "# HELP e4c_live_exceptions Number of exceptions currently alive.\n# TYPE e4c_live_exceptions gauge\ne4c_live_exceptions %ld\n", exceptions);
+
+	/* (the text was truncated) */
+	if(length >= size){
+		length = strlen(buffer);
+	}
+
+	return(length);
+}
+
+static long _e4c_metrics_time_left(const struct timespec * deadline){
+
+	struct timespec now;
+
+	if(clock_gettime(CLOCK_MONOTONIC, &now) != 0){
+		return(0L);
+	}
+
+	/* (milliseconds) */
+	return( (long)(deadline->tv_sec - now.tv_sec) * 1000L + (deadline->tv_nsec - now.tv_nsec) / 1000000L );
+}
+
+static E4C_BOOL _e4c_metrics_write_all(int descriptor, const char * text, size_t length, const struct timespec * deadline){
+
+	ssize_t written;
+
+	while(length > 0){
+
+		/* (a client that reads too slowly is given up on) */
+		if(_e4c_metrics_time_left(deadline) <= 0L){
+			return(E4C_FALSE);
+		}
+
+		written = write(descriptor, text, length);
+
+		if(written < 0){
+			if(errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK){
+				continue;
+			}
+			return(E4C_FALSE);
+		}
+
+		text	+= written;
+		length	-= (size_t)written;
+	}
+
+	return(E4C_TRUE);
+}
+
+static void _e4c_metrics_write_file(void){
+
+	FILE *	file;
+	size_t	length;
+
+	length = e4c_metrics_format(exporter.buffer, sizeof(exporter.buffer) );
+
+	file = fopen(exporter.temporary_path, "w");
+
+	if(file == NULL){
+		return;
+	}
+
+	if(fwrite(exporter.buffer, (size_t)1, length, file) != length){
+		(void)fclose(file);
+		(void)remove(exporter.temporary_path);
+		return;
+	}
+
+	if(fclose(file) != 0){
+		(void)remove(exporter.temporary_path);
+		return;
+	}
+
+	/* readers never see a partial write */
+	(void)rename(exporter.temporary_path, exporter.path);
+}
+
+static void _e4c_metrics_serve_client(int client){
+
+	struct pollfd	request;
+	struct timeval	timeout;
+	struct timespec	deadline;
+	char			discard[512];
+	ssize_t			received;
+	size_t			length;
+
+	/* the exporter cannot be stopped while it is serving a client, so a slow client is given up on */
+	if(clock_gettime(CLOCK_MONOTONIC, &deadline) != 0){
+		return;
+	}
+	deadline.tv_sec		+= E4C_METRICS_CLIENT_MILLISECONDS / 1000;
+	deadline.tv_nsec	+= (long)(E4C_METRICS_CLIENT_MILLISECONDS % 1000) * 1000000L;
+	if(deadline.tv_nsec >= 1000000000L){
+		deadline.tv_sec++;
+		deadline.tv_nsec -= 1000000000L;
+	}
+
+	/* (a blocked write wakes up every now and then to check the deadline) */
+	timeout.tv_sec	= E4C_METRICS_POLL_MILLISECONDS / 1000;
+	timeout.tv_usec	= (E4C_METRICS_POLL_MILLISECONDS % 1000) * 1000;
+	(void)setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, (socklen_t)sizeof(timeout) );
+
+	/* read (and ignore) whatever the client sends, without waiting too long */
+	request.fd		= client;
+	request.events	= POLLIN;
+
+	while(_e4c_metrics_time_left(&deadline) > 0L && poll(&request, (nfds_t)1, E4C_METRICS_POLL_MILLISECONDS / 5) > 0){
+		received = read(client, discard, sizeof(discard) - 1);
+		if(received <= 0){
+			break;
+		}
+		/* (stop at the end of the request headers) */
+		discard[received] = '\0';
+		if(strstr(discard, "\r\n\r\n") != NULL){
+			break;
+		}
+	}
+
+	length = e4c_metrics_format(exporter.buffer, sizeof(exporter.buffer) );
+
+	if( _e4c_metrics_write_all(client, HTTP_RESPONSE_HEADER, sizeof(HTTP_RESPONSE_HEADER) - 1, &deadline) ){
+		(void)_e4c_metrics_write_all(client, exporter.buffer, length, &deadline);
+	}
+}
+
+static void * _e4c_metrics_run(void * argument){
+
+	struct pollfd	listener;
+	struct timespec	deadline;
+	int				client;
+
+	(void)argument;
+
+	/* the observed threads are never stopped, their counters are just read */
+	(void)pthread_mutex_lock(&exporter_mutex);
+
+	while(!exporter.stopping){
+
+		if(exporter.socket < 0){
+
+			(void)pthread_mutex_unlock(&exporter_mutex);
+			_e4c_metrics_write_file();
+			(void)pthread_mutex_lock(&exporter_mutex);
+
+			if(clock_gettime(CLOCK_REALTIME, &deadline) != 0){
+				break;
+			}
+			deadline.tv_sec += exporter.interval;
+
+			while(!exporter.stopping){
+				if(pthread_cond_timedwait(&exporter_stopped, &exporter_mutex, &deadline) == ETIMEDOUT){
+					break;
+				}
+			}
+
+		}else{
+
+			(void)pthread_mutex_unlock(&exporter_mutex);
+
+			/* wake up every now and then to find out whether the exporter was stopped */
+			listener.fd		= exporter.socket;
+			listener.events	= POLLIN;
+
+			if(poll(&listener, (nfds_t)1, E4C_METRICS_POLL_MILLISECONDS) > 0){
+				client = accept(exporter.socket, NULL, NULL);
+				if(client >= 0){
+					_e4c_metrics_serve_client(client);
+					(void)close(client);
+				}
+			}
+
+			(void)pthread_mutex_lock(&exporter_mutex);
+		}
+	}
+
+	(void)pthread_mutex_unlock(&exporter_mutex);
+
+	/* leave the latest metrics behind */
+	if(exporter.socket < 0){
+		_e4c_metrics_write_file();
+	}
+
+	return(NULL);
+}
+
+static E4C_BOOL _e4c_metrics_start(const char * path, int socket, int interval){
+
+	int error_number;
+
+	(void)pthread_mutex_lock(&exporter_mutex);
+
+	if(exporter.running){
+		(void)pthread_mutex_unlock(&exporter_mutex);
+		errno = EBUSY;
+		return(E4C_FALSE);
+	}
+
+	(void)sprintf(exporter.path, "%s", path);
+	(void)sprintf(exporter.temporary_path, "%s.tmp", path);
+
+	exporter.socket		= socket;
+	exporter.interval	= interval;
+	exporter.stopping	= E4C_FALSE;
+
+	error_number = pthread_create(&exporter.thread, NULL, _e4c_metrics_run, NULL);
+
+	exporter.running = (error_number == 0);
+
+	(void)pthread_mutex_unlock(&exporter_mutex);
+
+	if(error_number != 0){
+		errno = error_number;
+		return(E4C_FALSE);
+	}
+
+	return(E4C_TRUE);
+}
+
+E4C_BOOL e4c_metrics_export(const char * path, int interval){
+
+	if(path == NULL){
+		E4C_THROW(NullPointerException, "Null path.");
+	}
+
+	if(strlen(path) >= (size_t)E4C_METRICS_MAX_PATH_LENGTH || interval <= 0){
+		errno = EINVAL;
+		return(E4C_FALSE);
+	}
+
+	return( _e4c_metrics_start(path, -1, interval) );
+}
+
+E4C_BOOL e4c_metrics_serve(const char * path){
+
+	struct sockaddr_un	address;
+	int					listener;
+	int					error_number;
+
+	if(path == NULL){
+		E4C_THROW(NullPointerException, "Null path.");
+	}
+
+	if(strlen(path) >= sizeof(address.sun_path) ){
+		errno = EINVAL;
+		return(E4C_FALSE);
+	}
+
+	(void)memset(&address, 0, sizeof(address) );
+	address.sun_family = AF_UNIX;
+	(void)strcpy(address.sun_path, path);
+
+	listener = socket(AF_UNIX, SOCK_STREAM, 0);
+	if(listener < 0){
+		return(E4C_FALSE);
+	}
+
+	(void)unlink(path);
+
+	if(	bind(listener, (struct sockaddr *)&address, (socklen_t)sizeof(address) ) != 0
+	||	listen(listener, 8) != 0
+	||	!_e4c_metrics_start(path, listener, 0) ){
+
+		error_number = errno;
+		(void)close(listener);
+		errno = error_number;
+		return(E4C_FALSE);
+	}
+
+	return(E4C_TRUE);
+}
+
+void e4c_metrics_stop(void){
+
+	(void)pthread_mutex_lock(&exporter_mutex);
+
+	if(!exporter.running){
+		(void)pthread_mutex_unlock(&exporter_mutex);
+		return;
+	}
+
+	exporter.stopping = E4C_TRUE;
+	(void)pthread_cond_signal(&exporter_stopped);
+
+	(void)pthread_mutex_unlock(&exporter_mutex);
+
+	(void)pthread_join(exporter.thread, NULL);
+
+	if(exporter.socket >= 0){
+		(void)close(exporter.socket);
+		(void)unlink(exporter.path);
+	}
+
+	exporter.running = E4C_FALSE;
+}
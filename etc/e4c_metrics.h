@@ -0,0 +1,217 @@
+/**
+ *
+ * @file        e4c_metrics.h
+ *
+ * exceptions4c metrics exporter header file
+ *
+ * @version     1.0
+ * @author      Copyright (c) 2012 Guillermo Calvo
+ *
+ * @section e4c_metrics_h exceptions4c metrics exporter header file
+ *
+ * This extension allows **exceptions4c** to export its exception statistics in
+ * the [Prometheus text format](https://prometheus.io/docs/instrumenting/exposition_formats/),
+ * without linking any metrics library:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * # TYPE e4c_site_thrown_total counter
+ * e4c_site_thrown_total{type="IllegalArgumentException",file="foobar.c",line="9"} 42
+ * ...
+ * # TYPE e4c_live_frames gauge
+ * e4c_live_frames 3
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The exporter runs on a background thread, which either rewrites a file
+ * periodically (so that it can be picked up, for example, by the *textfile
+ * collector* of the Prometheus node exporter) or serves the metrics on a Unix
+ * domain socket:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ * int main(int argc, char *argv[]){
+ *
+ *     e4c_metrics_serve("/run/foobar/metrics.sock");
+ *
+ *     // ...
+ *
+ *     e4c_metrics_stop();
+ * }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The socket answers every connection with an HTTP response, so it can be
+ * scraped through `curl --unix-socket /run/foobar/metrics.sock http://localhost/`.
+ * Clients are served one at a time; a client that takes longer than
+ * `E4C_METRICS_CLIENT_MILLISECONDS` (one second, by default) to send its
+ * request and read the response is disconnected.
+ *
+ * The background thread aggregates the counters of all threads through
+ * `#e4c_get_statistics` and `#e4c_get_live_objects`; the threads being
+ * observed are never stopped. Both the library and this module need to be
+ * compiled with `E4C_STATISTICS` (otherwise every counter is *zero*) and
+ * `E4C_THREADSAFE`, on a POSIX system.
+ *
+ * @section license License
+ *
+ * > This is free software: you can redistribute it and/or modify it under the
+ * > terms of the **GNU Lesser General Public License** as published by the
+ * > *Free Software Foundation*, either version 3 of the License, or (at your
+ * > option) any later version.
+ * >
+ * > This software is distributed in the hope that it will be useful, but
+ * > **WITHOUT ANY WARRANTY**; without even the implied warranty of
+ * > **MERCHANTABILITY** or **FITNESS FOR A PARTICULAR PURPOSE**. See the
+ * > [GNU Lesser General Public License](http://www.gnu.org/licenses/lgpl.html)
+ * > for more details.
+ * >
+ * > You should have received a copy of the GNU Lesser General Public License
+ * > along with this software. If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+# ifndef EXCEPTIONS4C_METRICS
+# define EXCEPTIONS4C_METRICS
+
+
+# ifndef EXCEPTIONS4C
+#	include "e4c.h"
+# endif
+
+
+/*@-exportany@*/
+
+
+/**
+ * Renders the exception statistics in the Prometheus text format
+ *
+ * @param   buffer
+ *          The buffer in which the metrics will be rendered
+ * @param   size
+ *          The size of the buffer
+ * @return  The length of the rendered text
+ *
+ * This function renders the counters of every type and site (thrown, caught,
+ * retried, reacquired and uncaught), the same counters added up per type, the
+ * total number of uncaught exceptions and the number of frames and exceptions
+ * currently alive.
+ *
+ * The text is always terminated by a null character. Whole lines that do not
+ * fit in the buffer are left out.
+ *
+ * @see     #e4c_metrics_export
+ * @see     #e4c_metrics_serve
+ * @see     #e4c_get_statistics
+ */
+/*@unused@*/ extern
+size_t e4c_metrics_format(
+	/*@out@*/ /*@notnull@*/
+	char * buffer,
+	size_t size
+)
+/*@globals
+	internalState
+@*/
+/*@modifies
+	buffer,
+	internalState
+@*/
+;
+
+/**
+ * Starts writing the exception statistics to a file periodically
+ *
+ * @param   path
+ *          The path of the file to be written
+ * @param   interval
+ *          The number of seconds between two consecutive writes
+ * @return  Whether the exporter could be started or not
+ *
+ * This function starts a background thread which renders the metrics every
+ * `interval` seconds and writes them to `path`. The file is replaced
+ * atomically (a temporary file is renamed), so readers never see a partial
+ * write.
+ *
+ * Only one exporter can be running at a time. If it cannot be started,
+ * `errno` tells why.
+ *
+ * @see     #e4c_metrics_stop
+ * @see     #e4c_metrics_serve
+ * @see     #e4c_metrics_format
+ */
+/*@unused@*/ extern
+E4C_BOOL e4c_metrics_export(
+	/*@in@*/ /*@notnull@*/
+	const char * path,
+	int interval
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/**
+ * Starts serving the exception statistics on a Unix domain socket
+ *
+ * @param   path
+ *          The path of the socket
+ * @return  Whether the exporter could be started or not
+ *
+ * This function starts a background thread which listens on `path` and writes
+ * the metrics, as an HTTP response, to every client that connects. Any
+ * previous file at `path` is removed.
+ *
+ * Only one exporter can be running at a time. If it cannot be started,
+ * `errno` tells why.
+ *
+ * @see     #e4c_metrics_stop
+ * @see     #e4c_metrics_export
+ * @see     #e4c_metrics_format
+ */
+/*@unused@*/ extern
+E4C_BOOL e4c_metrics_serve(
+	/*@in@*/ /*@notnull@*/
+	const char * path
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/**
+ * Stops the exporter
+ *
+ * This function stops the background thread started by `#e4c_metrics_export`
+ * or `#e4c_metrics_serve` and waits for it to finish. A file exporter writes
+ * the metrics one last time; a socket exporter removes its socket.
+ *
+ * @see     #e4c_metrics_export
+ * @see     #e4c_metrics_serve
+ */
+/*@unused@*/ extern
+void e4c_metrics_stop(
+	void
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+
+/*@=exportany@*/
+
+
+# endif
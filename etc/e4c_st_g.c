@@ -28,31 +28,40 @@
  */
 
 
+# ifndef _GNU_SOURCE
+#	define _GNU_SOURCE
+# endif
+
 # include <stdio.h>
 # include <string.h>
+# include <fcntl.h>
+# include <unistd.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <link.h>
 # include "e4c_st_g.h"
 
-
-# ifndef E4C_STACK_TRACE_ADDR2LINE_PATH
-#	define E4C_STACK_TRACE_ADDR2LINE_PATH			"addr2line"
+# ifdef E4C_THREADSAFE
+#	include <pthread.h>
+#	define THREAD_LOCAL								__thread
+# else
+#	define THREAD_LOCAL
 # endif
 
-# ifndef E4C_STACK_TRACE_ADDR2LINE_OPTIONS
-#	define E4C_STACK_TRACE_ADDR2LINE_OPTIONS		"-s -f -e"
-# endif
 
-# ifndef E4C_STACK_TRACE_ADDR2LINE_BUFFER_SIZE
-#	define E4C_STACK_TRACE_ADDR2LINE_BUFFER_SIZE	512
+# ifndef E4C_STACK_TRACE_POLICY_SITES
+#	define E4C_STACK_TRACE_POLICY_SITES			256
 # endif
 
-# ifndef E4C_STACK_TRACE_PRINTF_PRINT_POINTER
-#	define E4C_STACK_TRACE_PRINTF_PRINT_POINTER		"%p"
+# ifndef E4C_STACK_TRACE_TABLE_SIZE
+#	define E4C_STACK_TRACE_TABLE_SIZE			4096
 # endif
 
-# ifndef E4C_STACK_TRACE_PRINTF_POINTER_SIZE
-#	define E4C_STACK_TRACE_PRINTF_POINTER_SIZE		( 2 * sizeof(void *) )
+# ifndef E4C_STACK_TRACE_SYMBOL_CACHE_SIZE
+#	define E4C_STACK_TRACE_SYMBOL_CACHE_SIZE		1024
 # endif
 
+/* (the initial capacity of the shadow stack of each thread) */
 # ifndef E4C_STACK_TRACE_MAX_FUNCTION_CALLS
 #	define E4C_STACK_TRACE_MAX_FUNCTION_CALLS		256
 # endif
@@ -71,9 +80,18 @@
 
 
 typedef struct call_site_array e4c_call_site_array;
+typedef struct shadow_stack_struct e4c_shadow_stack;
 typedef struct debug_info_struct e4c_debug_info;
 typedef struct call_frame_struct e4c_call_frame;
 typedef struct call_stack_struct e4c_call_stack;
+typedef struct object_struct e4c_object;
+typedef struct function_struct e4c_function;
+typedef struct line_struct e4c_line;
+typedef struct reader_struct e4c_reader;
+typedef struct object_search_struct e4c_object_search;
+typedef struct symbol_struct e4c_symbol;
+typedef struct policy_site_struct e4c_policy_site;
+typedef struct trace_struct e4c_trace;
 
 struct call_site{
 
@@ -81,6 +99,9 @@ struct call_site{
 	const void *		caller;
 	/*@observer@*/ /*@null@*/
 	const void *		callee;
+	/* (the stack frame of the call, which is not part of the trace) */
+	/*@observer@*/ /*@null@*/
+	const void *		frame;
 };
 
 struct call_site_array{
@@ -88,7 +109,15 @@ struct call_site_array{
 	/*@observer@*/ /*@notnull@*/
 	const char *		binary_path;
 	int					size;
-	struct call_site	call_site[E4C_STACK_TRACE_MAX_FUNCTION_CALLS];
+	struct call_site	call_site[];
+};
+
+struct shadow_stack_struct{
+
+	int					size;
+	int					capacity;
+	/*@only@*/ /*@null@*/
+	struct call_site *	call_site;
 };
 
 struct debug_info_struct{
@@ -121,47 +150,176 @@ struct call_stack_struct{
 	e4c_call_frame *	last_frame;
 };
 
+struct function_struct{
+
+	ElfW(Addr)			address;
+	ElfW(Addr)			size;
+	/*@observer@*/ /*@notnull@*/
+	const char *		name;
+};
+
+struct line_struct{
+
+	ElfW(Addr)			address;
+	/*@observer@*/ /*@null@*/
+	const char *		file_path;
+	int					line_number;
+	int					end_sequence;
+	int					order;
+};
+
+struct object_struct{
+
+	ElfW(Addr)			base;
+	ElfW(Addr)			low;
+	ElfW(Addr)			high;
+	/*@observer@*/ /*@null@*/
+	const unsigned char * image;
+	size_t				image_size;
+	/*@only@*/ /*@null@*/
+	e4c_function *		functions;
+	int					function_count;
+	/*@only@*/ /*@null@*/
+	e4c_line *			lines;
+	int					line_count;
+	int					line_capacity;
+	/*@only@*/ /*@null@*/
+	e4c_object *		next;
+};
+
+struct reader_struct{
+
+	/*@observer@*/ /*@notnull@*/
+	const unsigned char * cursor;
+	/*@observer@*/ /*@notnull@*/
+	const unsigned char * end;
+	int					error;
+};
+
+struct policy_site_struct{
+
+	/*@observer@*/ /*@null@*/
+	const char *		file;
+	int					line;
+	int					count;
+};
+
+struct trace_struct{
+
+	/* (zero while the slot is empty) */
+	unsigned long				hash;
+	/*@only@*/ /*@null@*/
+	e4c_call_site_array *		call_site_array;
+	unsigned long				count;
+};
+
+struct symbol_struct{
+
+	/*@observer@*/ /*@null@*/
+	const void *		address;
+	/*@observer@*/ /*@null@*/
+	const char *		function_name;
+	/*@observer@*/ /*@null@*/
+	const char *		file_path;
+	int					line_number;
+};
+
+struct object_search_struct{
+
+	ElfW(Addr)			address;
+	/*@only@*/ /*@null@*/
+	e4c_object *		object;
+};
+
 
 # define STRING_BEGINS_WITH(STRING, PREFIX)			( strstr(STRING, PREFIX) == STRING )
 # define STR_EQUALS(STR1, STR2)						( strcmp(STR1, STR2) == 0 )
+# define TRACE_ID(CUSTOM_DATA)						( (uint32_t)(size_t)(CUSTOM_DATA) )
 # define DO_NOT_TRACE_FUNCTION						__attribute__ ((no_instrument_function))
 # define UNUSED_FUNCTION							__attribute__ ((unused))
-# define PRINTF_PRINT_2_POINTERS					" " E4C_STACK_TRACE_PRINTF_PRINT_POINTER " " E4C_STACK_TRACE_PRINTF_PRINT_POINTER
-# define SCANF_IGNORE_NEW_LINE						"%*[\n\r]"
-# define SCANF_IGNORE_COLON							"%*[:]"
-# define SCANF_READ_LINE							"%255[^\n\r]"
-# define SCANF_READ_STRING							"%255s"
-# define SCANF_READ_TWO_CHARS						"%2c"
-# define SCANF_READ_UP_TO_COLON						"%253[^:]"
-# define SCANF_READ_INTEGER							"%d"
-# define SCANF_PATTERN \
-			SCANF_READ_LINE SCANF_IGNORE_NEW_LINE \
-			SCANF_READ_TWO_CHARS SCANF_READ_UP_TO_COLON SCANF_IGNORE_COLON \
-			SCANF_READ_INTEGER SCANF_IGNORE_NEW_LINE
-# define PARSE_DEBUG_INFO(FILE, DEBUG_INFO) \
+# define MAIN_PROGRAM_PATH						"/proc/self/exe"
+# define MAX_ENTRY_FORMATS							16
+# define SYMBOL_TYPE(INFO)							ELF32_ST_TYPE(INFO) /* (the same for both classes) */
+# define ELF_NATIVE_CLASS							( sizeof(ElfW(Addr)) == 8 ? ELFCLASS64 : ELFCLASS32 )
+# define SECTION_FITS(OBJECT, SECTION) \
+			( \
+				(SECTION)->sh_type != SHT_NOBITS \
+				&& ( (SECTION)->sh_flags & SHF_COMPRESSED ) == 0 \
+				&& (SECTION)->sh_offset <= (OBJECT)->image_size \
+				&& (SECTION)->sh_size <= (OBJECT)->image_size - (SECTION)->sh_offset \
+			)
+# define INITIALIZE_READER(OBJECT, READER, SECTION) \
 			( \
-				fscanf(FILE, SCANF_PATTERN, \
-				(DEBUG_INFO)->function_name, \
-				(DEBUG_INFO)->file_path, \
-				&(DEBUG_INFO)->file_path[2], \
-				&(DEBUG_INFO)->line_number) == 4 \
+				(READER)->cursor	= (OBJECT)->image + (SECTION)->sh_offset, \
+				(READER)->end		= (READER)->cursor + (SECTION)->sh_size, \
+				(READER)->error		= 0 \
+			)
+# define ADD_LINE(OBJECT, FILES, FILE_BASE, FILE_COUNT, ADDRESS, FILE, LINE, END_SEQUENCE) \
+			_e4c_add_line( \
+				OBJECT, \
+				ADDRESS, \
+				( (FILE) >= (unsigned long)(FILE_BASE) && (FILE) - (FILE_BASE) < (unsigned long)(FILE_COUNT) ? (FILES)[(FILE) - (FILE_BASE)] : NULL ), \
+				LINE, \
+				END_SEQUENCE \
 			)
 
-# ifdef S_SPLINT_S
-#	define popen	fopen
-#	define pclose	fclose
-# endif
+# define DW_LNS_copy								1
+# define DW_LNS_advance_pc							2
+# define DW_LNS_advance_line						3
+# define DW_LNS_set_file							4
+# define DW_LNS_const_add_pc						8
+# define DW_LNS_fixed_advance_pc					9
+# define DW_LNE_end_sequence						1
+# define DW_LNE_set_address							2
+# define DW_LNE_define_file							3
+# define DW_LNCT_path								1
+# define DW_FORM_block								0x09
+# define DW_FORM_data1								0x0b
+# define DW_FORM_data2								0x05
+# define DW_FORM_data4								0x06
+# define DW_FORM_data8								0x07
+# define DW_FORM_data16								0x1e
+# define DW_FORM_line_strp							0x1f
+# define DW_FORM_string								0x08
+# define DW_FORM_strp								0x0e
+# define DW_FORM_udata								0x0f
 
 
-static e4c_call_site_array call_site_array = {
-	"",
-	0,
-	/*@-initallelements@*/
-	{
-		{NULL, NULL}
-	}
-	/*@=initallelements@*/
-};
+/* (each thread keeps its own stack, so the hooks need no synchronization) */
+static THREAD_LOCAL e4c_shadow_stack shadow_stack = {0, 0, NULL};
+
+/* (everything is traced by default) */
+static e4c_stack_trace_policy policy = {NULL, 0, 0};
+
+/* (odd while the policy is being set, so that throwers can read it without locking) */
+static unsigned long policy_version = 0UL;
+
+static e4c_policy_site policy_sites[E4C_STACK_TRACE_POLICY_SITES];
+
+static THREAD_LOCAL int sampling_count = 0;
+
+/* (the identifier of a trace is its slot plus one) */
+static e4c_trace traces[E4C_STACK_TRACE_TABLE_SIZE];
+
+/* (the addresses are resolved only when printed, and then cached) */
+static e4c_symbol symbol_cache[E4C_STACK_TRACE_SYMBOL_CACHE_SIZE];
+
+# ifdef E4C_THREADSAFE
+
+static pthread_mutex_t symbol_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_mutex_t policy_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_mutex_t policy_sites_mutex = PTHREAD_MUTEX_INITIALIZER;
+
+static pthread_once_t shadow_stack_once = PTHREAD_ONCE_INIT;
+
+static pthread_key_t shadow_stack_key;
+
+# endif
+
+/*@only@*/ /*@null@*/
+static e4c_object * objects = NULL;
 
 
 static
@@ -173,10 +331,10 @@ __cyg_profile_func_enter(
 	void * caller
 ) DO_NOT_TRACE_FUNCTION UNUSED_FUNCTION
 /*@globals
-	call_site_array
+	shadow_stack
 @*/
 /*@modifies
-	call_site_array
+	shadow_stack
 @*/
 ;
 
@@ -189,197 +347,1394 @@ __cyg_profile_func_exit(
 	void * caller
 ) DO_NOT_TRACE_FUNCTION UNUSED_FUNCTION
 /*@globals
-	call_site_array
+	shadow_stack
 @*/
 /*@modifies
-	call_site_array
+	shadow_stack
 @*/
 ;
 
 static
-/*@null@*/
-e4c_call_frame *
-_e4c_parse_call_frame_array(
-	e4c_call_site_array * call_site_array
+void
+_e4c_grow_shadow_stack(
+	void
 ) DO_NOT_TRACE_FUNCTION
 /*@globals
-	fileSystem
+	shadow_stack
 @*/
 /*@modifies
-	fileSystem
+	shadow_stack
 @*/
-/*@requires maxRead(call_site_array->call_site) >= call_site_array->size @*/
 ;
 
-inline static
-/*@null@*/
-e4c_call_stack *
-_e4c_parse_call_stack(
-	e4c_call_site_array * call_site_array
+# ifdef E4C_THREADSAFE
+
+static
+void
+_e4c_create_shadow_stack_key(
+	void
 ) DO_NOT_TRACE_FUNCTION
 /*@globals
-	fileSystem
+	shadow_stack_key
 @*/
 /*@modifies
-	fileSystem
+	shadow_stack_key
 @*/
-/*@requires maxRead(call_site_array->call_site) >= call_site_array->size @*/
 ;
 
-inline static
-/*@null@*/
-e4c_call_site_array *
-_e4c_capture_call_site_array(
-	/*@observer@*/ /*@notnull@*/
-	const char * binary_path
+static
+void
+_e4c_release_shadow_stack(
+	/*@temp@*/ /*@notnull@*/
+	void * stack
 ) DO_NOT_TRACE_FUNCTION
-/*@globals
-	call_site_array
+/*@modifies
+	stack
 @*/
 ;
 
-inline static
+# endif
+
+static
 int
-_e4c_print_call_frame(
-	/*@temp@*/ /*@notnull@*/
-	const char * binary_path,
-	/*@temp@*/ /*@notnull@*/
-	e4c_debug_info * debug_info,
-	/*@temp@*/ /*@notnull@*/
-	const char * * prefix_exclude,
-	int print_line
+_e4c_symbolize(
+	/*@observer@*/ /*@null@*/
+	const void * address,
+	/*@out@*/ /*@notnull@*/
+	e4c_debug_info * debug_info
 ) DO_NOT_TRACE_FUNCTION
 /*@globals
-	fileSystem
+	fileSystem,
+	objects,
+	symbol_cache
 @*/
 /*@modifies
-	fileSystem
-@*/
-/*@requires
-	maxRead(debug_info->function_name) >= 0
-	/\
-	maxRead(prefix_exclude) >= 0
+	fileSystem,
+	objects,
+	symbol_cache,
+	debug_info
 @*/
 ;
 
-inline static
+static
 void
-_e4c_print_call_stack(
+_e4c_resolve(
+	/*@observer@*/ /*@null@*/
+	const void * address,
+	/*@out@*/ /*@notnull@*/
+	e4c_symbol * symbol
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	fileSystem,
+	objects
+@*/
+/*@modifies
+	fileSystem,
+	objects,
+	symbol
+@*/
+;
+
+static
+/*@dependent@*/ /*@null@*/
+e4c_object *
+_e4c_find_object(
+	ElfW(Addr) address
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	fileSystem,
+	objects
+@*/
+/*@modifies
+	fileSystem,
+	objects
+@*/
+;
+
+static
+int
+_e4c_find_object_callback(
 	/*@temp@*/ /*@notnull@*/
-	e4c_call_stack * call_stack,
+	struct dl_phdr_info * info,
+	size_t size,
 	/*@temp@*/ /*@notnull@*/
-	const char * * prefix_exclude,
-	int max
-)
+	void * data
+) DO_NOT_TRACE_FUNCTION
 /*@globals
 	fileSystem
 @*/
 /*@modifies
-	fileSystem
+	fileSystem,
+	data
 @*/
 ;
 
-inline static
+static
 void
-_e4c_print_exception(
+_e4c_load_object(
 	/*@temp@*/ /*@notnull@*/
-	const e4c_exception * exception,
-	int is_cause,
+	e4c_object * object,
 	/*@temp@*/ /*@notnull@*/
-	const char * * prefix_exclude,
-	int max
+	const char * path
 ) DO_NOT_TRACE_FUNCTION
 /*@globals
 	fileSystem
 @*/
 /*@modifies
-	fileSystem
+	fileSystem,
+	object
 @*/
 ;
 
+static
+void
+_e4c_load_functions(
+	/*@temp@*/ /*@notnull@*/
+	e4c_object * object,
+	/*@temp@*/ /*@notnull@*/
+	const ElfW(Shdr) * symbols,
+	/*@temp@*/ /*@notnull@*/
+	const ElfW(Shdr) * names
+) DO_NOT_TRACE_FUNCTION
+/*@modifies
+	object
+@*/
+;
 
-static void __cyg_profile_func_enter(void * callee, void * caller){
-
-	if(call_site_array.size < E4C_STACK_TRACE_MAX_FUNCTION_CALLS){
-		call_site_array.call_site[call_site_array.size].callee = callee;
-		call_site_array.call_site[call_site_array.size].caller = caller;
-	}
-
-	call_site_array.size++;
-}
-
-static void __cyg_profile_func_exit(void * callee, void * caller){
-
-	if(call_site_array.size == 0){
-		return;
-	}
-
-	call_site_array.size--;
-}
-
-static e4c_call_frame * _e4c_parse_call_frame_array(e4c_call_site_array * call_site_array){
-
-	e4c_call_frame * call_frame = NULL;
+static
+void
+_e4c_load_lines(
+	/*@temp@*/ /*@notnull@*/
+	e4c_object * object,
+	/*@temp@*/ /*@notnull@*/
+	e4c_reader * section,
+	/*@temp@*/ /*@null@*/
+	const e4c_reader * strings,
+	/*@temp@*/ /*@null@*/
+	const e4c_reader * line_strings
+) DO_NOT_TRACE_FUNCTION
+/*@modifies
+	object,
+	section
+@*/
+;
 
-	if(call_site_array->size > 0){
+static
+void
+_e4c_load_line_unit(
+	/*@temp@*/ /*@notnull@*/
+	e4c_object * object,
+	/*@temp@*/ /*@notnull@*/
+	e4c_reader * unit,
+	int offset_size,
+	/*@temp@*/ /*@null@*/
+	const e4c_reader * strings,
+	/*@temp@*/ /*@null@*/
+	const e4c_reader * line_strings
+) DO_NOT_TRACE_FUNCTION
+/*@modifies
+	object,
+	unit
+@*/
+;
 
-		size_t	command_size;
-		char *	command;
+static
+int
+_e4c_add_line(
+	/*@temp@*/ /*@notnull@*/
+	e4c_object * object,
+	ElfW(Addr) address,
+	/*@observer@*/ /*@null@*/
+	const char * file_path,
+	int line_number,
+	int end_sequence
+) DO_NOT_TRACE_FUNCTION
+/*@modifies
+	object
+@*/
+;
 
-		command_size= 2 * ( /*@-sizeoftype@*/ E4C_STACK_TRACE_PRINTF_POINTER_SIZE /*@=sizeoftype@*/ + 1) * call_site_array->size + E4C_STACK_TRACE_ADDR2LINE_BUFFER_SIZE;
-		command		= calloc( command_size, (size_t)1 );
+static
+unsigned long
+_e4c_read_fixed(
+	/*@temp@*/ /*@notnull@*/
+	e4c_reader * reader,
+	int size
+) DO_NOT_TRACE_FUNCTION
+/*@modifies
+	reader
+@*/
+;
 
-		if(command != NULL){
+static
+unsigned long
+_e4c_read_unsigned_leb128(
+	/*@temp@*/ /*@notnull@*/
+	e4c_reader * reader
+) DO_NOT_TRACE_FUNCTION
+/*@modifies
+	reader
+@*/
+;
 
-			call_frame	= calloc( (size_t)call_site_array->size, sizeof(*call_frame) );
+static
+long
+_e4c_read_signed_leb128(
+	/*@temp@*/ /*@notnull@*/
+	e4c_reader * reader
+) DO_NOT_TRACE_FUNCTION
+/*@modifies
+	reader
+@*/
+;
 
-			if(call_frame != NULL){
+static
+/*@observer@*/ /*@null@*/
+const char *
+_e4c_read_string(
+	/*@temp@*/ /*@notnull@*/
+	e4c_reader * reader
+) DO_NOT_TRACE_FUNCTION
+/*@modifies
+	reader
+@*/
+;
 
-				FILE *	pipe;
-				int		index;
-				int		written;
+static
+/*@observer@*/ /*@null@*/
+const char *
+_e4c_read_form(
+	/*@temp@*/ /*@notnull@*/
+	e4c_reader * reader,
+	unsigned long form,
+	int offset_size,
+	/*@temp@*/ /*@null@*/
+	const e4c_reader * strings,
+	/*@temp@*/ /*@null@*/
+	const e4c_reader * line_strings
+) DO_NOT_TRACE_FUNCTION
+/*@modifies
+	reader
+@*/
+;
 
-				written = snprintf(command, command_size, "%s %s \"%s\"", E4C_STACK_TRACE_ADDR2LINE_PATH, E4C_STACK_TRACE_ADDR2LINE_OPTIONS, call_site_array->binary_path);
+static
+int
+_e4c_compare_functions(
+	/*@temp@*/ /*@notnull@*/
+	const void * function1,
+	/*@temp@*/ /*@notnull@*/
+	const void * function2
+) DO_NOT_TRACE_FUNCTION
+/*@*/
+;
 
-				for(index = 0; index < call_site_array->size; index++){
+static
+int
+_e4c_compare_lines(
+	/*@temp@*/ /*@notnull@*/
+	const void * line1,
+	/*@temp@*/ /*@notnull@*/
+	const void * line2
+) DO_NOT_TRACE_FUNCTION
+/*@*/
+;
 
-					written += snprintf(&command[written], command_size - written, PRINTF_PRINT_2_POINTERS, call_site_array->call_site[index].caller, call_site_array->call_site[index].callee);
+static
+/*@null@*/
+e4c_call_frame *
+_e4c_parse_call_frame_array(
+	e4c_call_site_array * call_site_array
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	fileSystem
+@*/
+/*@modifies
+	fileSystem
+@*/
+/*@requires maxRead(call_site_array->call_site) >= call_site_array->size @*/
+;
 
-					call_frame[index].caller.address		= call_site_array->call_site[index].caller;
-					call_frame[index].callee.address		= call_site_array->call_site[index].callee;
-					call_frame[index].caller.line_number	= 0;
-					call_frame[index].callee.line_number	= 0;
-					*call_frame[index].caller.function_name	= '\0';
-					*call_frame[index].callee.function_name	= '\0';
-					*call_frame[index].caller.file_path		= '\0';
-					*call_frame[index].callee.file_path		= '\0';
-					call_frame[index].previous				= ( index == 0 ? NULL : &call_frame[index - 1] );
-					call_frame[index].next					= ( index + 1 == call_site_array->size ? NULL : &call_frame[index + 1] );
-				}
+inline static
+/*@null@*/
+e4c_call_stack *
+_e4c_parse_call_stack(
+	e4c_call_site_array * call_site_array
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	fileSystem
+@*/
+/*@modifies
+	fileSystem
+@*/
+/*@requires maxRead(call_site_array->call_site) >= call_site_array->size @*/
+;
+
+static
+int
+_e4c_is_traced(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception * exception
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	policy,
+	policy_sites,
+	sampling_count
+@*/
+/*@modifies
+	policy_sites,
+	sampling_count
+@*/
+;
+
+static
+int
+_e4c_count_site(
+	/*@observer@*/ /*@null@*/
+	const char * file,
+	int line,
+	int first_throws
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	policy_sites
+@*/
+/*@modifies
+	policy_sites
+@*/
+;
+
+static
+uint32_t
+_e4c_intern_call_site_array(
+	/*@observer@*/ /*@notnull@*/
+	const char * binary_path
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	shadow_stack,
+	traces
+@*/
+/*@modifies
+	traces
+@*/
+;
+
+static
+int
+_e4c_same_call_sites(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_call_site_array * call_site_array,
+	int size
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	shadow_stack
+@*/
+;
+
+static
+/*@null@*/
+e4c_call_site_array *
+_e4c_wait_call_site_array(
+	/*@temp@*/ /*@notnull@*/
+	e4c_trace * trace
+) DO_NOT_TRACE_FUNCTION
+/*@*/
+;
+
+static
+/*@null@*/ /*@dependent@*/
+e4c_trace *
+_e4c_find_trace(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception * exception
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	traces
+@*/
+;
+
+inline static
+int
+_e4c_print_call_frame(
+	/*@temp@*/ /*@notnull@*/
+	const char * binary_path,
+	/*@temp@*/ /*@notnull@*/
+	e4c_debug_info * debug_info,
+	/*@temp@*/ /*@notnull@*/
+	const char * * prefix_exclude,
+	int print_line
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	fileSystem
+@*/
+/*@modifies
+	fileSystem
+@*/
+/*@requires
+	maxRead(debug_info->function_name) >= 0
+	/\
+	maxRead(prefix_exclude) >= 0
+@*/
+;
+
+inline static
+void
+_e4c_print_call_stack(
+	/*@temp@*/ /*@notnull@*/
+	e4c_call_stack * call_stack,
+	/*@temp@*/ /*@notnull@*/
+	const char * * prefix_exclude,
+	int max
+)
+/*@globals
+	fileSystem
+@*/
+/*@modifies
+	fileSystem
+@*/
+;
+
+inline static
+void
+_e4c_print_exception(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception * exception,
+	int is_cause,
+	/*@temp@*/ /*@notnull@*/
+	const char * * prefix_exclude,
+	int max
+) DO_NOT_TRACE_FUNCTION
+/*@globals
+	fileSystem
+@*/
+/*@modifies
+	fileSystem
+@*/
+;
+
+
+static void __cyg_profile_func_enter(void * callee, void * caller){
+
+	const void * frame = __builtin_frame_address(0);
+
+	/* drop the calls that were left by a longjmp (the stack grows downwards) */
+	while(shadow_stack.size > 0 && shadow_stack.size <= shadow_stack.capacity && shadow_stack.call_site[shadow_stack.size - 1].frame <= frame){
+		shadow_stack.size--;
+	}
+
+	if(shadow_stack.size >= shadow_stack.capacity){
+		_e4c_grow_shadow_stack();
+	}
+
+	/* (if the stack could not grow, the call is only counted) */
+	if(shadow_stack.size < shadow_stack.capacity){
+		shadow_stack.call_site[shadow_stack.size].callee = callee;
+		shadow_stack.call_site[shadow_stack.size].caller = caller;
+		shadow_stack.call_site[shadow_stack.size].frame	 = frame;
+	}
+
+	shadow_stack.size++;
+}
+
+static void __cyg_profile_func_exit(void * callee, void * caller){
+
+	if(shadow_stack.size == 0){
+		return;
+	}
+
+	shadow_stack.size--;
+}
+
+static void _e4c_grow_shadow_stack(void){
+
+	struct call_site *	call_site;
+	int					capacity;
+
+	capacity	= ( shadow_stack.capacity == 0 ? E4C_STACK_TRACE_MAX_FUNCTION_CALLS : 2 * shadow_stack.capacity );
+	call_site	= realloc( shadow_stack.call_site, (size_t)capacity * sizeof(*call_site) );
+
+	if(call_site == NULL){
+		return;
+	}
+
+# ifdef E4C_THREADSAFE
+	if(shadow_stack.call_site == NULL){
+		/* release the stack when the thread exits */
+		(void)pthread_once(&shadow_stack_once, _e4c_create_shadow_stack_key);
+		(void)pthread_setspecific(shadow_stack_key, &shadow_stack);
+	}
+# endif
+
+	shadow_stack.call_site	= call_site;
+	shadow_stack.capacity	= capacity;
+}
+
+# ifdef E4C_THREADSAFE
+
+static void _e4c_create_shadow_stack_key(void){
+
+	(void)pthread_key_create(&shadow_stack_key, _e4c_release_shadow_stack);
+}
+
+static void _e4c_release_shadow_stack(void * stack){
+
+	e4c_shadow_stack * shadow = stack;
+
+	free(shadow->call_site);
+
+	shadow->call_site	= NULL;
+	shadow->capacity	= 0;
+}
+
+# endif
+
+static e4c_call_frame * _e4c_parse_call_frame_array(e4c_call_site_array * call_site_array){
+
+	e4c_call_frame *	call_frame = NULL;
+	int					index;
+
+	if(call_site_array->size > 0){
+
+		call_frame	= calloc( (size_t)call_site_array->size, sizeof(*call_frame) );
+
+		if(call_frame != NULL){
+
+			for(index = 0; index < call_site_array->size; index++){
+
+				(void)_e4c_symbolize(call_site_array->call_site[index].caller, &call_frame[index].caller);
+				(void)_e4c_symbolize(call_site_array->call_site[index].callee, &call_frame[index].callee);
+
+				call_frame[index].previous	= ( index == 0 ? NULL : &call_frame[index - 1] );
+				call_frame[index].next		= ( index + 1 == call_site_array->size ? NULL : &call_frame[index + 1] );
+			}
+		}
+	}
+
+	return(call_frame);
+}
+
+static int _e4c_symbolize(const void * address, e4c_debug_info * debug_info){
+
+	e4c_symbol		symbol;
+	e4c_symbol *	cached;
+	const char *	file_name;
+
+# ifdef E4C_THREADSAFE
+	(void)pthread_mutex_lock(&symbol_mutex);
+# endif
+
+	cached = &symbol_cache[ ( (size_t)address / sizeof(void *) ) % E4C_STACK_TRACE_SYMBOL_CACHE_SIZE ];
+
+	if(address == NULL || cached->address != address){
+		_e4c_resolve(address, cached);
+	}
+
+	symbol = *cached;
+
+# ifdef E4C_THREADSAFE
+	(void)pthread_mutex_unlock(&symbol_mutex);
+# endif
+
+	debug_info->address			= address;
+	debug_info->line_number		= symbol.line_number;
+	*debug_info->function_name	= '\0';
+	*debug_info->file_path		= '\0';
+
+	if(symbol.function_name != NULL){
+		(void)snprintf(debug_info->function_name, sizeof(debug_info->function_name), "%s", symbol.function_name);
+	}
+
+	if(symbol.file_path != NULL){
+		/* (only the name of the file is printed) */
+		file_name = strrchr(symbol.file_path, '/');
+		(void)snprintf(debug_info->file_path, sizeof(debug_info->file_path), "%s", (file_name != NULL ? file_name + 1 : symbol.file_path) );
+	}else{
+		(void)snprintf(debug_info->file_path, sizeof(debug_info->file_path), "??");
+	}
+
+	return(symbol.function_name != NULL || symbol.file_path != NULL);
+}
+
+static void _e4c_resolve(const void * address, e4c_symbol * symbol){
+
+	e4c_object *			object;
+	const e4c_function *	function	= NULL;
+	const e4c_line *		line		= NULL;
+	ElfW(Addr)				relative;
+	int						low;
+	int						high;
+	int						middle;
+
+	symbol->address			= address;
+	symbol->function_name	= NULL;
+	symbol->file_path		= NULL;
+	symbol->line_number		= 0;
+
+	object = _e4c_find_object( (ElfW(Addr))address );
+
+	if(object == NULL){
+		return;
+	}
+
+	relative = (ElfW(Addr))address - object->base;
+
+	/* find the last function that begins at or before the address */
+	for(low = 0, high = object->function_count; low < high; ){
+		middle = low + (high - low) / 2;
+		if(object->functions[middle].address <= relative){
+			low = middle + 1;
+		}else{
+			high = middle;
+		}
+	}
+	if(low > 0){
+		function = &object->functions[low - 1];
+		if(function->size != 0 && relative >= function->address + function->size){
+			function = NULL;
+		}
+	}
+
+	/* find the last row of the line table that begins at or before the address */
+	for(low = 0, high = object->line_count; low < high; ){
+		middle = low + (high - low) / 2;
+		if(object->lines[middle].address <= relative){
+			low = middle + 1;
+		}else{
+			high = middle;
+		}
+	}
+	if(low > 0){
+		line = &object->lines[low - 1];
+		if(line->end_sequence || line->file_path == NULL){
+			line = NULL;
+		}
+	}
+
+	if(function != NULL){
+		symbol->function_name = function->name;
+	}
+
+	if(line != NULL){
+		symbol->file_path	= line->file_path;
+		symbol->line_number	= line->line_number;
+	}
+}
+
+static e4c_object * _e4c_find_object(ElfW(Addr) address){
+
+	e4c_object *		object;
+	e4c_object_search	search;
+
+	/* the objects are parsed once and cached for the rest of the program */
+	for(object = objects; object != NULL; object = object->next){
+		if(address >= object->low && address < object->high){
+			return(object);
+		}
+	}
+
+	search.address	= address;
+	search.object	= NULL;
+
+	(void)dl_iterate_phdr(_e4c_find_object_callback, &search);
+
+	if(search.object != NULL){
+		search.object->next	= objects;
+		objects				= search.object;
+	}
+
+	return(search.object);
+}
+
+static int _e4c_find_object_callback(struct dl_phdr_info * info, size_t size, void * data){
+
+	e4c_object_search *	search = data;
+	e4c_object *		object;
+	ElfW(Addr)			low;
+	ElfW(Addr)			high;
+	int					found;
+	int					index;
+
+	(void)size;
+
+	low		= ~(ElfW(Addr))0;
+	high	= 0;
+	found	= 0;
+
+	for(index = 0; index < info->dlpi_phnum; index++){
+
+		const ElfW(Phdr) * segment = &info->dlpi_phdr[index];
+
+		if(segment->p_type != PT_LOAD){
+			continue;
+		}
+
+		if(info->dlpi_addr + segment->p_vaddr < low){
+			low = info->dlpi_addr + segment->p_vaddr;
+		}
+		if(info->dlpi_addr + segment->p_vaddr + segment->p_memsz > high){
+			high = info->dlpi_addr + segment->p_vaddr + segment->p_memsz;
+		}
+		if(search->address >= info->dlpi_addr + segment->p_vaddr && search->address < info->dlpi_addr + segment->p_vaddr + segment->p_memsz){
+			found = 1;
+		}
+	}
+
+	if(!found){
+		/* keep looking */
+		return(0);
+	}
+
+	object = calloc( (size_t)1, sizeof(*object) );
+
+	if(object != NULL){
+
+		object->base	= info->dlpi_addr;
+		object->low		= low;
+		object->high	= high;
+
+		/* (the main program has no name) */
+		_e4c_load_object(object, (info->dlpi_name != NULL && *info->dlpi_name != '\0' ? info->dlpi_name : MAIN_PROGRAM_PATH) );
+	}
+
+	search->object = object;
+
+	return(1);
+}
+
+static void _e4c_load_object(e4c_object * object, const char * path){
+
+	const ElfW(Ehdr) *	header;
+	const ElfW(Shdr) *	sections;
+	const ElfW(Shdr) *	section;
+	const ElfW(Shdr) *	symbol_table	= NULL;
+	const ElfW(Shdr) *	dynamic_symbols	= NULL;
+	const ElfW(Shdr) *	debug_line		= NULL;
+	const ElfW(Shdr) *	debug_str		= NULL;
+	const ElfW(Shdr) *	debug_line_str	= NULL;
+	const char *		names;
+	const char *		name;
+	e4c_reader			reader;
+	e4c_reader			strings;
+	e4c_reader			line_strings;
+	struct stat			status;
+	void *				image;
+	int					descriptor;
+	int					index;
+
+	descriptor = open(path, O_RDONLY);
+
+	if(descriptor < 0){
+		return;
+	}
+
+	if(fstat(descriptor, &status) != 0 || (size_t)status.st_size < sizeof(ElfW(Ehdr)) ){
+		(void)close(descriptor);
+		return;
+	}
+
+	/* (the image stays mapped for the rest of the program, since the names point into it) */
+	image = mmap(NULL, (size_t)status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+	(void)close(descriptor);
+
+	if(image == MAP_FAILED){
+		return;
+	}
+
+	object->image		= image;
+	object->image_size	= (size_t)status.st_size;
+
+	header = image;
+
+	if(	memcmp(header->e_ident, ELFMAG, (size_t)SELFMAG) != 0
+		|| header->e_ident[EI_CLASS] != ELF_NATIVE_CLASS
+		|| header->e_shentsize != sizeof(ElfW(Shdr))
+		|| header->e_shoff == 0
+		|| header->e_shoff + (size_t)header->e_shnum * sizeof(ElfW(Shdr)) > object->image_size
+		|| header->e_shstrndx >= header->e_shnum ){
+		return;
+	}
+
+	sections = (const ElfW(Shdr) *)(object->image + header->e_shoff);
+
+	if( !SECTION_FITS(object, &sections[header->e_shstrndx]) ){
+		return;
+	}
+
+	names = (const char *)(object->image + sections[header->e_shstrndx].sh_offset);
+
+	for(index = 0; index < header->e_shnum; index++){
+
+		section = &sections[index];
+
+		if( !SECTION_FITS(object, section) || section->sh_name >= sections[header->e_shstrndx].sh_size ){
+			continue;
+		}
+
+		name = names + section->sh_name;
+
+		if(section->sh_type == SHT_SYMTAB){
+			symbol_table = section;
+		}else if(section->sh_type == SHT_DYNSYM){
+			dynamic_symbols = section;
+		}else if( STR_EQUALS(name, ".debug_line") ){
+			debug_line = section;
+		}else if( STR_EQUALS(name, ".debug_str") ){
+			debug_str = section;
+		}else if( STR_EQUALS(name, ".debug_line_str") ){
+			debug_line_str = section;
+		}
+	}
+
+	/* (a stripped object still has the dynamic symbols) */
+	if(symbol_table == NULL){
+		symbol_table = dynamic_symbols;
+	}
+
+	if(symbol_table != NULL && symbol_table->sh_link < header->e_shnum && SECTION_FITS(object, &sections[symbol_table->sh_link]) ){
+		_e4c_load_functions(object, symbol_table, &sections[symbol_table->sh_link]);
+	}
+
+	if(debug_line != NULL){
+
+		INITIALIZE_READER(object, &reader, debug_line);
+
+		if(debug_str != NULL){
+			INITIALIZE_READER(object, &strings, debug_str);
+		}
+
+		if(debug_line_str != NULL){
+			INITIALIZE_READER(object, &line_strings, debug_line_str);
+		}
+
+		_e4c_load_lines(object, &reader, (debug_str != NULL ? &strings : NULL), (debug_line_str != NULL ? &line_strings : NULL) );
+	}
+}
+
+static void _e4c_load_functions(e4c_object * object, const ElfW(Shdr) * symbols, const ElfW(Shdr) * names){
+
+	const ElfW(Sym) *	symbol;
+	size_t				count;
+	size_t				index;
+
+	count = symbols->sh_size / sizeof(ElfW(Sym));
+
+	object->functions = malloc( count * sizeof(*object->functions) );
+
+	if(object->functions == NULL){
+		return;
+	}
+
+	symbol = (const ElfW(Sym) *)(object->image + symbols->sh_offset);
+
+	for(index = 0; index < count; index++, symbol++){
+
+		if(SYMBOL_TYPE(symbol->st_info) != STT_FUNC || symbol->st_shndx == SHN_UNDEF || symbol->st_value == 0 || symbol->st_name >= names->sh_size){
+			continue;
+		}
+
+		object->functions[object->function_count].address	= symbol->st_value;
+		object->functions[object->function_count].size		= symbol->st_size;
+		object->functions[object->function_count].name		= (const char *)(object->image + names->sh_offset + symbol->st_name);
+		object->function_count++;
+	}
+
+	qsort(object->functions, (size_t)object->function_count, sizeof(*object->functions), _e4c_compare_functions);
+}
+
+static void _e4c_load_lines(e4c_object * object, e4c_reader * section, const e4c_reader * strings, const e4c_reader * line_strings){
+
+	e4c_reader		unit;
+	unsigned long	unit_length;
+	int				offset_size;
+
+	while(section->cursor < section->end && !section->error){
+
+		/* the 64-bit format is introduced by an escape value */
+		offset_size	= 4;
+		unit_length	= _e4c_read_fixed(section, 4);
+		if(unit_length == 0xffffffffUL){
+			offset_size	= 8;
+			unit_length	= _e4c_read_fixed(section, 8);
+		}
+
+		if(section->error || unit_length > (unsigned long)(section->end - section->cursor) ){
+			break;
+		}
+
+		unit.cursor		= section->cursor;
+		unit.end		= section->cursor + unit_length;
+		unit.error		= 0;
+
+		section->cursor	= unit.end;
+
+		_e4c_load_line_unit(object, &unit, offset_size, strings, line_strings);
+	}
+
+	qsort(object->lines, (size_t)object->line_count, sizeof(*object->lines), _e4c_compare_lines);
+}
+
+static void _e4c_load_line_unit(e4c_object * object, e4c_reader * unit, int offset_size, const e4c_reader * strings, const e4c_reader * line_strings){
+
+	e4c_reader				program;
+	const unsigned char *	standard_opcode_lengths;
+	const unsigned char *	next;
+	const char * *			files			= NULL;
+	const char * *			more_files;
+	const char *			name;
+	unsigned long			formats[2 * MAX_ENTRY_FORMATS];
+	unsigned long			version;
+	unsigned long			header_length;
+	unsigned long			minimum_instruction_length;
+	unsigned long			line_range;
+	unsigned long			opcode_base;
+	unsigned long			opcode;
+	unsigned long			length;
+	unsigned long			count;
+	unsigned long			index;
+	unsigned long			file;
+	int						line_base;
+	int						format_count;
+	int						format;
+	int						file_base;
+	int						file_count		= 0;
+	int						capacity		= 0;
+	int						line;
+	int						pass;
+	ElfW(Addr)				address;
+
+	version = _e4c_read_fixed(unit, 2);
+
+	if(version < 2 || version > 5){
+		return;
+	}
+
+	if(version >= 5){
+		/* (address and segment selector sizes) */
+		(void)_e4c_read_fixed(unit, 1);
+		(void)_e4c_read_fixed(unit, 1);
+	}
+
+	header_length = _e4c_read_fixed(unit, offset_size);
+
+	if(unit->error || header_length > (unsigned long)(unit->end - unit->cursor) ){
+		return;
+	}
+
+	program.cursor	= unit->cursor + header_length;
+	program.end		= unit->end;
+	program.error	= 0;
+
+	minimum_instruction_length = _e4c_read_fixed(unit, 1);
+	if(version >= 4){
+		/* (maximum operations per instruction) */
+		(void)_e4c_read_fixed(unit, 1);
+	}
+	/* (default is_stmt) */
+	(void)_e4c_read_fixed(unit, 1);
+	line_base	= (int)(signed char)_e4c_read_fixed(unit, 1);
+	line_range	= _e4c_read_fixed(unit, 1);
+	opcode_base	= _e4c_read_fixed(unit, 1);
+
+	if(unit->error || line_range == 0 || opcode_base == 0 || opcode_base - 1 > (unsigned long)(unit->end - unit->cursor) ){
+		return;
+	}
+
+	standard_opcode_lengths	= unit->cursor;
+	unit->cursor			+= opcode_base - 1;
+
+	if(version >= 5){
+
+		/* the directories are described the same way as the files (but only the files are kept) */
+		file_base = 0;
 
-				(void)snprintf(&command[written], command_size - written, " 2>&1");
+		for(pass = 0; pass < 2 && !unit->error; pass++){
 
-				pipe = popen(command, "r");
-				if(pipe != NULL){
+			format_count = (int)_e4c_read_fixed(unit, 1);
+			if(format_count > MAX_ENTRY_FORMATS){
+				return;
+			}
+			for(format = 0; format < format_count; format++){
+				formats[2 * format]		= _e4c_read_unsigned_leb128(unit);
+				formats[2 * format + 1]	= _e4c_read_unsigned_leb128(unit);
+			}
 
-					for(index = 0; index < call_site_array->size; index++){
+			count = _e4c_read_unsigned_leb128(unit);
 
-						if( !PARSE_DEBUG_INFO(pipe, &call_frame[index].caller) || !PARSE_DEBUG_INFO(pipe, &call_frame[index].callee) ){
+			if(pass == 1 && !unit->error && count > 0 && count <= (unsigned long)(unit->end - unit->cursor) ){
+				files		= malloc( (size_t)count * sizeof(*files) );
+				capacity	= (files != NULL ? (int)count : 0);
+			}
 
-							break;
-						}
+			for(index = 0; index < count && !unit->error; index++){
+				name = NULL;
+				for(format = 0; format < format_count; format++){
+					const char * value = _e4c_read_form(unit, formats[2 * format + 1], offset_size, strings, line_strings);
+					if(formats[2 * format] == DW_LNCT_path){
+						name = value;
 					}
+				}
+				if(pass == 1 && file_count < capacity){
+					files[file_count++] = name;
+				}
+			}
+		}
+
+	}else{
 
-					(void)pclose(pipe);
+		file_base = 1;
+
+		/* skip the include directories */
+		do{
+			name = _e4c_read_string(unit);
+		}while(name != NULL && *name != '\0');
+
+		for(name = _e4c_read_string(unit); name != NULL && *name != '\0'; name = _e4c_read_string(unit)){
+
+			/* (directory index, modification time and length) */
+			(void)_e4c_read_unsigned_leb128(unit);
+			(void)_e4c_read_unsigned_leb128(unit);
+			(void)_e4c_read_unsigned_leb128(unit);
+
+			if(file_count == capacity){
+				more_files = realloc( (void *)files, (size_t)(capacity + 16) * sizeof(*files) );
+				if(more_files == NULL){
+					break;
 				}
+				files		= more_files;
+				capacity	+= 16;
 			}
 
-			free(command);
+			files[file_count++] = name;
 		}
+	}
 
+	if(unit->error){
+		free( (void *)files );
+		return;
 	}
 
-	return(call_frame);
+	/* run the line number program */
+	address	= 0;
+	file	= 1;
+	line	= 1;
+
+	while(program.cursor < program.end && !program.error){
+
+		opcode = _e4c_read_fixed(&program, 1);
+
+		if(opcode >= opcode_base){
+
+			/* special opcode */
+			opcode	-= opcode_base;
+			address	+= (opcode / line_range) * minimum_instruction_length;
+			line	+= line_base + (int)(opcode % line_range);
+
+			if( !ADD_LINE(object, files, file_base, file_count, address, file, line, 0) ){
+				break;
+			}
+
+		}else if(opcode == 0){
+
+			/* extended opcode */
+			length = _e4c_read_unsigned_leb128(&program);
+
+			if(program.error || length == 0 || length > (unsigned long)(program.end - program.cursor) ){
+				break;
+			}
+
+			next = program.cursor + length;
+
+			switch( _e4c_read_fixed(&program, 1) ){
+
+				case DW_LNE_end_sequence:
+					if( !ADD_LINE(object, files, file_base, file_count, address, file, line, 1) ){
+						program.error = 1;
+					}
+					address	= 0;
+					file	= 1;
+					line	= 1;
+					break;
+
+				case DW_LNE_set_address:
+					address = (ElfW(Addr))_e4c_read_fixed(&program, (int)length - 1);
+					break;
+
+				default:
+					/* (DW_LNE_define_file and vendor extensions are ignored) */
+					break;
+			}
+
+			program.cursor = next;
+
+		}else{
+
+			/* standard opcode */
+			switch(opcode){
+
+				case DW_LNS_copy:
+					if( !ADD_LINE(object, files, file_base, file_count, address, file, line, 0) ){
+						program.error = 1;
+					}
+					break;
+
+				case DW_LNS_advance_pc:
+					address += _e4c_read_unsigned_leb128(&program) * minimum_instruction_length;
+					break;
+
+				case DW_LNS_advance_line:
+					line += (int)_e4c_read_signed_leb128(&program);
+					break;
+
+				case DW_LNS_set_file:
+					file = _e4c_read_unsigned_leb128(&program);
+					break;
+
+				case DW_LNS_const_add_pc:
+					address += ( (255 - opcode_base) / line_range ) * minimum_instruction_length;
+					break;
+
+				case DW_LNS_fixed_advance_pc:
+					address += _e4c_read_fixed(&program, 2);
+					break;
+
+				default:
+					/* (skip the operands of any other opcode) */
+					for(index = 0; index < standard_opcode_lengths[opcode - 1]; index++){
+						(void)_e4c_read_unsigned_leb128(&program);
+					}
+					break;
+			}
+		}
+	}
+
+	free( (void *)files );
+}
+
+static int _e4c_add_line(e4c_object * object, ElfW(Addr) address, const char * file_path, int line_number, int end_sequence){
+
+	e4c_line * lines;
+
+	if(object->line_count == object->line_capacity){
+
+		lines = realloc(object->lines, (size_t)(object->line_capacity > 0 ? 2 * object->line_capacity : 1024) * sizeof(*lines) );
+
+		if(lines == NULL){
+			return(0);
+		}
+
+		object->lines			= lines;
+		object->line_capacity	= (object->line_capacity > 0 ? 2 * object->line_capacity : 1024);
+	}
+
+	object->lines[object->line_count].address		= address;
+	object->lines[object->line_count].file_path		= file_path;
+	object->lines[object->line_count].line_number	= line_number;
+	object->lines[object->line_count].end_sequence	= end_sequence;
+	object->lines[object->line_count].order			= object->line_count;
+	object->line_count++;
+
+	return(1);
+}
+
+static unsigned long _e4c_read_fixed(e4c_reader * reader, int size){
+
+	unsigned char	value1;
+	Elf32_Half		value2;
+	Elf32_Word		value4;
+	Elf64_Xword		value8;
+
+	if(reader->error || size <= 0 || (size_t)size > (size_t)(reader->end - reader->cursor) ){
+		reader->error = 1;
+		return(0);
+	}
+
+	/* (the object was built for this very machine, so it has the same byte order) */
+	switch(size){
+
+		case 1:
+			value1 = *reader->cursor;
+			reader->cursor += 1;
+			return(value1);
+
+		case 2:
+			memcpy(&value2, reader->cursor, sizeof(value2) );
+			reader->cursor += 2;
+			return(value2);
+
+		case 4:
+			memcpy(&value4, reader->cursor, sizeof(value4) );
+			reader->cursor += 4;
+			return(value4);
+
+		case 8:
+			memcpy(&value8, reader->cursor, sizeof(value8) );
+			reader->cursor += 8;
+			return( (unsigned long)value8 );
+
+		default:
+			reader->error = 1;
+			return(0);
+	}
+}
+
+static unsigned long _e4c_read_unsigned_leb128(e4c_reader * reader){
+
+	unsigned long	value	= 0;
+	unsigned int	shift	= 0;
+	unsigned char	byte;
+
+	do{
+		if(reader->error || reader->cursor >= reader->end){
+			reader->error = 1;
+			return(0);
+		}
+		byte = *reader->cursor++;
+		if(shift < 8 * sizeof(value) ){
+			value |= (unsigned long)(byte & 0x7f) << shift;
+		}
+		shift += 7;
+	}while(byte & 0x80);
+
+	return(value);
+}
+
+static long _e4c_read_signed_leb128(e4c_reader * reader){
+
+	unsigned long	value	= 0;
+	unsigned int	shift	= 0;
+	unsigned char	byte;
+
+	do{
+		if(reader->error || reader->cursor >= reader->end){
+			reader->error = 1;
+			return(0);
+		}
+		byte = *reader->cursor++;
+		if(shift < 8 * sizeof(value) ){
+			value |= (unsigned long)(byte & 0x7f) << shift;
+		}
+		shift += 7;
+	}while(byte & 0x80);
+
+	/* sign extension */
+	if(shift < 8 * sizeof(value) && (byte & 0x40) ){
+		value |= ~0UL << shift;
+	}
+
+	return( (long)value );
+}
+
+static const char * _e4c_read_string(e4c_reader * reader){
+
+	const char * string;
+
+	string = (const char *)reader->cursor;
+
+	while(reader->cursor < reader->end && *reader->cursor != '\0'){
+		reader->cursor++;
+	}
+
+	if(reader->cursor >= reader->end){
+		reader->error = 1;
+		return(NULL);
+	}
+
+	/* (skip the null character) */
+	reader->cursor++;
+
+	return(string);
+}
+
+static const char * _e4c_read_form(e4c_reader * reader, unsigned long form, int offset_size, const e4c_reader * strings, const e4c_reader * line_strings){
+
+	unsigned long offset;
+
+	switch(form){
+
+		case DW_FORM_string:
+			return( _e4c_read_string(reader) );
+
+		case DW_FORM_strp:
+		case DW_FORM_line_strp:
+			offset = _e4c_read_fixed(reader, offset_size);
+			if(form == DW_FORM_strp){
+				line_strings = strings;
+			}
+			if(line_strings == NULL || offset >= (unsigned long)(line_strings->end - line_strings->cursor) ){
+				return(NULL);
+			}
+			/* (the section is assumed to end with a null character) */
+			return( (const char *)(line_strings->cursor + offset) );
+
+		case DW_FORM_udata:
+			(void)_e4c_read_unsigned_leb128(reader);
+			return(NULL);
+
+		case DW_FORM_data1:
+			(void)_e4c_read_fixed(reader, 1);
+			return(NULL);
+
+		case DW_FORM_data2:
+			(void)_e4c_read_fixed(reader, 2);
+			return(NULL);
+
+		case DW_FORM_data4:
+			(void)_e4c_read_fixed(reader, 4);
+			return(NULL);
+
+		case DW_FORM_data8:
+			(void)_e4c_read_fixed(reader, 8);
+			return(NULL);
+
+		case DW_FORM_data16:
+			(void)_e4c_read_fixed(reader, 8);
+			(void)_e4c_read_fixed(reader, 8);
+			return(NULL);
+
+		case DW_FORM_block:
+			offset = _e4c_read_unsigned_leb128(reader);
+			if(reader->error || offset > (unsigned long)(reader->end - reader->cursor) ){
+				reader->error = 1;
+				return(NULL);
+			}
+			reader->cursor += offset;
+			return(NULL);
+
+		default:
+			/* (unknown forms cannot be skipped) */
+			reader->error = 1;
+			return(NULL);
+	}
+}
+
+static int _e4c_compare_functions(const void * function1, const void * function2){
+
+	const e4c_function * f1 = function1;
+	const e4c_function * f2 = function2;
+
+	if(f1->address != f2->address){
+		return(f1->address < f2->address ? -1 : 1);
+	}
+
+	/* (prefer the symbols that tell their size) */
+	return(f1->size == f2->size ? 0 : (f1->size == 0 ? -1 : 1) );
+}
+
+static int _e4c_compare_lines(const void * line1, const void * line2){
+
+	const e4c_line * l1 = line1;
+	const e4c_line * l2 = line2;
+
+	if(l1->address != l2->address){
+		return(l1->address < l2->address ? -1 : 1);
+	}
+
+	/* the end of a sequence goes before the beginning of the next one */
+	if(l1->end_sequence != l2->end_sequence){
+		return(l1->end_sequence ? -1 : 1);
+	}
+
+	/* (otherwise, the rows keep their original order) */
+	return(l1->order - l2->order);
 }
 
 inline static int _e4c_print_call_frame(const char * binary_path, e4c_debug_info * debug_info, const char * * prefix_exclude, int print_line){
@@ -429,19 +1784,222 @@ inline static e4c_call_stack * _e4c_parse_call_stack(e4c_call_site_array * call_
 	return(call_stack);
 }
 
-inline static e4c_call_site_array * _e4c_capture_call_site_array(const char * binary_path){
+static int _e4c_is_traced(const e4c_exception * exception){
+
+	e4c_stack_trace_policy				current;
+	const e4c_exception_type * const *	type;
+	unsigned long						version;
+
+	/* (the policy may be set again while exceptions are being thrown, so it is read until it is consistent) */
+	do{
+		version = __atomic_load_n(&policy_version, __ATOMIC_ACQUIRE);
+		current = policy;
+		__atomic_thread_fence(__ATOMIC_ACQUIRE);
+	}while( (version & 1UL) != 0UL || __atomic_load_n(&policy_version, __ATOMIC_RELAXED) != version );
+
+	if(current.types != NULL){
+
+		for(type = current.types; *type != NULL; type++){
+			if( e4c_is_instance_of(exception, *type) ){
+				break;
+			}
+		}
+
+		if(*type == NULL){
+			return(0);
+		}
+	}
+
+	if(current.first_throws <= 0 && current.sampling <= 0){
+		return(1);
+	}
+
+	if(current.first_throws > 0 && _e4c_count_site(exception->file, exception->line, current.first_throws) <= current.first_throws){
+		return(1);
+	}
+
+	if(current.sampling > 0){
+		/* (each thread samples by its own) */
+		sampling_count = (sampling_count + 1) % current.sampling;
+		return(sampling_count == 0);
+	}
+
+	return(0);
+}
+
+static int _e4c_count_site(const char * file, int line, int first_throws){
+
+	e4c_policy_site *	site;
+	unsigned long		hash;
+	int					probe;
+	int					count;
+
+	hash	= (unsigned long)line * 31UL + (unsigned long)(size_t)file;
+	count	= first_throws + 1;
+
+# ifdef E4C_THREADSAFE
+	(void)pthread_mutex_lock(&policy_sites_mutex);
+# endif
+
+	/* open addressing with linear probing */
+	for(probe = 0; probe < E4C_STACK_TRACE_POLICY_SITES; probe++){
+
+		site = &policy_sites[ (hash + (unsigned long)probe) % E4C_STACK_TRACE_POLICY_SITES ];
+
+		if(site->count == 0){
+			site->file	= file;
+			site->line	= line;
+		}
+
+		if(site->file == file && site->line == line){
+			/* (stop counting once the limit is reached) */
+			if(site->count <= first_throws){
+				site->count++;
+			}
+			count = site->count;
+			break;
+		}
+	}
+
+	/* (the sites that do not fit in the table are not traced) */
+
+# ifdef E4C_THREADSAFE
+	(void)pthread_mutex_unlock(&policy_sites_mutex);
+# endif
+
+	return(count);
+}
+
+static uint32_t _e4c_intern_call_site_array(const char * binary_path){
+
+	e4c_call_site_array *	tmp		= NULL;
+	e4c_call_site_array *	interned;
+	e4c_trace *				trace;
+	size_t					length;
+	unsigned long			hash;
+	unsigned long			probe;
+	int						size;
+
+	/* capture only the calls that are currently live (and were recorded) */
+	size	= ( shadow_stack.size > shadow_stack.capacity ? shadow_stack.capacity : shadow_stack.size );
+	length	= (size_t)size * sizeof(shadow_stack.call_site[0]);
+
+	/* FNV-1a (the call sites are hashed in place, without copying them) */
+	hash = 2166136261UL ^ (unsigned long)(size_t)binary_path;
+	for(probe = 0; probe < (unsigned long)size; probe++){
+		hash = (hash ^ (unsigned long)(size_t)shadow_stack.call_site[probe].caller) * 16777619UL;
+		hash = (hash ^ (unsigned long)(size_t)shadow_stack.call_site[probe].callee) * 16777619UL;
+	}
+
+	/* (zero means empty) */
+	if(hash == 0){
+		hash = 1;
+	}
+
+	for(probe = 0; probe < E4C_STACK_TRACE_TABLE_SIZE; probe++){
+
+		trace = &traces[ (hash + probe) % E4C_STACK_TRACE_TABLE_SIZE ];
+
+		if(trace->hash == 0){
+
+			/* (the copy is made only for traces that were never seen) */
+			if(tmp == NULL){
+
+				tmp = malloc(sizeof(*tmp) + length);
+
+				if(tmp == NULL){
+					return(0);
+				}
+
+				if(size > 0){
+					memcpy(tmp->call_site, shadow_stack.call_site, length);
+				}
+
+				tmp->size			= size;
+				tmp->binary_path	= binary_path;
+			}
+
+			/* claim the slot, then publish the trace */
+			if( __sync_bool_compare_and_swap(&trace->hash, 0UL, hash) ){
+
+				trace->count = 1;
+				__sync_synchronize();
+				trace->call_site_array = tmp;
+
+				return( (uint32_t)(trace - traces) + 1 );
+			}
+
+			/* (another thread claimed this slot first) */
+		}
+
+		if(trace->hash == hash){
+
+			interned = _e4c_wait_call_site_array(trace);
+
+			if(interned->binary_path == binary_path && _e4c_same_call_sites(interned, size) ){
+
+				(void)__sync_fetch_and_add(&trace->count, 1UL);
+
+				free(tmp);
+
+				return( (uint32_t)(trace - traces) + 1 );
+			}
+		}
+	}
+
+	/* (the table is full) */
+	free(tmp);
+
+	return(0);
+}
+
+static int _e4c_same_call_sites(const e4c_call_site_array * call_site_array, int size){
+
+	int index;
+
+	if(call_site_array->size != size){
+		return(0);
+	}
+
+	for(index = 0; index < size; index++){
+		if(call_site_array->call_site[index].caller != shadow_stack.call_site[index].caller || call_site_array->call_site[index].callee != shadow_stack.call_site[index].callee){
+			return(0);
+		}
+	}
+
+	return(1);
+}
+
+static e4c_call_site_array * _e4c_wait_call_site_array(e4c_trace * trace){
+
+	e4c_call_site_array * call_site_array;
+
+	/* (the slot may have been claimed, but not published yet) */
+	while( (call_site_array = *(e4c_call_site_array * volatile *)&trace->call_site_array) == NULL ){
+		__sync_synchronize();
+	}
+
+	return(call_site_array);
+}
+
+static e4c_trace * _e4c_find_trace(const e4c_exception * exception){
 
-	e4c_call_site_array * tmp = malloc( sizeof(*tmp) );
+	size_t		id		= (size_t)exception->custom_data;
+	e4c_trace *	trace;
 
-	if(tmp != NULL){
+	/* (the custom data may not have been set by this module) */
+	if(id == 0 || id > E4C_STACK_TRACE_TABLE_SIZE){
+		return(NULL);
+	}
 
-		memcpy( tmp, &call_site_array, sizeof(*tmp) );
+	trace = &traces[id - 1];
 
-		tmp->size			= ( tmp->size > E4C_STACK_TRACE_MAX_FUNCTION_CALLS ? E4C_STACK_TRACE_MAX_FUNCTION_CALLS : tmp->size );
-		tmp->binary_path	= binary_path;
+	/* (the slot needs to have been claimed) */
+	if( __sync_fetch_and_add(&trace->hash, 0UL) == 0UL ){
+		return(NULL);
 	}
 
-	return(tmp);
+	return(trace);
 }
 
 inline static void _e4c_print_call_stack(e4c_call_stack * call_stack, const char * * prefix_exclude, int max){
@@ -473,6 +2031,8 @@ inline static void _e4c_print_call_stack(e4c_call_stack * call_stack, const char
 
 inline static void _e4c_print_exception(const e4c_exception * exception, int is_cause, const char * * prefix_exclude, int max){
 
+	e4c_trace * trace;
+
 	fprintf(stderr, "%s %s: %s\n\n", (is_cause ? "Caused by" : "\n\nUncaught"), exception->name, exception->message);
 
 	if(exception->file != NULL){
@@ -486,11 +2046,17 @@ inline static void _e4c_print_exception(const e4c_exception * exception, int is_
 		}
 	}
 
-	if(exception->custom_data != NULL){
+	if( (trace = _e4c_find_trace(exception)) != NULL ){
 
-		e4c_call_stack *	call_stack	= _e4c_parse_call_stack(exception->custom_data);
+		/* (the addresses are only resolved now) */
+		e4c_call_stack * call_stack = _e4c_parse_call_stack( _e4c_wait_call_site_array(trace) );
 
 		_e4c_print_call_stack(call_stack, prefix_exclude, max);
+
+		if(call_stack != NULL){
+			free(call_stack->first_frame);
+			free(call_stack);
+		}
 	}
 
 	fprintf(stderr, "\n");
@@ -517,19 +2083,77 @@ void e4c_stack_trace_print_exception(const e4c_exception * exception){
 
 void * e4c_stack_trace_initialize(const e4c_exception * exception){
 
-	e4c_call_site_array * call_site_array = NULL;
+	uint32_t id = 0;
 
-	if(exception != NULL){
+	/* (the policy is decided before allocating anything) */
+	if(exception != NULL && _e4c_is_traced(exception) ){
 
 		const char * binary_path = exception->custom_data;
 
-		call_site_array = _e4c_capture_call_site_array(binary_path);
+		id = _e4c_intern_call_site_array(binary_path);
 	}
 
-	return(call_site_array);
+	/* (the exception keeps only the identifier of its trace) */
+	return( (void *)(size_t)id );
+}
+
+uint32_t e4c_stack_trace_get_id(const e4c_exception * exception){
+
+	if(exception == NULL || _e4c_find_trace(exception) == NULL){
+		return(0);
+	}
+
+	return( TRACE_ID(exception->custom_data) );
+}
+
+unsigned long e4c_stack_trace_get_count(uint32_t id){
+
+	if(id == 0 || id > E4C_STACK_TRACE_TABLE_SIZE){
+		return(0);
+	}
+
+	return( __sync_fetch_and_add(&traces[id - 1].count, 0UL) );
+}
+
+void e4c_stack_trace_set_policy(const e4c_stack_trace_policy * new_policy){
+
+# ifdef E4C_THREADSAFE
+	/* (only one thread at a time can set the policy) */
+	(void)pthread_mutex_lock(&policy_mutex);
+# endif
+
+	/* make the throwers wait until the new policy is complete */
+	__atomic_store_n(&policy_version, policy_version + 1UL, __ATOMIC_RELAXED);
+	__atomic_thread_fence(__ATOMIC_RELEASE);
+
+	if(new_policy == NULL){
+		policy.types		= NULL;
+		policy.first_throws	= 0;
+		policy.sampling		= 0;
+	}else{
+		policy = *new_policy;
+	}
+
+	__atomic_store_n(&policy_version, policy_version + 1UL, __ATOMIC_RELEASE);
+
+# ifdef E4C_THREADSAFE
+	(void)pthread_mutex_unlock(&policy_mutex);
+# endif
+
+	/* (the sites start counting again) */
+# ifdef E4C_THREADSAFE
+	(void)pthread_mutex_lock(&policy_sites_mutex);
+# endif
+
+	memset(policy_sites, 0, sizeof(policy_sites) );
+
+# ifdef E4C_THREADSAFE
+	(void)pthread_mutex_unlock(&policy_sites_mutex);
+# endif
 }
 
 void e4c_stack_trace_finalize(void * custom_data){
 
-	free(custom_data);
+	/* (interned traces are never released) */
+	(void)custom_data;
 }
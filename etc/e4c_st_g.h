@@ -59,6 +59,40 @@
  *   - `-finstrument-functions`
  *   - `-g3`
  *
+ * The stack trace is symbolized within the process: the symbol table and the
+ * DWARF line table (`.symtab` and `.debug_line`) of the program and of every
+ * shared object involved are read from the files that were loaded, through
+ * `dl_iterate_phdr`. Each file is mapped into memory and parsed only the first
+ * time, so printing a stack trace never runs external programs. This requires
+ * an ELF platform (such as Linux); debugging information stored in separate
+ * files or compressed sections is not used, so such functions are printed
+ * along with their address instead.
+ *
+ * Each thread records its own calls, in a stack that grows as deep as needed,
+ * so the stack traces of a multithreaded program (compiled with
+ * `E4C_THREADSAFE`) do not interfere with each other. Only the calls that are
+ * live when an exception is thrown are captured.
+ *
+ * Capturing a stack trace for every exception may be too expensive for
+ * programs that throw often. A policy can be set through
+ * `#e4c_stack_trace_set_policy` so that only some exceptions are traced:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ * const e4c_exception_type * traced[] = {&RuntimeException, NULL};
+ * e4c_stack_trace_policy policy = {traced, 10, 100};
+ *
+ * e4c_stack_trace_set_policy(&policy);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The same stack trace is stored only once: captured traces are interned in a
+ * table shared by all threads, and each exception keeps the 32-bit identifier
+ * of its trace (see `#e4c_stack_trace_get_id`). The table is lock-free and has
+ * a fixed size (`E4C_STACK_TRACE_TABLE_SIZE`, 4096 traces by default), so the
+ * memory used by stack traces stays bounded no matter how many exceptions are
+ * thrown; once it is full, the exceptions thrown through new paths are not
+ * traced. The number of exceptions thrown through each trace is counted too
+ * (see `#e4c_stack_trace_get_count`).
+ *
  * @section license License
  *
  * > This is free software: you can redistribute it and/or modify it under the
@@ -82,6 +116,8 @@
 # define EXCEPTIONS4C_STACK_TRACE_GCC
 
 
+# include <stdint.h>
+
 # ifndef EXCEPTIONS4C
 #	include "e4c.h"
 # endif
@@ -90,6 +126,35 @@
 /*@-exportany@*/
 
 
+/**
+ * Represents which exceptions get a stack trace
+ *
+ * An exception is traced when its type is one of the selected `types` (or a
+ * subtype of them) and, in addition, either it is one of the `first_throws`
+ * exceptions thrown from its site, or it is picked by sampling one in every
+ * `sampling` exceptions (counted per thread).
+ *
+ * When both `first_throws` and `sampling` are *zero*, every exception of the
+ * selected types is traced.
+ *
+ * @see     #e4c_stack_trace_set_policy
+ */
+typedef struct e4c_stack_trace_policy_ e4c_stack_trace_policy;
+struct e4c_stack_trace_policy_{
+
+	/** The types to be traced, terminated by `NULL` (`NULL` selects every type) */
+	/*@observer@*/ /*@null@*/
+	const e4c_exception_type * const *	types;
+
+	/** The number of exceptions thrown from each site to be traced */
+	int									first_throws;
+
+	/** The rate at which the rest of the exceptions are sampled */
+	int									sampling;
+
+};
+
+
 /**
  * Prints a fatal error message and backtrace regarding the uncaught exception
  *
@@ -129,16 +194,90 @@ void e4c_stack_trace_print_exception(
 @*/
 ;
 
+/**
+ * Sets which exceptions get a stack trace
+ *
+ * @param   policy
+ *          The policy to be used from now on (`NULL` traces every exception)
+ *
+ * This function sets the policy which `#e4c_stack_trace_initialize` follows
+ * to decide whether to capture the call stack of a newly created exception.
+ * The decision is made before anything is allocated, so the exceptions that
+ * are not traced cost no more than without this module; they are printed
+ * without their stack trace.
+ *
+ * The policy is copied, but the array of types is not, so it needs to remain
+ * valid while the policy is in use. The policy is shared by all threads, and
+ * it can be set again at any time; the exceptions being thrown meanwhile by
+ * other threads follow either the previous policy or the new one. Throwers
+ * read the policy without locking; only the per-site counters of
+ * `first_throws` are protected by a mutex, and only when it is positive.
+ *
+ * @see     #e4c_stack_trace_policy
+ * @see     #e4c_stack_trace_initialize
+ */
+/*@unused@*/ extern
+void e4c_stack_trace_set_policy(
+	/*@temp@*/ /*@null@*/
+	const e4c_stack_trace_policy * policy
+)
+/*@globals
+	internalState
+@*/
+/*@modifies
+	internalState
+@*/
+;
+
+/**
+ * Gets the identifier of the stack trace of an exception
+ *
+ * @param   exception
+ *          The exception
+ * @return  The identifier of its stack trace, or *zero* if it was not traced
+ *
+ * Exceptions thrown through the same path of execution share the same
+ * identifier, so it can be used to aggregate them cheaply.
+ *
+ * @see     #e4c_stack_trace_get_count
+ */
+/*@unused@*/ extern
+uint32_t e4c_stack_trace_get_id(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception * exception
+)
+/*@*/
+;
+
+/**
+ * Gets the number of exceptions thrown through a stack trace
+ *
+ * @param   id
+ *          The identifier of the stack trace
+ * @return  The number of exceptions that were thrown through it
+ *
+ * @see     #e4c_stack_trace_get_id
+ */
+/*@unused@*/ extern
+unsigned long e4c_stack_trace_get_count(
+	uint32_t id
+)
+/*@globals
+	internalState
+@*/
+;
+
 /**
  * Initializes the backtrace of a newly created exception
  *
  * @param   exception
  *          The newly created exception
- * @return  The backtrace to be assigned to the exception
+ * @return  The identifier of the interned backtrace
  *
  * This function captures the call stack at the moment the exception is being
- * thrown. It expects that the initial value of the custom data is a text string
- * containing the path to the executing program.
+ * thrown, unless the policy set through `#e4c_stack_trace_set_policy` leaves
+ * the exception out. It expects that the initial value of the custom data is a
+ * text string containing the path to the executing program.
  *
  * It must be passed to `#e4c_context_set_handlers` as the handler for
  * initializing the custom data of an exception, along with
@@ -174,8 +313,8 @@ void * e4c_stack_trace_initialize(
  * @param   custom_data
  *          The backtrace to be finalized
  *
- * This function disposes of the call stack captured at the moment the exception
- * was thrown.
+ * This function does nothing, since the call stacks captured when exceptions
+ * are thrown are interned and kept for the lifetime of the program.
  *
  * It must be passed to `#e4c_context_set_handlers` as the handler for
  * finalizing the custom data of an exception, along with
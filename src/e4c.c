@@ -32,6 +32,8 @@
 # include <signal.h>
 # include <errno.h>
 # include <stdarg.h>
+# include <time.h>
+# include <string.h>
 # include "e4c.h"
 
 
@@ -68,7 +70,15 @@
 
 # define IS_TOP_FRAME(frame)			( frame->previous == NULL )
 
-# define IS_UNCATCHABLE(exception)		(exception->type == NULL || exception->type == &AssertionException)
+# define IS_UNCATCHABLE_TYPE(type)		(type == NULL || type == &AssertionException)
+# define IS_UNCATCHABLE(exception)		IS_UNCATCHABLE_TYPE(exception->type)
+
+/* (a boundary converts the same exceptions that `catch(RuntimeException)` would) */
+# define IS_CONVERTIBLE(exception)		e4c_is_instance_of(exception, &RuntimeException)
+
+# ifdef E4C_FAST_FAIL
+#	define IS_CATCH_OVERFLOW(frame)		( frame->catch_count > E4C_MAX_CATCH_TYPES )
+# endif
 
 # define INITIALIZE_ONCE				if(!is_initialized){ _e4c_library_initialize(); }
 
@@ -84,6 +94,105 @@
 #	define VERBATIM_COPY(dst, src) (void)sprintf(dst, "%.*s", (int)E4C_EXCEPTION_MESSAGE_SIZE - 1, src)
 # endif
 
+/*
+ * HAVE_POSIX_WRITE
+ * can be defined in order to use `write` rather than `fwrite` to print out
+ * exceptions (it is assumed when E4C_THREADSAFE is defined)
+ */
+# if defined(HAVE_POSIX_WRITE) || defined(E4C_THREADSAFE)
+#	include <unistd.h>
+#	define WRITE_TO_STDERR
+# endif
+
+/*
+ * HAVE_CLOCK_GETTIME
+ * can be defined in order to use `clock_gettime` rather than `time` to record
+ * the time of each exception and to measure how long blocks take (it is not
+ * assumed when E4C_THREADSAFE is defined, since `clock_gettime` may require
+ * a newer POSIX feature level than the one requested for the threads)
+ */
+# ifdef HAVE_CLOCK_GETTIME
+#	define RECORD_NANOSECONDS
+# endif
+
+/*
+ * The E4C_PRINT_BUFFER_SIZE compile-time parameter
+ * could be defined in order to change the size of the buffer in which
+ * exceptions are rendered before being printed out.
+ */
+# ifndef E4C_PRINT_BUFFER_SIZE
+#	define E4C_PRINT_BUFFER_SIZE	4096
+# endif
+
+/*
+ * The E4C_STATISTICS_SIZE compile-time parameter
+ * could be defined in order to change how many different sites each exception
+ * context can count (when E4C_STATISTICS is defined).
+ */
+/*
+ * The E4C_LATENCY_SIZE compile-time parameter
+ * could be defined in order to change how many different sites each exception
+ * context can measure (when E4C_STATISTICS is defined).
+ */
+# ifdef E4C_STATISTICS
+#	ifndef E4C_STATISTICS_SIZE
+#		define E4C_STATISTICS_SIZE	256
+#	endif
+#	ifndef E4C_LATENCY_SIZE
+#		define E4C_LATENCY_SIZE		32
+#	endif
+#	define STATISTICS_COUNT(context, type, file, line, counter) \
+		_e4c_statistics_find(context, type, file, line)->counter++
+#	define STATISTICS_GAUGE(context, gauge, delta) \
+		(context)->gauge += (delta)
+#	define IS_LATENCY_USED(latency) \
+		( (latency)->count[e4c_succeeded] + (latency)->count[e4c_recovered] + (latency)->count[e4c_failed] != 0UL )
+# else
+#	define STATISTICS_COUNT(context, type, file, line, counter)
+#	define STATISTICS_GAUGE(context, gauge, delta)
+# endif
+
+# define NOTIFY_EVENT(context, event, exception, file, line, function) \
+	if( (context)->event_handler != NULL ){ \
+		_e4c_context_notify(context, event, exception, file, line, function); \
+	}
+
+/*
+ * HAVE_SYS_SDT_H
+ * can be defined in order to place static tracepoints (USDT probes) which can be
+ * enabled at run time by tools such as bpftrace, perf or SystemTap. They are
+ * recorded as notes in the .note.stapsdt section of the object file, so they
+ * can be listed through readelf -n without any tracer installed.
+ *
+ * The probes e4c:throw, e4c:catch and e4c:propagate take the exception name,
+ * message, file, line and depth; e4c:signal takes the exception name, message,
+ * signal name, signal number and depth.
+ *
+ * When HAVE_SYS_SDT_H is not defined, or the header does not provide the
+ * DTRACE_PROBE5 macro, the probes compile to nothing.
+ */
+# ifdef HAVE_SYS_SDT_H
+#	define _SDT_HAS_SEMAPHORES 1
+#	include <sys/sdt.h>
+# endif
+
+# ifdef DTRACE_PROBE5
+#	define HAVE_PROBES
+#	define DEFINE_PROBE_SEMAPHORE(probe) \
+		volatile unsigned short e4c_##probe##_semaphore __attribute__((section(".probes"))) = 0
+#	define PROBE_EXCEPTION(probe, context, exception, file, line) \
+		if(e4c_##probe##_semaphore != 0){ \
+			DTRACE_PROBE5(e4c, probe, (exception)->name, (exception)->message, file, line, _e4c_context_depth(context)); \
+		}
+#	define PROBE_SIGNAL(context, exception, signal_name, signal_number) \
+		if(e4c_signal_semaphore != 0){ \
+			DTRACE_PROBE5(e4c, signal, (exception)->name, (exception)->message, signal_name, signal_number, _e4c_context_depth(context)); \
+		}
+# else
+#	define PROBE_EXCEPTION(probe, context, exception, file, line)
+#	define PROBE_SIGNAL(context, exception, signal_name, signal_number)
+# endif
+
 # define DESC_MALLOC_EXCEPTION		"Could not create a new exception."
 # define DESC_MALLOC_FRAME			"Could not create a new exception frame."
 # define DESC_MALLOC_CONTEXT		"Could not create a new exception context."
@@ -99,6 +208,7 @@
 # define DESC_SIGERR_HANDLE			"Could not register the signal handling procedure."
 # define DESC_SIGERR_DEFAULT		"Could not reset the default signal handling."
 # define DESC_SIGERR_IGNORE			"Could not ignore the signal."
+# define DESC_BOUNDARY_NOT_ENDED	"A previous block at this same place was exited through 'return' or 'goto'."
 
 # ifdef E4C_THREADSAFE
 #	include <pthread.h>
@@ -116,12 +226,15 @@
 #		define PTHREAD_CANCELED		( (void *)-1 )
 #	endif
 #	define E4C_CONTEXT				_e4c_context_get_current()
+#	define E4C_EXISTING_CONTEXT		_e4c_context_get_existing()
 #	define DESC_INVALID_STATE		"The exception context for this thread is in an invalid state."
 #	define DESC_ALREADY_BEGUN		"The exception context for this thread has already begun."
 #	define DESC_NOT_BEGUN_YET		"The exception context for this thread has not begun yet."
 #	define DESC_NOT_ENDED			"There is at least one thread that did not end its exception context properly."
 #	define DESC_LOCK_ERROR			"Synchronization error (could not acquire lock)."
 #	define DESC_UNLOCK_ERROR		"Synchronization error (could not release lock)."
+#	define DESC_KEY_ERROR			"Could not create the thread-specific key for the exception contexts."
+#	define DESC_SETSPECIFIC_ERROR	"Could not bind the exception context to the current thread."
 #	define MSG_FATAL_ERROR			"\n\nThis is an unrecoverable programming error; the thread will be terminated\nimmediately.\n"
 #	define MSG_AT_EXIT_ERROR		"\n\nException system errors occurred during program execution.\n"
 #	define THREAD_TYPE				pthread_t
@@ -139,9 +252,28 @@
 			_e4c_library_fatal_error(&ExceptionSystemFatalError, DESC_UNLOCK_ERROR, __FILE__, __LINE__, function, errno); \
 		}
 #	define STOP_EXECUTION			do{ THREAD_CANCEL_CURRENT; THREAD_EXIT; }while(E4C_TRUE)
-#	define DANGLING_CONTEXT			(environment_collection.first != NULL)
+/*
+ * The E4C_AUTO_CONTEXT compile-time parameter
+ * could be defined in order to begin the exception context of each thread
+ * lazily, and end it automatically when the thread exits.
+ */
+#	define OWNED_CONTEXT			( _e4c_environment_contains(E4C_EXISTING_CONTEXT) ? E4C_EXISTING_CONTEXT : NULL )
+#	define BIND_CONTEXT(context, function) \
+		if(pthread_setspecific(environment_key, context) != 0){ \
+			_e4c_library_fatal_error(&ExceptionSystemFatalError, DESC_SETSPECIFIC_ERROR, __FILE__, __LINE__, function, errno); \
+		}
+#	ifdef E4C_AUTO_CONTEXT
+#		define ADOPT_CONTEXT			E4C_TRUE
+#		define DANGLING_CONTEXT			E4C_FALSE
+#		define ENVIRONMENT_DESTRUCTOR	_e4c_environment_destroy
+#	else
+#		define ADOPT_CONTEXT			E4C_FALSE
+#		define DANGLING_CONTEXT			(environment_collection.first != NULL || E4C_EXISTING_CONTEXT != NULL)
+#		define ENVIRONMENT_DESTRUCTOR	NULL
+#	endif
 # else
 #	define E4C_CONTEXT				current_context
+#	define E4C_EXISTING_CONTEXT		current_context
 #	define DESC_INVALID_STATE		"The exception context for this program is in an invalid state."
 #	define DESC_ALREADY_BEGUN		"The exception context for this program has already begun."
 #	define DESC_NOT_BEGUN_YET		"The exception context for this program has not begun yet."
@@ -153,6 +285,88 @@
 #	define MUTEX_UNLOCK(mutex, function)
 #	define STOP_EXECUTION			exit(EXIT_FAILURE)
 #	define DANGLING_CONTEXT			(current_context != NULL)
+#	define OWNED_CONTEXT			(current_context == &main_context ? current_context : NULL)
+#	define BIND_CONTEXT(context, function) \
+		current_context = context;
+# endif
+
+/*
+ * The MISSING_SYNC_BUILTINS compile-time parameter
+ * could be defined in order to protect the reference counts of the exceptions
+ * (and to order the writes that other threads may read) with a mutex, instead
+ * of using the atomic builtins of GCC.
+ */
+# if	defined(E4C_THREADSAFE) \
+	&&	!defined(MISSING_SYNC_BUILTINS) \
+	&&	defined(__GNUC__) \
+	&&	( __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 1) )
+#	define REFERENCE_ADD(exception, delta) \
+		__sync_add_and_fetch(&(exception)->ref_count, delta)
+#	define MEMORY_BARRIER(function) \
+		__sync_synchronize();
+# elif defined(E4C_THREADSAFE)
+#	define REFERENCE_MUTEX
+#	define REFERENCE_ADD(exception, delta) \
+		_e4c_exception_add_reference(exception, delta)
+#	define MEMORY_BARRIER(function) \
+		MUTEX_LOCK(reference_mutex, function) \
+		MUTEX_UNLOCK(reference_mutex, function)
+# else
+#	define REFERENCE_ADD(exception, delta) \
+		( (exception)->ref_count += (delta) )
+#	define MEMORY_BARRIER(function)
+# endif
+
+/*
+ * Flight records are published by a single release store of their sequence
+ * number, preceded by a store-store fence (which costs nothing on x86); the
+ * threads that print them out check the sequence number before and after
+ * taking a snapshot, so that a torn record is skipped. Without the atomic
+ * builtins of GCC, only the compiler is kept from reordering the stores.
+ */
+# if	defined(E4C_THREADSAFE) \
+	&&	!defined(MISSING_SYNC_BUILTINS) \
+	&&	defined(__GNUC__) \
+	&&	( __GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 7) )
+#	define RECORD_FENCE \
+		__atomic_thread_fence(__ATOMIC_RELEASE);
+#	define RECORD_PUBLISH(record, value) \
+		__atomic_store_n(&(record)->sequence, value, __ATOMIC_RELEASE);
+# elif defined(E4C_THREADSAFE)
+#	define RECORD_FENCE
+#	define RECORD_PUBLISH(record, value) \
+		*(volatile unsigned long *)&(record)->sequence = (value);
+# else
+#	define RECORD_FENCE
+#	define RECORD_PUBLISH(record, value) \
+		(record)->sequence = (value);
+# endif
+
+/*
+ * Live exceptions are counted by the exception context that created them,
+ * without synchronization. Only the exceptions released by a different thread
+ * (or exception context), and the ones left alive when their context ends,
+ * are counted by the whole program, so just that path needs to be atomic.
+ */
+# if !defined(E4C_STATISTICS)
+#	define LIVE_EXCEPTION_CREATED(context, exception)
+#	define FOREIGN_EXCEPTIONS_ADD(delta, function)
+# else
+#	define LIVE_EXCEPTION_CREATED(context, exception) \
+		(exception)->_context = (context); \
+		(context)->live_exceptions++;
+#	if defined(REFERENCE_MUTEX)
+#		define FOREIGN_EXCEPTIONS_ADD(delta, function) \
+			MUTEX_LOCK(reference_mutex, function) \
+			foreign_exceptions += (delta); \
+			MUTEX_UNLOCK(reference_mutex, function)
+#	elif defined(E4C_THREADSAFE)
+#		define FOREIGN_EXCEPTIONS_ADD(delta, function) \
+			(void)__sync_add_and_fetch(&foreign_exceptions, delta);
+#	else
+#		define FOREIGN_EXCEPTIONS_ADD(delta, function) \
+			foreign_exceptions += (delta);
+#	endif
 # endif
 
 # define MISUSE_ERROR(exception, message, file, line, function) \
@@ -336,34 +550,12 @@ typedef enum e4c_frame_stage_ e4c_frame_stage;
 
 typedef struct e4c_continuation_ e4c_continuation;
 
+/* (frames and contexts are declared in e4c.h so that boundaries can be placed in the stack) */
 typedef struct e4c_frame_ e4c_frame;
-struct e4c_frame_{
-	/*@only@*/ /*@null@*/
-	e4c_frame *					previous;
-	e4c_frame_stage				stage;
-	E4C_BOOL					uncaught;
-	/*@only@*/ /*@null@*/
-	e4c_exception *				thrown_exception;
-	int							retry_attempts;
-	int							reacquire_attempts;
-	e4c_continuation			continuation;
-};
 
 typedef struct e4c_context_ e4c_context;
-struct e4c_context_{
-	/*@only@*/ /*@null@*/
-	e4c_frame *					current_frame;
-	/*@dependent@*/ /*@null@*/
-	const e4c_signal_mapping *	signal_mappings;
-	/*@shared@*/ /*@null@*/
-	e4c_uncaught_handler		uncaught_handler;
-	/*@shared@*/ /*@null@*/
-	void *						custom_data;
-	/*@shared@*/ /*@null@*/
-	e4c_initialize_handler		initialize_handler;
-	/*@shared@*/ /*@null@*/
-	e4c_finalize_handler		finalize_handler;
-};
+
+typedef struct e4c_boundary_ e4c_boundary;
 
 # ifdef E4C_THREADSAFE
 
@@ -416,12 +608,32 @@ MUTEX_DEFINE(is_initialized_mutex)
 /*@unchecked@*/
 MUTEX_DEFINE(environment_collection_mutex)
 
+# ifdef REFERENCE_MUTEX
+/** mutex to control access to the reference counts of the exceptions */
+/*@unchecked@*/
+MUTEX_DEFINE(reference_mutex)
+# endif
+
+/** key to retrieve the environment of the current thread */
+static
+pthread_key_t
+environment_key;
+
+/** flag to determine if the environment key is created */
+static volatile
+E4C_BOOL
+environment_key_created = E4C_FALSE;
+
 # else
 
 /** main exception context of the program */
 static
 e4c_context
-main_context = { NULL, NULL, NULL, NULL, NULL, NULL };
+main_context = { NULL, NULL, NULL, NULL, NULL, NULL, E4C_FALSE, NULL, 0, 0UL, NULL, NULL, NULL, { {NULL, NULL} }
+#	ifdef E4C_STATISTICS
+	, NULL, NULL, 0L, 0L
+#	endif
+};
 
 /** pointer to the current exception context */
 static
@@ -431,6 +643,45 @@ current_context = NULL;
 
 # endif
 
+# ifdef E4C_STATISTICS
+
+/** statistics of the exception contexts that already ended */
+static
+e4c_statistic
+retired_statistics[E4C_STATISTICS_SIZE + 1];
+
+/** sink for the statistics that cannot be counted (out of memory) */
+static
+e4c_statistic
+lost_statistic;
+
+/** latencies of the exception contexts that already ended */
+static
+e4c_latency
+retired_latencies[E4C_LATENCY_SIZE + 1];
+
+/** sink for the latencies that cannot be measured (out of memory) */
+static
+e4c_latency
+lost_latency;
+
+/** number of live exceptions not counted by the context that created them */
+static
+volatile long
+foreign_exceptions = 0L;
+
+# endif
+
+# ifdef HAVE_PROBES
+
+/* the tracers enable each probe by incrementing its semaphore */
+DEFINE_PROBE_SEMAPHORE(throw);
+DEFINE_PROBE_SEMAPHORE(catch);
+DEFINE_PROBE_SEMAPHORE(propagate);
+DEFINE_PROBE_SEMAPHORE(signal);
+
+# endif
+
 /** symbolic signal names */
 static
 /*@unchecked@*/ /*@observer@*/
@@ -487,6 +738,7 @@ E4C_DEFINE_EXCEPTION(RuntimeException,					"Runtime exception.",				RuntimeExcep
 E4C_DEFINE_EXCEPTION(NotEnoughMemoryException,			"Not enough memory.",				RuntimeException);
 E4C_DEFINE_EXCEPTION(InputOutputException,				"Input/output exception.",			RuntimeException);
 E4C_DEFINE_EXCEPTION(IllegalArgumentException,			"Illegal argument.",				RuntimeException);
+E4C_DEFINE_EXCEPTION(OmittedCausesException,			"Older causes were omitted.",		RuntimeException);
 
 E4C_DEFINE_EXCEPTION(SignalException,					"Signal received.",					RuntimeException);
 E4C_DEFINE_EXCEPTION(SignalAlarmException,				"Alarm clock signal received.",		SignalException);
@@ -762,7 +1014,8 @@ E4C_NO_RETURN;
  *         _e4c_environment_initialize
  *         _e4c_environment_add
  *         _e4c_environment_remove
- *         _e4c_environment_get_current
+ *         _e4c_environment_contains
+ *         _e4c_environment_destroy (automatic contexts only)
  *
  */
 
@@ -877,10 +1130,11 @@ _e4c_environment_add(
 ;
 
 static
-/*@null@*/ /*@only@*/
+/*@only@*/ /*@null@*/
 e4c_environment *
 _e4c_environment_remove(
-	void
+	/*@temp@*/ /*@null@*/
+	const e4c_context *			context
 )
 /*@globals
 	fileSystem,
@@ -907,10 +1161,41 @@ _e4c_environment_remove(
 ;
 
 static
-/*@dependent@*/ /*@null@*/
-e4c_environment *
-_e4c_environment_get_current(
-	void
+E4C_BOOL
+_e4c_environment_contains(
+	/*@temp@*/ /*@null@*/
+	const e4c_context *			context
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+;
+
+#	ifdef E4C_AUTO_CONTEXT
+
+static
+void
+_e4c_environment_destroy(
+	/*@temp@*/ /*@null@*/
+	void *						context
 )
 /*@globals
 	fileSystem,
@@ -929,12 +1214,15 @@ _e4c_environment_get_current(
 	fileSystem,
 	internalState,
 
+	environment_collection,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized
 @*/
 ;
 
+#	endif
+
 # endif
 
 /*
@@ -947,13 +1235,30 @@ _e4c_environment_get_current(
  *         e4c_context_get_signal_mappings
  *         e4c_context_set_signal_mappings
  *         e4c_context_set_handlers
+ *         e4c_context_set_type_handlers
+ *         e4c_context_set_flight_recorder
+ *         e4c_context_set_event_handler
+ *         e4c_print_flight_recorders
  *
  *     PRIVATE
  *         _e4c_context_initialize
  *         _e4c_context_set_signal_handlers
  *         _e4c_context_at_uncaught_exception
+ *         _e4c_context_record
+ *         _e4c_context_notify
+ *         _e4c_context_depth
+ *         _e4c_context_monotonic_time
+ *         _e4c_context_print_records
+ *         _e4c_context_dispatch
+ *         _e4c_context_find_handler
+ *         _e4c_context_find_collector
+ *         _e4c_context_find_type_handler
+ *         _e4c_context_clear_type_handlers
+ *         _e4c_context_collect
+ *         _e4c_context_unwind
  *         _e4c_context_propagate
  *         _e4c_context_get_current (multi-thread only)
+ *         _e4c_context_get_existing (multi-thread only)
  *
  */
 
@@ -1254,18 +1559,16 @@ e4c_context_set_handlers(
 ;
 /*@=redecl@*/
 
-static E4C_INLINE
+/*@-redecl@*/
 void
-_e4c_context_initialize(
-	/*@out@*/ /*@notnull@*/
-	e4c_context *				context,
-	/*@shared@*/ /*@null@*/
-	e4c_uncaught_handler		uncaught_handler
+e4c_context_set_flight_recorder(
+	/*@dependent@*/ /*@null@*/
+	e4c_flight_record *			records,
+	int							capacity
 )
 # ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
-	internalState,
 
 	environment_collection,
 	environment_collection_mutex,
@@ -1274,49 +1577,52 @@ _e4c_context_initialize(
 	is_initialized,
 	is_initialized_mutex,
 
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
-	context
+	environment_collection,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
 @*/
 # else
 /*@globals
 	fileSystem,
-	internalState,
 
 	current_context,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized,
 
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
-	context
+	current_context->flight_records,
+	current_context->flight_capacity,
+	current_context->flight_count,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
 @*/
 # endif
 ;
+/*@=redecl@*/
 
-static
+/*@-redecl@*/
 void
-_e4c_context_set_signal_handlers(
-	/*@in@*/ /*@temp@*/ /*@notnull@*/
-	e4c_context *				context,
-	/*@in@*/ /*@dependent@*/ /*@null@*/
-	const e4c_signal_mapping *	mappings
+e4c_context_set_type_handlers(
+	/*@dependent@*/ /*@null@*/
+	const e4c_type_handler *	type_handlers
 )
 # ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
-	internalState,
 
 	environment_collection,
 	environment_collection_mutex,
@@ -1325,76 +1631,53 @@ _e4c_context_set_signal_handlers(
 	is_initialized,
 	is_initialized_mutex,
 
+	ContextHasNotBegunYet,
 	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
+	environment_collection,
 	fatal_error_flag,
 	is_finalized,
-	is_initialized,
-
-	context->signal_mappings
+	is_initialized
 @*/
 # else
 /*@globals
 	fileSystem,
-	internalState,
 
 	current_context,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized,
 
+	ContextHasNotBegunYet,
 	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
+	current_context->type_handlers,
+	current_context->type_handler_cache,
 	fatal_error_flag,
 	is_finalized,
-	is_initialized,
-
-	context->signal_mappings
+	is_initialized
 @*/
 # endif
 ;
+/*@=redecl@*/
 
-static
-void
-_e4c_context_at_uncaught_exception(
-	/*@in@*/ /*@temp@*/ /*@null@*/
-	e4c_context *				context,
-	/*@in@*/ /*@temp@*/ /*@notnull@*/
-	const e4c_exception *		exception
-)
-/*@globals
-	fileSystem,
-	internalState,
-
-	ExceptionSystemFatalError
-@*/
-/*@modifies
-	fileSystem,
-	internalState
-@*/
-;
-
-static /*@noreturn@*/
+/*@-redecl@*/
 void
-_e4c_context_propagate(
-	/*@in@*/ /*@notnull@*/
-	e4c_context *				context,
-	/*@in@*/ /*@only@*/ /*@notnull@*/
-	e4c_exception *				exception
+e4c_context_set_event_handler(
+	/*@dependent@*/ /*@null@*/
+	e4c_event_handler			handler,
+	/*@dependent@*/ /*@null@*/
+	void *						data
 )
-/*@requires notnull context->current_frame@*/
 # ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
-	internalState,
 
 	environment_collection,
 	environment_collection_mutex,
@@ -1408,20 +1691,15 @@ _e4c_context_propagate(
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
 	environment_collection,
 	fatal_error_flag,
 	is_finalized,
-	is_initialized,
-
-	context->current_frame,
-	context->current_frame->thrown_exception
+	is_initialized
 @*/
 # else
 /*@globals
 	fileSystem,
-	internalState,
 
 	current_context,
 	fatal_error_flag,
@@ -1433,134 +1711,65 @@ _e4c_context_propagate(
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
+	current_context->event_handler,
+	current_context->event_data,
 	fatal_error_flag,
 	is_finalized,
-	is_initialized,
-
-	context->current_frame,
-	context->current_frame->thrown_exception
+	is_initialized
 @*/
 # endif
-E4C_NO_RETURN;
-
-# ifdef E4C_THREADSAFE
+;
+/*@=redecl@*/
 
-static E4C_INLINE
-/*@dependent@*/ /*@null@*/
-e4c_context *
-_e4c_context_get_current(
+/*@-redecl@*/
+void
+e4c_print_flight_recorders(
 	void
 )
+# ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
-	internalState,
 
 	environment_collection,
 	environment_collection_mutex,
+	environment_key,
 	fatal_error_flag,
-	is_finalized,
-	is_initialized,
-	is_initialized_mutex,
 
 	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
-@*/
-;
-
-# endif
-
-/*
- * FRAME
- *
- *     PUBLIC
- *         e4c_get_status
- *
- *     PROTECTED
- *         e4c_frame_first_stage_
- *         e4c_frame_next_stage_
- *         e4c_frame_get_stage_
- *         e4c_frame_catch_
- *         e4c_frame_repeat_
- *
- *     PRIVATE
- *         _e4c_frame_allocate
- *         _e4c_frame_deallocate
- *         _e4c_frame_initialize
- *
- */
-
-/*@-redecl@*/
-e4c_status
-e4c_get_status(
-	void
-)
-# ifdef E4C_THREADSAFE
-/*@globals
-	fileSystem,
-
-	environment_collection,
-	environment_collection_mutex,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized,
-	is_initialized_mutex,
-
-	ContextHasNotBegunYet,
-	ExceptionSystemFatalError
-@*/
-/*@modifies
-	fileSystem,
-
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
+	fatal_error_flag
 @*/
 # else
 /*@globals
 	fileSystem,
 
-	current_context,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized,
-
-	ContextHasNotBegunYet,
-	ExceptionSystemFatalError
+	current_context
 @*/
 /*@modifies
-	fileSystem,
-
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
+	fileSystem
 @*/
 # endif
 ;
 /*@=redecl@*/
 
-/*@-redecl@*/
-/*@notnull@*/ /*@temp@*/
-e4c_continuation *
-e4c_frame_first_stage_(
-	enum e4c_frame_stage_		stage,
-	/*@in@*/ /*@observer@*/ /*@null@*/
-	const char *				file,
-	int							line,
-	/*@in@*/ /*@observer@*/ /*@null@*/
-	const char *				function
+static E4C_INLINE
+void
+_e4c_context_initialize(
+	/*@out@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@shared@*/ /*@null@*/
+	e4c_uncaught_handler		uncaught_handler,
+	/*@only@*/ /*@notnull@*/
+	e4c_frame *					top_frame
 )
 # ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
+	internalState,
 
 	environment_collection,
 	environment_collection_mutex,
@@ -1569,49 +1778,50 @@ e4c_frame_first_stage_(
 	is_initialized,
 	is_initialized_mutex,
 
-	ContextHasNotBegunYet,
 	ExceptionSystemFatalError,
 	NotEnoughMemoryException
 @*/
 /*@modifies
 	fileSystem,
+	internalState,
 
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
+	context
 @*/
 # else
 /*@globals
 	fileSystem,
+	internalState,
 
 	current_context,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized,
 
-	ContextHasNotBegunYet,
 	ExceptionSystemFatalError,
 	NotEnoughMemoryException
 @*/
 /*@modifies
 	fileSystem,
+	internalState,
 
-	current_context->current_frame,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
+	context
 @*/
 # endif
 ;
-/*@=redecl@*/
 
-/*@-redecl@*/
-E4C_BOOL
-e4c_frame_next_stage_(
-	void
+static
+void
+_e4c_context_set_signal_handlers(
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@in@*/ /*@dependent@*/ /*@null@*/
+	const e4c_signal_mapping *	mappings
 )
 # ifdef E4C_THREADSAFE
 /*@globals
+	fileSystem,
+	internalState,
+
 	environment_collection,
 	environment_collection_mutex,
 	fatal_error_flag,
@@ -1619,206 +1829,262 @@ e4c_frame_next_stage_(
 	is_initialized,
 	is_initialized_mutex,
 
-	AssertionException,
-	ContextHasNotBegunYet,
 	ExceptionSystemFatalError
 @*/
 /*@modifies
-	environment_collection,
+	fileSystem,
+	internalState,
+
 	fatal_error_flag,
 	is_finalized,
-	is_initialized
+	is_initialized,
+
+	context->signal_mappings
 @*/
 # else
 /*@globals
+	fileSystem,
+	internalState,
+
 	current_context,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized,
 
-	AssertionException,
-	ContextHasNotBegunYet,
 	ExceptionSystemFatalError
 @*/
 /*@modifies
-	current_context->current_frame,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
-@*/
-# endif
-;
-/*@=redecl@*/
-
-/*@-redecl@*/
-e4c_frame_stage
-e4c_frame_get_stage_(
-	/*@in@*/ /*@observer@*/ /*@null@*/
-	const char *				file,
-	int							line,
-	/*@in@*/ /*@observer@*/ /*@null@*/
-	const char *				function
-)
-# ifdef E4C_THREADSAFE
-/*@globals
 	fileSystem,
+	internalState,
 
-	environment_collection,
-	environment_collection_mutex,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized,
-	is_initialized_mutex,
 
-	ContextHasNotBegunYet,
-	ExceptionSystemFatalError
+	context->signal_mappings
 @*/
-/*@modifies
-	fileSystem,
+# endif
+;
 
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
-@*/
-# else
+static
+void
+_e4c_context_at_uncaught_exception(
+	/*@in@*/ /*@temp@*/ /*@null@*/
+	e4c_context *				context,
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
+)
 /*@globals
 	fileSystem,
+	internalState,
 
-	current_context,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized,
-
-	ContextHasNotBegunYet,
 	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
+	internalState
 @*/
-# endif
 ;
-/*@=redecl@*/
 
-/*@-redecl@*/
-E4C_BOOL
-e4c_frame_catch_(
-	/*@in@*/ /*@temp@*/ /*@null@*/
+static E4C_INLINE
+void
+_e4c_context_record(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@in@*/ /*@dependent@*/ /*@null@*/
 	const e4c_exception_type *	exception_type,
 	/*@in@*/ /*@observer@*/ /*@null@*/
 	const char *				file,
 	int							line,
 	/*@in@*/ /*@observer@*/ /*@null@*/
-	const char *				function
+	const char *				function,
+	int							error_number
 )
-# ifdef E4C_THREADSAFE
-/*@globals
-	fileSystem,
-
-	environment_collection,
-	environment_collection_mutex,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized,
-	is_initialized_mutex,
-
-	ContextHasNotBegunYet,
-	ExceptionSystemFatalError,
-	NullPointerException
-@*/
-/*@modifies
-	fileSystem,
-
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
-@*/
-# else
 /*@globals
-	fileSystem,
-
-	current_context,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized,
-
-	ContextHasNotBegunYet,
-	ExceptionSystemFatalError,
 	NullPointerException
 @*/
 /*@modifies
-	fileSystem,
-
-	current_context->current_frame,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
+	context->flight_records,
+	context->flight_count
 @*/
-# endif
 ;
-/*@=redecl@*/
 
-/*@-redecl@*/
-/*@maynotreturn@*/ void
-e4c_frame_repeat_(
-	int							max_repeat_attempts,
-	enum e4c_frame_stage_		stage,
+static
+void
+_e4c_context_notify(
+	/*@in@*/ /*@notnull@*/
+	const e4c_context *			context,
+	e4c_event					event,
+	/*@in@*/ /*@dependent@*/ /*@null@*/
+	const e4c_exception *		exception,
 	/*@in@*/ /*@observer@*/ /*@null@*/
 	const char *				file,
 	int							line,
 	/*@in@*/ /*@observer@*/ /*@null@*/
 	const char *				function
 )
-# ifdef E4C_THREADSAFE
 /*@globals
-	environment_collection,
-	environment_collection_mutex,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized,
-	is_initialized_mutex,
-
-	AssertionException,
-	ContextHasNotBegunYet,
-	ExceptionSystemFatalError
+	fileSystem,
+	internalState
 @*/
 /*@modifies
-	fatal_error_flag,
-	is_finalized,
-	is_initialized
+	fileSystem,
+	internalState
 @*/
-# else
+;
+
+static
+int
+_e4c_context_depth(
+	/*@in@*/ /*@notnull@*/
+	const e4c_context *			context
+)
+/*@*/
+;
+
+static
+void
+_e4c_context_monotonic_time(
+	/*@out@*/ /*@notnull@*/
+	long *						seconds,
+	/*@out@*/ /*@notnull@*/
+	long *						nanoseconds
+)
 /*@globals
-	current_context,
-	fatal_error_flag,
-	is_finalized,
-	is_initialized,
+	internalState
+@*/
+/*@modifies
+	*seconds,
+	*nanoseconds
+@*/
+;
 
-	AssertionException,
-	ContextHasNotBegunYet,
-	ExceptionSystemFatalError
+static
+void
+_e4c_context_print_records(
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_context *			context
+)
+/*@globals
+	fileSystem
 @*/
 /*@modifies
-	current_context->current_frame,
-	is_finalized,
-	is_initialized,
-	fatal_error_flag
+	fileSystem
 @*/
-# endif
 ;
-/*@=redecl@*/
 
-static E4C_INLINE
-/*@out@*/
+static /*@noreturn@*/
+void
+_e4c_context_dispatch(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@in@*/ /*@only@*/ /*@notnull@*/
+	e4c_exception *				exception
+)
+/*@requires notnull context->current_frame@*/
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	context->current_frame,
+	context->current_frame->thrown_exception
+@*/
+E4C_NO_RETURN;
+
+# ifdef E4C_FAST_FAIL
+
+static
+/*@dependent@*/ /*@null@*/
 e4c_frame *
-_e4c_frame_allocate(
-	int							line,
-	/*@in@*/ /*@observer@*/ /*@notnull@*/
-	const char *				function
+_e4c_context_find_handler(
+	/*@in@*/ /*@notnull@*/
+	const e4c_context *			context,
+	/*@in@*/ /*@notnull@*/
+	const e4c_exception *		exception
+)
+/*@*/
+;
+
+# endif
+
+static
+/*@dependent@*/ /*@null@*/
+e4c_frame *
+_e4c_context_find_collector(
+	/*@in@*/ /*@notnull@*/
+	const e4c_context *			context,
+	/*@in@*/ /*@null@*/
+	const e4c_exception_type *	exception_type
+)
+/*@*/
+;
+
+static
+/*@dependent@*/ /*@null@*/
+const e4c_type_handler *
+_e4c_context_find_type_handler(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@in@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type
+)
+/*@modifies
+	context->type_handler_cache
+@*/
+;
+
+static
+void
+_e4c_context_clear_type_handlers(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context
+)
+/*@modifies
+	context->type_handler_cache
+@*/
+;
+
+static /*@noreturn@*/
+void
+_e4c_context_collect(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@in@*/ /*@notnull@*/ /*@dependent@*/
+	e4c_frame *					frame
+)
+/*@modifies
+	context->current_frame,
+	frame->stage
+@*/
+E4C_NO_RETURN;
+
+static
+void
+_e4c_context_unwind(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@in@*/ /*@null@*/ /*@dependent@*/
+	const e4c_frame *			target
+)
+/*@modifies
+	context->current_frame
+@*/
+;
+
+static /*@noreturn@*/
+void
+_e4c_context_propagate(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@in@*/ /*@only@*/ /*@notnull@*/
+	e4c_exception *				exception,
+	E4C_BOOL					leaving
 )
+/*@requires notnull context->current_frame@*/
 # ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
@@ -1831,16 +2097,20 @@ _e4c_frame_allocate(
 	is_initialized,
 	is_initialized_mutex,
 
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
 	internalState,
 
+	environment_collection,
 	fatal_error_flag,
 	is_finalized,
-	is_initialized
+	is_initialized,
+
+	context->current_frame,
+	context->current_frame->thrown_exception
 @*/
 # else
 /*@globals
@@ -1852,8 +2122,8 @@ _e4c_frame_allocate(
 	is_finalized,
 	is_initialized,
 
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
@@ -1861,204 +2131,194 @@ _e4c_frame_allocate(
 
 	fatal_error_flag,
 	is_finalized,
-	is_initialized
+	is_initialized,
+
+	context->current_frame,
+	context->current_frame->thrown_exception
 @*/
 # endif
-;
+E4C_NO_RETURN;
+
+# ifdef E4C_THREADSAFE
 
 static E4C_INLINE
-void
-_e4c_frame_deallocate(
-	/*@only@*/ /*@null@*/
-	e4c_frame *					frame,
-	/*@shared@*/ /*@null@*/
-	e4c_finalize_handler 		finalize_handler
+/*@dependent@*/ /*@null@*/
+e4c_context *
+_e4c_context_get_current(
+	void
 )
-/*@releases
-	frame
+/*@globals
+	fileSystem,
+	internalState,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ExceptionSystemFatalError
 @*/
 /*@modifies
-	frame
+	fileSystem,
+	internalState,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
 @*/
 ;
 
 static E4C_INLINE
-void
-_e4c_frame_initialize(
-	/*@out@*/ /*@notnull@*/
-	e4c_frame *					frame,
-	/*@only@*/ /*@in@*/ /*@null@*/
-	e4c_frame *					previous,
-	e4c_frame_stage				stage
+/*@dependent@*/ /*@null@*/
+e4c_context *
+_e4c_context_get_existing(
+	void
 )
-/*@ensures isnull frame->thrown_exception@*/
-/*@modifies
-	frame
+/*@globals
+	environment_key,
+	environment_key_created
 @*/
 ;
 
+# endif
+
 /*
- * EXCEPTION TYPE
- *
- *     PUBLIC
- *         e4c_print_exception_type
- *         e4c_is_instance_of
+ * BOUNDARY
  *
- *     PRIVATE
- *         _e4c_print_exception_type
- *         _e4c_print_exception_type_node
- *         _e4c_exception_type_extends
+ *     PROTECTED
+ *         e4c_boundary_borrow_
+ *         e4c_boundary_begin_
+ *         e4c_boundary_end_
  *
  */
 
 /*@-redecl@*/
-void
-e4c_print_exception_type(
-	/*@in@*/ /*@shared@*/ /*@notnull@*/
-	const e4c_exception_type *	exception_type
+E4C_BOOL
+e4c_boundary_borrow_(
+	/*@notnull@*/ /*@temp@*/
+	e4c_boundary *				boundary
 )
 # ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
+	internalState,
 
-	environment_collection,
-	environment_collection_mutex,
+	environment_key,
+	environment_key_created,
 	fatal_error_flag,
-	is_finalized,
-	is_initialized,
-	is_initialized_mutex,
 
-	ContextHasNotBegunYet,
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	ContextNotEnded
 @*/
 /*@modifies
-	fileSystem
+	fileSystem,
+	internalState,
+
+	fatal_error_flag
 @*/
 # else
 /*@globals
 	fileSystem,
+	internalState,
 
 	current_context,
 	fatal_error_flag,
-	is_finalized,
-	is_initialized,
 
-	ContextHasNotBegunYet,
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	ContextNotEnded
 @*/
 /*@modifies
 	fileSystem,
+	internalState,
 
-	current_context->current_frame
+	current_context,
+	fatal_error_flag
 @*/
 # endif
 ;
 /*@=redecl@*/
 
 /*@-redecl@*/
-E4C_BOOL
-e4c_is_instance_of(
-	/*@in@*/ /*@temp@*/ /*@notnull@*/
-	const e4c_exception *		instance,
-	/*@in@*/ /*@temp@*/ /*@notnull@*/
-	const e4c_exception_type *	exception_type
-)
-/*@*/
-;
-/*@=redecl@*/
-
-/*@-redecl@*/
-static E4C_INLINE
-void
-_e4c_print_exception_type(
-	/*@in@*/ /*@shared@*/ /*@notnull@*/
-	const e4c_exception_type *	exception_type
+e4c_continuation *
+e4c_boundary_begin_(
+	/*@notnull@*/ /*@out@*/
+	e4c_boundary *				boundary
 )
+# ifdef E4C_THREADSAFE
 /*@globals
-	fileSystem
+	fileSystem,
+	internalState,
+
+	environment_key,
+	environment_key_created,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ExceptionSystemFatalError
 @*/
 /*@modifies
-	fileSystem
-@*/
-;
-/*@=redecl@*/
+	fileSystem,
+	internalState,
 
-static E4C_INLINE
-int
-_e4c_print_exception_type_node(
-	/*@in@*/ /*@shared@*/ /*@notnull@*/
-	const e4c_exception_type *	exception_type
-)
+	boundary,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
 /*@globals
-	fileSystem
+	fileSystem,
+	internalState,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
 @*/
 /*@modifies
-	fileSystem
-@*/
-;
+	fileSystem,
+	internalState,
 
-static E4C_INLINE
-E4C_BOOL
-_e4c_exception_type_extends(
-	/*@in@*/ /*@temp@*/ /*@notnull@*/
-	const e4c_exception_type *	child,
-	/*@in@*/ /*@temp@*/ /*@notnull@*/
-	const e4c_exception_type *	parent
-)
-/*@*/
+	boundary,
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
 ;
-
-/*
- * EXCEPTION
- *
- *     PUBLIC
- *         e4c_print_exception
- *         e4c_get_exception
- *
- *     PROTECTED
- *         e4c_exception_throw_verbatim_
- *         e4c_exception_throw_format_
- *
- *     PRIVATE
- *         _e4c_exception_allocate
- *         _e4c_exception_deallocate
- *         _e4c_exception_initialize
- *         _e4c_exception_set_cause
- *         _e4c_exception_throw
- *         _e4c_print_exception
- *
- */
+/*@=redecl@*/
 
 /*@-redecl@*/
 void
-e4c_print_exception(
-	/*@in@*/ /*@temp@*/ /*@notnull@*/
-	const e4c_exception *		exception
+e4c_boundary_end_(
+	/*@notnull@*/
+	e4c_boundary *				boundary
 )
 # ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
+	internalState,
 
 	environment_collection,
 	environment_collection_mutex,
+	environment_key,
+	environment_key_created,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized,
 	is_initialized_mutex,
 
 	ContextHasNotBegunYet,
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
+	internalState,
 
-	environment_collection,
+	boundary,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized
@@ -2066,6 +2326,7 @@ e4c_print_exception(
 # else
 /*@globals
 	fileSystem,
+	internalState,
 
 	current_context,
 	fatal_error_flag,
@@ -2073,13 +2334,13 @@ e4c_print_exception(
 	is_initialized,
 
 	ContextHasNotBegunYet,
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
+	internalState,
 
+	boundary,
 	current_context,
 	fatal_error_flag,
 	is_finalized,
@@ -2089,10 +2350,39 @@ e4c_print_exception(
 ;
 /*@=redecl@*/
 
+/*
+ * FRAME
+ *
+ *     PUBLIC
+ *         e4c_get_status
+ *         e4c_batch_init
+ *
+ *     PROTECTED
+ *         e4c_frame_first_stage_
+ *         e4c_frame_next_stage_
+ *         e4c_frame_rearm_
+ *         e4c_frame_next_iteration_
+ *         e4c_frame_collect_
+ *         e4c_frame_last_iteration_
+ *         e4c_frame_get_stage_
+ *         e4c_frame_catch_
+ *         e4c_frame_finally_
+ *         e4c_frame_repeat_
+ *
+ *     PRIVATE
+ *         _e4c_frame_allocate
+ *         _e4c_frame_deallocate
+ *         _e4c_frame_initialize
+ *         _e4c_frame_advance
+ *         _e4c_frame_catches (fast-fail only)
+ *         _e4c_frame_is_transparent (fast-fail only)
+ *         _e4c_batch_add
+ *
+ */
+
 /*@-redecl@*/
-/*@observer@*/ /*@relnull@*/
-const e4c_exception *
-e4c_get_exception(
+e4c_status
+e4c_get_status(
 	void
 )
 # ifdef E4C_THREADSAFE
@@ -2112,7 +2402,6 @@ e4c_get_exception(
 /*@modifies
 	fileSystem,
 
-	environment_collection,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized
@@ -2132,7 +2421,6 @@ e4c_get_exception(
 /*@modifies
 	fileSystem,
 
-	current_context,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized
@@ -2142,18 +2430,30 @@ e4c_get_exception(
 /*@=redecl@*/
 
 /*@-redecl@*/
-/*@noreturn@*/
 void
-e4c_exception_throw_verbatim_(
-	/*@in@*/ /*@shared@*/ /*@notnull@*/
-	const e4c_exception_type *	exception_type,
+e4c_batch_init(
+	/*@out@*/ /*@notnull@*/
+	e4c_batch *					batch,
+	/*@dependent@*/ /*@null@*/
+	e4c_batch_error *			errors,
+	int							capacity
+)
+/*@modifies
+	*batch
+@*/
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+/*@notnull@*/ /*@temp@*/
+e4c_continuation *
+e4c_frame_first_stage_(
+	enum e4c_frame_stage_		stage,
 	/*@in@*/ /*@observer@*/ /*@null@*/
 	const char *				file,
 	int							line,
 	/*@in@*/ /*@observer@*/ /*@null@*/
-	const char *				function,
-	/*@in@*/ /*@observer@*/ /*@temp@*/ /*@null@*/
-	const char *				message
+	const char *				function
 )
 # ifdef E4C_THREADSAFE
 /*@globals
@@ -2168,13 +2468,11 @@ e4c_exception_throw_verbatim_(
 
 	ContextHasNotBegunYet,
 	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	NotEnoughMemoryException
 @*/
 /*@modifies
 	fileSystem,
 
-	environment_collection,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized
@@ -2190,43 +2488,27 @@ e4c_exception_throw_verbatim_(
 
 	ContextHasNotBegunYet,
 	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	NotEnoughMemoryException
 @*/
 /*@modifies
 	fileSystem,
 
-	current_context,
 	current_context->current_frame,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized
 @*/
 # endif
-E4C_NO_RETURN;
+;
 /*@=redecl@*/
 
-# if defined(HAVE_C99_VSNPRINTF) || defined(HAVE_VSNPRINTF)
-
 /*@-redecl@*/
-/*@noreturn@*/
-void
-e4c_exception_throw_format_(
-	/*@in@*/ /*@shared@*/ /*@notnull@*/
-	const e4c_exception_type *	exception_type,
-	/*@in@*/ /*@observer@*/ /*@null@*/
-	const char *				file,
-	int							line,
-	/*@in@*/ /*@observer@*/ /*@null@*/
-	const char *				function,
-	/*@in@*/ /*@observer@*/ /*@temp@*/ /*@notnull@*/ /*@printflike@*/
-	const char *				format,
-	...
+E4C_BOOL
+e4c_frame_next_stage_(
+	void
 )
 # ifdef E4C_THREADSAFE
 /*@globals
-	fileSystem,
-
 	environment_collection,
 	environment_collection_mutex,
 	fatal_error_flag,
@@ -2234,14 +2516,11 @@ e4c_exception_throw_format_(
 	is_initialized,
 	is_initialized_mutex,
 
+	AssertionException,
 	ContextHasNotBegunYet,
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	ExceptionSystemFatalError
 @*/
 /*@modifies
-	fileSystem,
-
 	environment_collection,
 	fatal_error_flag,
 	is_finalized,
@@ -2249,45 +2528,38 @@ e4c_exception_throw_format_(
 @*/
 # else
 /*@globals
-	fileSystem,
-
 	current_context,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized,
 
+	AssertionException,
 	ContextHasNotBegunYet,
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	ExceptionSystemFatalError
 @*/
 /*@modifies
-	fileSystem,
-
-	current_context,
 	current_context->current_frame,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized
 @*/
 # endif
-E4C_NO_RETURN;
+;
 /*@=redecl@*/
 
-# endif
-
-static E4C_INLINE
-/*@out@*/
-e4c_exception *
-_e4c_exception_allocate(
+/*@-redecl@*/
+/*@notnull@*/ /*@temp@*/
+e4c_continuation *
+e4c_frame_rearm_(
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
 	int							line,
-	/*@in@*/ /*@observer@*/ /*@notnull@*/
+	/*@in@*/ /*@observer@*/ /*@null@*/
 	const char *				function
 )
 # ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
-	internalState,
 
 	environment_collection,
 	environment_collection_mutex,
@@ -2296,12 +2568,11 @@ _e4c_exception_allocate(
 	is_initialized,
 	is_initialized_mutex,
 
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
 	fatal_error_flag,
 	is_finalized,
@@ -2310,103 +2581,87 @@ _e4c_exception_allocate(
 # else
 /*@globals
 	fileSystem,
-	internalState,
 
 	current_context,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized,
 
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
+	current_context->current_frame,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized
 @*/
 # endif
 ;
+/*@=redecl@*/
 
-static E4C_INLINE
-void
-_e4c_exception_deallocate(
-	/*@only@*/ /*@null@*/
-	e4c_exception *				exception,
-	/*@shared@*/ /*@null@*/
-	e4c_finalize_handler		finalize_handler
+/*@-redecl@*/
+E4C_BOOL
+e4c_frame_next_iteration_(
+	void
 )
-/*@releases
-	exception
+# ifdef E4C_THREADSAFE
+/*@globals
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	AssertionException,
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
 /*@modifies
-	exception
+	environment_collection,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
 @*/
-;
-
-static E4C_INLINE
-void
-_e4c_exception_initialize(
-	/*@out@*/ /*@notnull@*/
-	e4c_exception *				exception,
-	/*@shared@*/ /*@notnull@*/
-	const e4c_exception_type *	exception_type,
-	E4C_BOOL					set_message,
-	/*@observer@*/ /*@temp@*/ /*@null@*/
-	const char *				message,
-	/*@observer@*/ /*@null@*/
-	const char *				file,
-	int							line,
-	/*@observer@*/ /*@null@*/
-	const char *				function,
-	int							error_number
-)
-/*@ensures isnull exception->cause@*/
-/*@modifies
-	exception
-@*/
-;
+# else
+/*@globals
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
 
-static E4C_INLINE
-void
-_e4c_exception_set_cause(
-	/*@notnull@*/
-	e4c_exception *				exception,
-	/*@owned@*/ /*@notnull@*/
-	e4c_exception *				cause
-)
-/*@requires isnull exception->cause@*/
-/*@ensures notnull exception->cause@*/
+	AssertionException,
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
 /*@modifies
-	cause,
-	exception
+	current_context->current_frame,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
 @*/
+# endif
 ;
+/*@=redecl@*/
 
-static E4C_INLINE
-/*@only@*/ e4c_exception *
-_e4c_exception_throw(
-	/*@in@*/ /*@notnull@*/
-	e4c_frame *					frame,
-	/*@in@*/ /*@shared@*/ /*@notnull@*/
-	const e4c_exception_type *	exception_type,
+/*@-redecl@*/
+E4C_BOOL
+e4c_frame_collect_(
+	/*@in@*/ /*@notnull@*/ /*@dependent@*/
+	e4c_batch *					batch,
+	int							index,
 	/*@in@*/ /*@observer@*/ /*@null@*/
 	const char *				file,
 	int							line,
 	/*@in@*/ /*@observer@*/ /*@null@*/
-	const char *				function,
-	int							error_number,
-	E4C_BOOL					set_message,
-	/*@in@*/ /*@observer@*/ /*@temp@*/ /*@null@*/
-	const char *				message
+	const char *				function
 )
 # ifdef E4C_THREADSAFE
 /*@globals
 	fileSystem,
-	internalState,
 
 	environment_collection,
 	environment_collection_mutex,
@@ -2415,1005 +2670,4427 @@ _e4c_exception_throw(
 	is_initialized,
 	is_initialized_mutex,
 
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
 	fatal_error_flag,
 	is_finalized,
-	is_initialized,
-
-	frame->thrown_exception
+	is_initialized
 @*/
 # else
 /*@globals
 	fileSystem,
-	internalState,
 
 	current_context,
 	fatal_error_flag,
 	is_finalized,
 	is_initialized,
 
-	ExceptionSystemFatalError,
-	NotEnoughMemoryException,
-	NullPointerException
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
 /*@modifies
 	fileSystem,
-	internalState,
 
+	current_context->current_frame,
 	fatal_error_flag,
 	is_finalized,
-	is_initialized,
-
-	frame->thrown_exception
+	is_initialized
 @*/
 # endif
 ;
+/*@=redecl@*/
 
-static E4C_INLINE
-void
-_e4c_print_exception(
-	/*@in@*/ /*@temp@*/ /*@notnull@*/
-	const e4c_exception *		exception
+/*@-redecl@*/
+E4C_BOOL
+e4c_frame_last_iteration_(
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function
 )
-# ifdef NDEBUG
+# ifdef E4C_THREADSAFE
 /*@globals
-	fileSystem
+	fileSystem,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
 @*/
-#else
+/*@modifies
+	fileSystem,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
 /*@globals
 	fileSystem,
 
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ContextHasNotBegunYet,
 	ExceptionSystemFatalError
 @*/
-# endif
 /*@modifies
-	fileSystem
+	fileSystem,
+
+	current_context->current_frame,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
 @*/
+# endif
 ;
+/*@=redecl@*/
 
+/*@-redecl@*/
+e4c_frame_stage
+e4c_frame_get_stage_(
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
 
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
 
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	fileSystem,
 
-/* LIBRARY
- ================================================================ */
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
 
-static void _e4c_library_initialize(void){
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
 
-	MUTEX_LOCK(is_initialized_mutex, "_e4c_library_initialize")
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	fileSystem,
 
-		if(!is_initialized){
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+;
+/*@=redecl@*/
 
-			/* registers the function _e4c_library_finalize to be called when the program exits */
-			is_initialized	= ( atexit(_e4c_library_finalize) == 0 );
-			is_finalized	= !is_initialized;
-		}
+/*@-redecl@*/
+E4C_BOOL
+e4c_frame_catch_(
+	/*@in@*/ /*@temp@*/ /*@null@*/
+	const e4c_exception_type *	exception_type,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
 
-	MUTEX_UNLOCK(is_initialized_mutex, "_e4c_library_initialize")
-}
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
 
-static void _e4c_library_finalize(void){
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
 
-	/* check flag to prevent from looping */
-	if(is_finalized){
-		return;
-	}
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
 
-	is_finalized = E4C_TRUE;
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
 
-	/* check for dangling context */
-	if(!fatal_error_flag && DANGLING_CONTEXT){
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
 
-		e4c_exception exception;
+	current_context->current_frame,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+E4C_BOOL
+e4c_frame_finally_(
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	fileSystem,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	fileSystem,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+/*@maynotreturn@*/ void
+e4c_frame_repeat_(
+	int							max_repeat_attempts,
+	enum e4c_frame_stage_		stage,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	AssertionException,
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	AssertionException,
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	current_context->current_frame,
+	is_finalized,
+	is_initialized,
+	fatal_error_flag
+@*/
+# endif
+;
+/*@=redecl@*/
+
+static E4C_INLINE
+/*@out@*/
+e4c_frame *
+_e4c_frame_allocate(
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@notnull@*/
+	const char *				function
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+	internalState,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
+	internalState,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+;
+
+static E4C_INLINE
+void
+_e4c_frame_deallocate(
+	/*@only@*/ /*@null@*/
+	e4c_frame *					frame,
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context
+)
+/*@releases
+	frame
+@*/
+/*@modifies
+	frame
+@*/
+;
+
+static E4C_INLINE
+void
+_e4c_frame_initialize(
+	/*@out@*/ /*@notnull@*/
+	e4c_frame *					frame,
+	/*@only@*/ /*@in@*/ /*@null@*/
+	e4c_frame *					previous,
+	e4c_frame_stage				stage
+)
+/*@ensures isnull frame->thrown_exception@*/
+/*@modifies
+	frame
+@*/
+;
+
+static E4C_INLINE
+E4C_BOOL
+_e4c_frame_advance(
+	E4C_BOOL					iterating
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	AssertionException,
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	environment_collection,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	AssertionException,
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	current_context->current_frame,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+;
+
+# ifdef E4C_FAST_FAIL
+
+static
+E4C_BOOL
+_e4c_frame_catches(
+	/*@in@*/ /*@notnull@*/
+	const e4c_frame *			frame,
+	/*@in@*/ /*@null@*/
+	const e4c_exception_type *	exception_type
+)
+/*@*/
+;
+
+static
+E4C_BOOL
+_e4c_frame_is_transparent(
+	/*@in@*/ /*@notnull@*/
+	const e4c_frame *			frame,
+	/*@in@*/ /*@null@*/
+	const e4c_exception_type *	exception_type
+)
+/*@*/
+;
+
+# endif
+
+static
+/*@null@*/ /*@dependent@*/
+e4c_batch_error *
+_e4c_batch_add(
+	/*@in@*/ /*@notnull@*/
+	e4c_batch *					batch,
+	/*@in@*/ /*@dependent@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function,
+	int							error_number
+)
+/*@modifies
+	batch
+@*/
+;
+
+/*
+ * STATISTICS
+ *
+ *     PUBLIC
+ *         e4c_get_statistics
+ *         e4c_get_latencies
+ *         e4c_latency_bucket
+ *         e4c_get_live_objects
+ *
+ *     PRIVATE
+ *         _e4c_statistics_find (statistics only)
+ *         _e4c_statistics_find_in (statistics only)
+ *         _e4c_statistics_merge (statistics only)
+ *         _e4c_statistics_retire (statistics only)
+ *         _e4c_latency_record (statistics only)
+ *         _e4c_latency_find_in (statistics only)
+ *         _e4c_latency_merge (statistics only)
+ *
+ */
+
+/*@-redecl@*/
+int
+e4c_get_statistics(
+	/*@out@*/ /*@notnull@*/
+	e4c_statistic *				statistics,
+	int							capacity
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+
+	ExceptionSystemFatalError,
+	NullPointerException
+@*/
+/*@modifies
+	statistics,
+	fatal_error_flag
+@*/
+# else
+/*@globals
+	current_context,
+
+	NullPointerException
+@*/
+/*@modifies
+	statistics
+@*/
+# endif
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+int
+e4c_get_latencies(
+	/*@out@*/ /*@notnull@*/
+	e4c_latency *				latencies,
+	int							capacity
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+
+	ExceptionSystemFatalError,
+	NullPointerException
+@*/
+/*@modifies
+	latencies,
+	fatal_error_flag
+@*/
+# else
+/*@globals
+	current_context,
+
+	NullPointerException
+@*/
+/*@modifies
+	latencies
+@*/
+# endif
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+int
+e4c_latency_bucket(
+	long						seconds,
+	long						nanoseconds
+)
+/*@*/
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+void
+e4c_get_live_objects(
+	/*@out@*/ /*@null@*/
+	long *						frames,
+	/*@out@*/ /*@null@*/
+	long *						exceptions
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	*frames,
+	*exceptions,
+	fatal_error_flag
+@*/
+# else
+/*@globals
+	current_context
+@*/
+/*@modifies
+	*frames,
+	*exceptions
+@*/
+# endif
+;
+/*@=redecl@*/
+
+# ifdef E4C_STATISTICS
+
+static
+/*@dependent@*/ /*@notnull@*/
+e4c_statistic *
+_e4c_statistics_find(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@in@*/ /*@dependent@*/ /*@null@*/
+	const e4c_exception_type *	exception_type,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line
+)
+/*@globals
+	lost_statistic
+@*/
+/*@modifies
+	context->statistics
+@*/
+;
+
+static E4C_INLINE
+/*@dependent@*/ /*@null@*/
+e4c_statistic *
+_e4c_statistics_find_in(
+	/*@in@*/ /*@notnull@*/
+	e4c_statistic *				table,
+	/*@in@*/ /*@dependent@*/ /*@null@*/
+	const e4c_exception_type *	exception_type,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line
+)
+/*@modifies
+	table
+@*/
+;
+
+static
+int
+_e4c_statistics_merge(
+	/*@out@*/ /*@notnull@*/
+	e4c_statistic *				statistics,
+	int							capacity,
+	int							count,
+	/*@in@*/ /*@notnull@*/
+	const e4c_statistic *		table
+)
+/*@modifies
+	statistics
+@*/
+;
+
+static
+void
+_e4c_statistics_retire(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context
+)
+/*@globals
+	retired_statistics,
+	retired_latencies
+@*/
+/*@modifies
+	retired_statistics,
+	retired_latencies,
+	context->statistics,
+	context->latencies
+@*/
+;
+
+static
+void
+_e4c_latency_record(
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context,
+	/*@in@*/ /*@notnull@*/
+	const e4c_frame *			frame,
+	e4c_status					status
+)
+/*@globals
+	internalState,
+
+	lost_latency
+@*/
+/*@modifies
+	context->latencies,
+	lost_latency
+@*/
+;
+
+static E4C_INLINE
+/*@dependent@*/ /*@null@*/
+e4c_latency *
+_e4c_latency_find_in(
+	/*@in@*/ /*@notnull@*/
+	e4c_latency *				table,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line
+)
+/*@modifies
+	table
+@*/
+;
+
+static
+int
+_e4c_latency_merge(
+	/*@out@*/ /*@notnull@*/
+	e4c_latency *				latencies,
+	int							capacity,
+	int							count,
+	/*@in@*/ /*@notnull@*/
+	const e4c_latency *			table
+)
+/*@modifies
+	latencies
+@*/
+;
+
+# endif
+
+/*
+ * TEXT
+ *
+ *     PRIVATE
+ *         _e4c_text_append
+ *         _e4c_text_append_number
+ *         _e4c_text_append_unsigned
+ *         _e4c_text_append_padding
+ *         _e4c_text_append_json
+ *         _e4c_text_write
+ *
+ */
+
+static
+size_t
+_e4c_text_append(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				text
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_text_append_number(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	int							number
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_text_append_unsigned(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	unsigned long				number,
+	int							digits
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_text_append_padding(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	int							count
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_text_append_json(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				text
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+void
+_e4c_text_write(
+	/*@in@*/ /*@notnull@*/
+	const char *				text,
+	size_t						length
+)
+/*@globals
+	fileSystem
+@*/
+/*@modifies
+	fileSystem
+@*/
+;
+
+/*
+ * EXCEPTION TYPE
+ *
+ *     PUBLIC
+ *         e4c_print_exception_type
+ *         e4c_is_instance_of
+ *         e4c_map_exception
+ *
+ *     PRIVATE
+ *         _e4c_format_exception_type
+ *         _e4c_format_exception_type_node
+ *         _e4c_exception_type_extends
+ *
+ */
+
+/*@-redecl@*/
+void
+e4c_print_exception_type(
+	/*@in@*/ /*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem
+@*/
+# else
+/*@globals
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	current_context->current_frame
+@*/
+# endif
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+E4C_BOOL
+e4c_is_instance_of(
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		instance,
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type
+)
+/*@*/
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+int
+e4c_map_exception(
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_error_mapping *	mappings,
+	/*@in@*/ /*@temp@*/ /*@null@*/
+	const e4c_exception *		exception
+)
+/*@globals
+	internalState,
+
+	NullPointerException
+@*/
+/*@modifies
+	internalState
+@*/
+;
+/*@=redecl@*/
+
+static
+size_t
+_e4c_format_exception_type(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_format_exception_type_node(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type,
+	/*@out@*/ /*@notnull@*/
+	int *						deep
+)
+/*@modifies
+	buffer,
+	deep
+@*/
+;
+
+static E4C_INLINE
+E4C_BOOL
+_e4c_exception_type_extends(
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception_type *	child,
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception_type *	parent
+)
+/*@*/
+;
+
+/*
+ * EXCEPTION
+ *
+ *     PUBLIC
+ *         e4c_print_exception
+ *         e4c_format_exception
+ *         e4c_get_exception
+ *         e4c_exception_retain
+ *         e4c_exception_release
+ *
+ *     PROTECTED
+ *         e4c_exception_throw_verbatim_
+ *         e4c_exception_throw_payload_
+ *         e4c_exception_throw_format_
+ *         e4c_exception_rethrow_foreign_
+ *
+ *     PRIVATE
+ *         _e4c_exception_allocate
+ *         _e4c_exception_deallocate
+ *         _e4c_exception_initialize
+ *         _e4c_exception_initialize_data
+ *         _e4c_exception_set_cause
+ *         _e4c_exception_limit_causes
+ *         _e4c_exception_add_reference
+ *         _e4c_exception_throw
+ *         _e4c_print_exception
+ *         _e4c_format_exception
+ *         _e4c_format_exception_site
+ *         _e4c_format_exception_json
+ *         _e4c_format_exception_binary
+ *         _e4c_record_append
+ *         _e4c_record_append_number
+ *         _e4c_record_append_string
+ *
+ */
+
+/*@-redecl@*/
+void
+e4c_print_exception(
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	environment_collection,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+/*@observer@*/ /*@relnull@*/
+const e4c_exception *
+e4c_get_exception(
+	void
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	fileSystem,
+
+	environment_collection,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError
+@*/
+/*@modifies
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+/*@null@*/
+const e4c_exception *
+e4c_exception_retain(
+	/*@in@*/ /*@null@*/
+	const e4c_exception *		exception
+)
+/*@modifies
+	internalState
+@*/
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+void
+e4c_exception_release(
+	/*@in@*/ /*@null@*/
+	const e4c_exception *		exception
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+	internalState,
+
+	environment_key_created
+@*/
+# else
+/*@globals
+	fileSystem,
+	internalState,
+
+	current_context
+@*/
+# endif
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+/*@noreturn@*/
+void
+e4c_exception_rethrow_foreign_(
+	/*@in@*/ /*@null@*/
+	const e4c_exception *		exception,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	environment_collection,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	current_context,
+	current_context->current_frame,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+E4C_NO_RETURN;
+/*@=redecl@*/
+
+/*@-redecl@*/
+/*@noreturn@*/
+void
+e4c_exception_throw_verbatim_(
+	/*@in@*/ /*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function,
+	/*@in@*/ /*@observer@*/ /*@temp@*/ /*@null@*/
+	const char *				message
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	environment_collection,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	current_context,
+	current_context->current_frame,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+E4C_NO_RETURN;
+/*@=redecl@*/
+
+/*@-redecl@*/
+/*@noreturn@*/
+void
+e4c_exception_throw_payload_(
+	/*@in@*/ /*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function,
+	/*@in@*/ /*@observer@*/ /*@temp@*/ /*@null@*/
+	const char *				message,
+	/*@in@*/ /*@temp@*/ /*@null@*/
+	const void *				payload,
+	size_t						payload_size
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	environment_collection,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	current_context,
+	current_context->current_frame,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+E4C_NO_RETURN;
+/*@=redecl@*/
+
+# if defined(HAVE_C99_VSNPRINTF) || defined(HAVE_VSNPRINTF)
+
+/*@-redecl@*/
+/*@noreturn@*/
+void
+e4c_exception_throw_format_(
+	/*@in@*/ /*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function,
+	/*@in@*/ /*@observer@*/ /*@temp@*/ /*@notnull@*/ /*@printflike@*/
+	const char *				format,
+	...
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	environment_collection,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ContextHasNotBegunYet,
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+
+	current_context,
+	current_context->current_frame,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+E4C_NO_RETURN;
+/*@=redecl@*/
+
+# endif
+
+static E4C_INLINE
+/*@out@*/
+e4c_exception *
+_e4c_exception_allocate(
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@notnull@*/
+	const char *				function
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+	internalState,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# else
+/*@globals
+	fileSystem,
+	internalState,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized
+@*/
+# endif
+;
+
+static E4C_INLINE
+void
+_e4c_exception_deallocate(
+	/*@only@*/ /*@null@*/
+	e4c_exception *				exception,
+	/*@in@*/ /*@null@*/
+	e4c_context *				context
+)
+/*@releases
+	exception
+@*/
+/*@modifies
+	exception
+@*/
+;
+
+static
+void
+_e4c_exception_limit_causes(
+	/*@in@*/ /*@notnull@*/
+	e4c_exception *				exception,
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	OmittedCausesException
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	exception->cause
+@*/
+;
+
+static
+void
+_e4c_exception_initialize_data(
+	/*@in@*/ /*@notnull@*/
+	e4c_exception *				exception,
+	/*@in@*/ /*@notnull@*/
+	e4c_context *				context
+)
+/*@modifies
+	exception->custom_data,
+	exception->_finalize,
+	context->type_handler_cache
+@*/
+;
+
+# ifdef REFERENCE_MUTEX
+static
+int
+_e4c_exception_add_reference(
+	/*@in@*/ /*@notnull@*/
+	e4c_exception *				exception,
+	int							delta
+)
+/*@globals
+	internalState,
+
+	reference_mutex
+@*/
+/*@modifies
+	internalState,
+
+	exception->ref_count
+@*/
+;
+# endif
+
+static E4C_INLINE
+void
+_e4c_exception_initialize(
+	/*@out@*/ /*@notnull@*/
+	e4c_exception *				exception,
+	/*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type,
+	E4C_BOOL					set_message,
+	/*@observer@*/ /*@temp@*/ /*@null@*/
+	const char *				message,
+	/*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@observer@*/ /*@null@*/
+	const char *				function,
+	int							error_number
+)
+/*@ensures isnull exception->cause@*/
+/*@modifies
+	exception
+@*/
+;
+
+static E4C_INLINE
+void
+_e4c_exception_set_cause(
+	/*@notnull@*/
+	e4c_exception *				exception,
+	/*@owned@*/ /*@notnull@*/
+	e4c_exception *				cause
+)
+/*@requires isnull exception->cause@*/
+/*@ensures notnull exception->cause@*/
+/*@modifies
+	cause,
+	exception
+@*/
+;
+
+static E4C_INLINE
+/*@only@*/ e4c_exception *
+_e4c_exception_throw(
+	/*@in@*/ /*@notnull@*/
+	e4c_frame *					frame,
+	/*@in@*/ /*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				function,
+	int							error_number,
+	E4C_BOOL					set_message,
+	/*@in@*/ /*@observer@*/ /*@temp@*/ /*@null@*/
+	const char *				message
+)
+# ifdef E4C_THREADSAFE
+/*@globals
+	fileSystem,
+	internalState,
+
+	environment_collection,
+	environment_collection_mutex,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+	is_initialized_mutex,
+
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	frame->thrown_exception
+@*/
+# else
+/*@globals
+	fileSystem,
+	internalState,
+
+	current_context,
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	ExceptionSystemFatalError,
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	fatal_error_flag,
+	is_finalized,
+	is_initialized,
+
+	frame->thrown_exception
+@*/
+# endif
+;
+
+static E4C_INLINE
+void
+_e4c_print_exception(
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
+)
+# ifdef NDEBUG
+/*@globals
+	fileSystem
+@*/
+#else
+/*@globals
+	fileSystem,
+
+	ExceptionSystemFatalError
+@*/
+# endif
+/*@modifies
+	fileSystem
+@*/
+;
+
+/*@-redecl@*/
+size_t
+e4c_format_exception(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception,
+	int							flags
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	buffer
+@*/
+;
+/*@=redecl@*/
+
+static
+size_t
+_e4c_format_exception(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception,
+	int							flags
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_format_exception_site(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
+)
+/*@modifies
+	buffer
+@*/
+;
+
+/*@-redecl@*/
+void
+e4c_print_exception_json(
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+/*@=redecl@*/
+
+/*@-redecl@*/
+void
+e4c_print_exception_binary(
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+/*@=redecl@*/
+
+static
+size_t
+_e4c_format_exception_json(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_format_exception_binary(
+	/*@out@*/ /*@notnull@*/
+	unsigned char *				buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_record_append(
+	/*@out@*/ /*@notnull@*/
+	unsigned char *				buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@notnull@*/
+	const unsigned char *		data,
+	size_t						count
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_record_append_number(
+	/*@out@*/ /*@notnull@*/
+	unsigned char *				buffer,
+	size_t						size,
+	size_t						length,
+	unsigned long				number,
+	int							bytes
+)
+/*@modifies
+	buffer
+@*/
+;
+
+static
+size_t
+_e4c_record_append_string(
+	/*@out@*/ /*@notnull@*/
+	unsigned char *				buffer,
+	size_t						size,
+	size_t						length,
+	/*@in@*/ /*@observer@*/ /*@null@*/
+	const char *				text
+)
+/*@modifies
+	buffer
+@*/
+;
+
+
+
+
+/* LIBRARY
+ ================================================================ */
+
+static void _e4c_library_initialize(void){
+
+	MUTEX_LOCK(is_initialized_mutex, "_e4c_library_initialize")
+
+		if(!is_initialized){
+
+			/* registers the function _e4c_library_finalize to be called when the program exits */
+			is_initialized	= ( atexit(_e4c_library_finalize) == 0 );
+			is_finalized	= !is_initialized;
+# ifdef E4C_THREADSAFE
+			/* creates the key that binds each thread to its own environment */
+			environment_key_created = ( pthread_key_create(&environment_key, ENVIRONMENT_DESTRUCTOR) == 0 );
+# endif
+		}
+
+	MUTEX_UNLOCK(is_initialized_mutex, "_e4c_library_initialize")
+}
+
+static void _e4c_library_finalize(void){
+
+	/* check flag to prevent from looping */
+	if(is_finalized){
+		return;
+	}
+
+	is_finalized = E4C_TRUE;
+
+# ifdef E4C_AUTO_CONTEXT
+	/* the key destructor does not run for the thread that calls exit */
+	if(environment_key_created){
+		_e4c_environment_destroy( pthread_getspecific(environment_key) );
+	}
+# endif
+
+	/* check for dangling context */
+	if(!fatal_error_flag && DANGLING_CONTEXT){
+
+		e4c_exception exception;
 
 		/* create temporary exception to be printed out */
 		_e4c_exception_initialize(&exception, &ContextNotEnded, E4C_TRUE, DESC_NOT_ENDED, E4C_INFO_FILE_, E4C_INFO_LINE_, "_e4c_library_finalize", errno);
-		_e4c_context_at_uncaught_exception(E4C_CONTEXT, &exception);
+		/* (a dangling boundary lives in a stack frame that has already returned) */
+		_e4c_context_at_uncaught_exception(OWNED_CONTEXT, &exception);
+
+		fatal_error_flag = E4C_TRUE;
+	}
+
+# ifndef NDEBUG
+	/* check for critical errors */
+	if(fatal_error_flag){
+		/* print fatal error message */
+		fprintf(stderr, MSG_AT_EXIT_ERROR);
+		(void)fflush(stderr);
+	}
+# endif
+
+}
+
+static void _e4c_library_handle_signal(int signal_number){
+
+	e4c_context *				context;
+	const e4c_signal_mapping *	mapping;
+	e4c_exception *				new_exception;
+	signal_handler				previous_handler;
+
+	context = E4C_CONTEXT;
+
+	/* check if `handleSignal` was called before `e4c_context_begin` or after `e4c_context_end` (very unlikely) */
+	PREVENT_PROC(context == NULL, DESC_INVALID_CONTEXT, "_e4c_library_handle_signal");
+
+	/* check if the current frame is NULL (very unlikely) */
+	PREVENT_PROC(context->current_frame == NULL, DESC_INVALID_FRAME, "_e4c_library_handle_signal");
+
+	/* check if the current frame is NULL (very unlikely) */
+	PREVENT_PROC(context->signal_mappings == NULL, DESC_INVALID_STATE, "_e4c_library_handle_signal");
+
+	/* try to find a mapping for this signal */
+	mapping = context->signal_mappings;
+
+	/* loop until we find the NULL terminator */
+	while(mapping->signal_number != E4C_INVALID_SIGNAL_NUMBER_){
+
+		if(signal_number == mapping->signal_number){
+
+			const char * signal_name;
+
+			switch(signal_number){
+				WHEN_SIGNAL(SIGABRT)
+				WHEN_SIGNAL(SIGFPE)
+				WHEN_SIGNAL(SIGILL)
+				WHEN_SIGNAL(SIGSEGV)
+				WHEN_SIGNAL(SIGTERM)
+				WHEN_SIGNAL(SIGINT)
+				WHEN_SIGNAL_SIGALRM
+				WHEN_SIGNAL_SIGCHLD
+				WHEN_SIGNAL_SIGTRAP
+				WHEN_SIGNAL_SIGPIPE
+				WHEN_SIGNAL_SIGSTOP
+				WHEN_SIGNAL_SIGKILL
+				WHEN_SIGNAL_SIGHUP
+				WHEN_SIGNAL_SIGXCPU
+				WHEN_SIGNAL_SIGQUIT
+				WHEN_SIGNAL_SIGBREAK
+				WHEN_SIGNAL_SIGUSR1
+				WHEN_SIGNAL_SIGUSR2
+				default:
+					signal_name = signal_name_UNKNOWN;
+					/*@switchbreak@*/ break;
+			}
+
+			/* check if we were supposed to ignore this signal (very unlikely) */
+			PREVENT_PROC(mapping->exception_type == NULL, DESC_INVALID_STATE, "_e4c_library_handle_signal");
+
+			/* reset the handler for this signal */
+			previous_handler = signal(signal_number, _e4c_library_handle_signal);
+			if(previous_handler == SIG_ERR){
+				/* we were unable to register the signal handling procedure again */
+				INTERNAL_ERROR(DESC_SIGERR_HANDLE, "_e4c_library_handle_signal");
+				E4C_UNREACHABLE_VOID_RETURN;
+			}
+
+			/* keep track of the exception */
+			_e4c_context_record(context, mapping->exception_type, signal_name, signal_number, "_e4c_library_handle_signal", errno);
+
+			/* check context and frame; initialize exception and cause */
+			new_exception = _e4c_exception_throw(context->current_frame, mapping->exception_type, signal_name, signal_number, "_e4c_library_handle_signal", errno, E4C_TRUE, NULL);
+
+			LIVE_EXCEPTION_CREATED(context, new_exception)
+
+			/* keep the chain of causes bounded */
+			_e4c_exception_limit_causes(new_exception, context);
+
+			PROBE_SIGNAL(context, new_exception, signal_name, signal_number);
+
+			/* set initial value for custom data */
+			new_exception->custom_data = context->custom_data;
+			/* initialize custom data */
+			_e4c_exception_initialize_data(new_exception, context);
+
+			/* propagate the exception up the call stack */
+			_e4c_context_dispatch(context, new_exception);
+		}
+
+		/* proceed to the next mapping */
+		mapping++;
+	}
+
+	/* this should never happen, but anyway... */
+	/* we were unable to find the exception that represents the received signal number */
+	INTERNAL_ERROR(DESC_NO_MAPPING, "_e4c_library_handle_signal");
+}
+
+static E4C_INLINE void _e4c_library_fatal_error(const e4c_exception_type * exception_type, const char * message, const char * file, int line, const char * function, int error_number){
+
+	e4c_exception exception;
+
+	_e4c_exception_initialize(&exception, exception_type, E4C_TRUE, message, file, line, function, error_number);
+
+	/* ensures library initialization so that _e4c_library_finalize will be called */
+	INITIALIZE_ONCE;
+
+	/* prints this specific exception */
+	_e4c_context_at_uncaught_exception(E4C_EXISTING_CONTEXT, &exception);
+
+	/* records critical error so that MSG_AT_EXIT_ERROR will be printed too */
+	fatal_error_flag = E4C_TRUE;
+
+	/*@-noeffectuncon@*/
+	STOP_EXECUTION;
+	/*@=noeffectuncon@*/
+}
+
+long e4c_library_version(void){
+
+	return( (long)E4C_VERSION_NUMBER );
+}
+
+# ifdef E4C_THREADSAFE
+
+/* ENVIRONMENT
+ ================================================================ */
+
+static E4C_INLINE e4c_environment * _e4c_environment_allocate(int line, const char * function){
+
+	e4c_environment * environment;
+
+	environment = malloc( sizeof(*environment) );
+
+	/* ensure that there was enough memory */
+	if(environment != NULL){
+
+		return(environment);
+	}
+
+	MEMORY_ERROR(DESC_MALLOC_CONTEXT, line, function);
+	E4C_UNREACHABLE_RETURN(NULL);
+}
+
+static E4C_INLINE void _e4c_environment_deallocate(e4c_environment * environment){
+
+	if(environment != NULL){
+
+		_e4c_frame_deallocate(environment->context.current_frame, &environment->context);
+		environment->context.current_frame = NULL;
+
+#	ifdef E4C_STATISTICS
+		/* keep the counters of this context */
+		_e4c_statistics_retire(&environment->context);
+#	endif
+
+		free(environment);
+	}
+}
+
+static void _e4c_environment_initialize(e4c_environment * environment, e4c_uncaught_handler uncaught_handler){
+
+	/* assert: environment != NULL */
+
+	/* bound the new environment to the current thread */
+	environment->self = THREAD_CURRENT;
+
+	_e4c_context_initialize(&environment->context, uncaught_handler, _e4c_frame_allocate(__LINE__, "_e4c_environment_initialize") );
+}
+
+static E4C_INLINE void _e4c_environment_add(e4c_environment * environment){
+
+	/* assert: environment != NULL */
+
+	MUTEX_LOCK(environment_collection_mutex, "_e4c_environment_add")
+
+		environment->next				= environment_collection.first;
+		environment_collection.first	= environment;
+
+	MUTEX_UNLOCK(environment_collection_mutex, "_e4c_environment_add")
+
+	/* bind the new environment to the current thread */
+	BIND_CONTEXT(&environment->context, "_e4c_environment_add")
+}
+
+static e4c_environment * _e4c_environment_remove(const e4c_context * context){
+
+	e4c_environment *	previous	= NULL;
+	e4c_environment *	current;
+	e4c_environment *	found		= NULL;
+
+	MUTEX_LOCK(environment_collection_mutex, "_e4c_environment_remove")
+
+		FOREACH(current, environment_collection){
+
+			if(&current->context == context){
+				if(previous == NULL){
+					found							= environment_collection.first /* (equals current) */;
+					environment_collection.first	= current->next;
+				}else{
+					found							= previous->next  /* (equals current) */;
+					previous->next					= current->next;
+				}
+				current->next = NULL;
+				break;
+			}
+
+			/* keep track of the previous environment */
+			previous = current;
+		}
+
+	MUTEX_UNLOCK(environment_collection_mutex, "_e4c_environment_remove")
+
+	/* unbind the environment from the current thread */
+	(void)pthread_setspecific(environment_key, NULL);
+
+	return(found);
+}
+
+static E4C_BOOL _e4c_environment_contains(const e4c_context * context){
+
+	e4c_environment *	current;
+
+	/* (only pointers are compared, so the context itself is never accessed) */
+
+	MUTEX_LOCK(environment_collection_mutex, "_e4c_environment_contains")
+
+		FOREACH(current, environment_collection){
+
+			if(&current->context == context){
+				break;
+			}
+		}
+
+	MUTEX_UNLOCK(environment_collection_mutex, "_e4c_environment_contains")
+
+	return(current != NULL);
+}
+
+#	ifdef E4C_AUTO_CONTEXT
+
+static void _e4c_environment_destroy(void * context){
+
+	e4c_environment * environment;
+
+	/* (this is the destructor of the key, called when the thread exits) */
+	environment = _e4c_environment_remove( (e4c_context *)context );
+
+	/* a dangling boundary is not in the collection (and cannot be accessed) */
+	if(environment != NULL){
+
+		/* reset all signal handlers */
+		_e4c_context_set_signal_handlers(&environment->context, NULL);
+
+		/* deallocate the thread environment */
+		_e4c_environment_deallocate(environment);
+	}
+}
+
+#	endif
+
+# endif
+
+/* CONTEXT
+ ================================================================ */
+
+static E4C_INLINE void _e4c_context_initialize(e4c_context * context, e4c_uncaught_handler uncaught_handler, e4c_frame * top_frame){
+
+	context->uncaught_handler	= uncaught_handler;
+	context->signal_mappings	= NULL;
+	context->custom_data		= NULL;
+	context->initialize_handler	= NULL;
+	context->finalize_handler	= NULL;
+	context->borrowed			= E4C_FALSE;
+	context->flight_records		= NULL;
+	context->flight_capacity	= 0;
+	context->flight_count		= 0UL;
+	context->event_handler		= NULL;
+	context->event_data			= NULL;
+	context->type_handlers		= NULL;
+# ifdef E4C_STATISTICS
+	context->statistics			= NULL;
+	context->latencies			= NULL;
+	context->live_frames		= 0L;
+	context->live_exceptions	= 0L;
+# endif
+	context->current_frame		= top_frame;
+
+	_e4c_context_clear_type_handlers(context);
+
+	_e4c_frame_initialize(context->current_frame, NULL, e4c_done_);
+}
+
+static E4C_INLINE void _e4c_context_record(e4c_context * context, const e4c_exception_type * exception_type, const char * file, int line, const char * function, int error_number){
+
+	e4c_flight_record *	record;
+	unsigned long		count;
+# ifdef RECORD_NANOSECONDS
+	struct timespec		now;
+# endif
+
+	STATISTICS_COUNT(context, exception_type, file, line, thrown);
+
+	if(context->flight_records == NULL){
+		return;
+	}
+
+	count = context->flight_count;
+
+	/* (only the owner thread writes, so the oldest record is simply overwritten) */
+	record = &context->flight_records[count % (unsigned long)context->flight_capacity];
+
+	/* other threads will skip the record until it is published again */
+	record->sequence		= 0UL;
+
+	RECORD_FENCE
+
+# ifdef RECORD_NANOSECONDS
+	if(clock_gettime(CLOCK_REALTIME, &now) == 0){
+		record->seconds		= (long)now.tv_sec;
+		record->nanoseconds	= (long)now.tv_nsec;
+	}else{
+		record->seconds		= 0L;
+		record->nanoseconds	= 0L;
+	}
+# else
+	record->seconds			= (long)time(NULL);
+	record->nanoseconds		= 0L;
+# endif
+
+	/* (a NULL exception type will be converted to NPE) */
+	record->type			= (exception_type != NULL ? exception_type : &NullPointerException);
+	record->file			= file;
+	record->line			= line;
+	record->function		= function;
+	record->error_number	= error_number;
+
+	RECORD_PUBLISH(record, count + 1UL)
+
+	context->flight_count	= count + 1UL;
+}
+
+static void _e4c_context_notify(const e4c_context * context, e4c_event event, const e4c_exception * exception, const char * file, int line, const char * function){
+
+	e4c_event_info		info;
+
+	/* assert: context->event_handler != NULL */
+
+	_e4c_context_monotonic_time(&info.seconds, &info.nanoseconds);
+
+	info.depth				= _e4c_context_depth(context);
+	info.exception			= exception;
+	info.file				= file;
+	info.line				= line;
+	info.function			= function;
+	info.data				= context->event_data;
+
+	context->event_handler(event, &info);
+}
+
+static void _e4c_context_monotonic_time(long * seconds, long * nanoseconds){
+
+# ifdef RECORD_NANOSECONDS
+
+	struct timespec now;
+
+#	ifdef CLOCK_MONOTONIC
+	if(clock_gettime(CLOCK_MONOTONIC, &now) == 0){
+#	else
+	if(clock_gettime(CLOCK_REALTIME, &now) == 0){
+#	endif
+		*seconds		= (long)now.tv_sec;
+		*nanoseconds	= (long)now.tv_nsec;
+	}else{
+		*seconds		= 0L;
+		*nanoseconds	= 0L;
+	}
+
+# else
+
+	*seconds		= (long)time(NULL);
+	*nanoseconds	= 0L;
+
+# endif
+}
+
+static int _e4c_context_depth(const e4c_context * context){
+
+	const e4c_frame *	frame;
+	int					depth = 0;
+
+	/* (the top frame does not count) */
+	for(frame = context->current_frame; frame != NULL && frame->previous != NULL; frame = frame->previous){
+		depth++;
+	}
+
+	return(depth);
+}
+
+static void _e4c_context_dispatch(e4c_context * context, e4c_exception * exception){
+
+	/* assert: exception != NULL */
+	/* assert: context != NULL */
+	/* assert: context->current_frame != NULL */
+
+# ifdef E4C_FAST_FAIL
+	e4c_frame * frame;
+# endif
+
+	NOTIFY_EVENT(context, e4c_event_throw, exception, exception->file, exception->line, exception->function);
+
+# ifdef E4C_FAST_FAIL
+
+	/* search phase: find out if some frame will catch the exception before unwinding */
+	if(_e4c_context_find_handler(context, exception) == NULL){
+
+		frame = context->current_frame;
+
+		/* update the frame with the exception information */
+		frame->uncaught = E4C_TRUE;
+		_e4c_exception_deallocate(frame->thrown_exception, context);
+		frame->thrown_exception = exception;
+
+		/* report the uncaught exception while the frame chain is still intact */
+		_e4c_context_at_uncaught_exception(context, exception);
+
+		/* move the exception to the top frame, discarding the rest without running them */
+		frame->thrown_exception = NULL;
+		_e4c_context_unwind(context, NULL);
+
+		frame = context->current_frame;
+		_e4c_exception_deallocate(frame->thrown_exception, context);
+		frame->thrown_exception = exception;
+
+		e4c_context_end();
+
+		/*@-noeffectuncon@*/
+		STOP_EXECUTION;
+		/*@=noeffectuncon@*/
+	}
+
+# endif
+
+	/* unwinding phase */
+	_e4c_context_propagate(context, exception, E4C_FALSE);
+}
+
+# ifdef E4C_FAST_FAIL
+
+static e4c_frame * _e4c_context_find_handler(const e4c_context * context, const e4c_exception * exception){
+
+	/* assert: exception != NULL */
+	/* assert: context != NULL */
+
+	e4c_frame * frame;
+
+	for(frame = context->current_frame; frame != NULL; frame = frame->previous){
+
+		/* a boundary will convert the exception into a status value */
+		if( IS_TOP_FRAME(frame) ){
+			return( context->borrowed && IS_CONVERTIBLE(exception) ? frame : NULL );
+		}
+
+		if( _e4c_frame_catches(frame, exception->type) ){
+			return(frame);
+		}
+	}
+
+	return(NULL);
+}
+
+# endif
+
+static e4c_frame * _e4c_context_find_collector(const e4c_context * context, const e4c_exception_type * exception_type){
+
+	/* assert: context != NULL */
+
+	e4c_frame * frame;
+
+	if( IS_UNCATCHABLE_TYPE(exception_type) ){
+		return(NULL);
+	}
+
+# ifdef E4C_FAST_FAIL
+
+	/* look for a batch that can be reached without running any code */
+	for(frame = context->current_frame; frame != NULL && !IS_TOP_FRAME(frame); frame = frame->previous){
+
+		if(frame->batch != NULL && frame->stage < e4c_catching_){
+			return(frame);
+		}
+
+		if( !_e4c_frame_is_transparent(frame, exception_type) ){
+			return(NULL);
+		}
+	}
+
+	return(NULL);
+
+# else
+
+	/* (the frames in between are not known to have nothing to do) */
+	frame = context->current_frame;
+
+	return( frame->batch != NULL && frame->stage < e4c_catching_ ? frame : NULL );
+
+# endif
+}
+
+static const e4c_type_handler * _e4c_context_find_type_handler(e4c_context * context, const e4c_exception_type * exception_type){
+
+	/* assert: context != NULL */
+	/* assert: context->type_handlers != NULL */
+	/* assert: exception_type != NULL */
+
+	struct e4c_type_handler_cache_ *	cached;
+	const e4c_exception_type *			type;
+	const e4c_type_handler *			type_handler;
+
+	cached = &context->type_handler_cache[ ( (size_t)exception_type / sizeof(*exception_type) ) % (size_t)E4C_TYPE_HANDLER_CACHE_SIZE ];
+
+	if(cached->exception_type == exception_type){
+		return(cached->type_handler);
+	}
+
+	/* look for the handler of the type, or else of its closest supertype */
+	for(type = exception_type; type != NULL; type = (type->supertype == type ? NULL : type->supertype) ){
+
+		for(type_handler = context->type_handlers; type_handler->exception_type != NULL; type_handler++){
+
+			if(type_handler->exception_type == type){
+
+				cached->exception_type	= exception_type;
+				cached->type_handler	= type_handler;
+
+				return(type_handler);
+			}
+		}
+	}
+
+	/* (remember that there is none either) */
+	cached->exception_type	= exception_type;
+	cached->type_handler	= NULL;
+
+	return(NULL);
+}
+
+static void _e4c_context_clear_type_handlers(e4c_context * context){
+
+	int index;
+
+	for(index = 0; index < E4C_TYPE_HANDLER_CACHE_SIZE; index++){
+		context->type_handler_cache[index].exception_type	= NULL;
+		context->type_handler_cache[index].type_handler		= NULL;
+	}
+}
+
+static void _e4c_context_collect(e4c_context * context, e4c_frame * frame){
+
+	/* assert: context != NULL */
+	/* assert: frame != NULL */
+
+	/* the frames in between had nothing to do */
+	_e4c_context_unwind(context, frame);
+
+	/* the failure was already recorded; jump to the end of the current iteration */
+	frame->stage = e4c_catching_;
+
+	E4C_CONTINUE(frame->continuation);
+}
+
+static void _e4c_context_unwind(e4c_context * context, const e4c_frame * target){
+
+	/* assert: context != NULL */
+	/* assert: context->current_frame != NULL */
+
+	e4c_frame * frame;
+
+	/* (a NULL target stands for the top frame) */
+
+	frame = context->current_frame;
+
+	while( frame != target && !IS_TOP_FRAME(frame) ){
+
+		NOTIFY_EVENT(context, e4c_event_exit, NULL, NULL, 0, NULL);
+
+# ifdef E4C_STATISTICS
+		/* (a discarded block is measured as failed) */
+		_e4c_latency_record(context, frame, e4c_failed);
+# endif
+
+		/* promote the previous frame to the current one */
+		context->current_frame = frame->previous;
+
+		/* delete the discarded frame (along with its exception) */
+		frame->previous = NULL;
+		_e4c_frame_deallocate(frame, context);
+
+		frame = context->current_frame;
+	}
+}
+
+static void _e4c_context_propagate(e4c_context * context, e4c_exception * exception, E4C_BOOL leaving){
+
+	/* assert: exception != NULL */
+	/* assert: context != NULL */
+	/* assert: context->current_frame != NULL */
+
+	e4c_frame * frame;
+
+	/* the exception has just left a block (rather than being thrown) */
+	if(leaving){
+		NOTIFY_EVENT(context, e4c_event_propagate, exception, NULL, 0, NULL);
+		PROBE_EXCEPTION(propagate, context, exception, exception->file, exception->line);
+	}
+
+	frame = context->current_frame;
+
+# ifdef E4C_FAST_FAIL
+	/* skip the frames that have no work to do (without jumping into each of them) */
+	/* (default builds do not register the catch blocks, so they cannot tell which frames to skip) */
+	while( !IS_TOP_FRAME(frame) && _e4c_frame_is_transparent(frame, exception->type) ){
+
+		_e4c_context_unwind(context, frame->previous);
+
+		/* (every block left is notified, just as if it had been run) */
+		NOTIFY_EVENT(context, e4c_event_propagate, exception, NULL, 0, NULL);
+		PROBE_EXCEPTION(propagate, context, exception, exception->file, exception->line);
+
+		frame = context->current_frame;
+	}
+# endif
+
+	/* update the frame with the exception information */
+	frame->uncaught			= E4C_TRUE;
+
+	/* deallocate previously thrown exception */
+	_e4c_exception_deallocate(frame->thrown_exception, context);
+
+	/* update current thrown exception */
+	frame->thrown_exception	= exception;
+
+	/* if this is the upper frame, then this is an uncaught exception */
+	if( IS_TOP_FRAME(frame) ){
+
+		/* unless it reached a boundary, which will convert it into a status value */
+		if( context->borrowed && IS_CONVERTIBLE(exception) && frame->stage == e4c_done_ ){
+			/* (an exception thrown while converting will not be converted again) */
+			frame->stage = e4c_catching_;
+			E4C_CONTINUE(frame->continuation);
+		}
+
+		_e4c_context_at_uncaught_exception(context, exception);
+
+		e4c_context_end();
+
+		/*@-noeffectuncon@*/
+		STOP_EXECUTION;
+		/*@=noeffectuncon@*/
+	}
+
+	/* otherwise, we will jump to the upper frame */
+
+	/* simple optimization */
+	if(frame->stage == e4c_acquiring_){
+		/* if we are in the middle of an acquisition, we don't need to dispose the resource */
+		frame->stage = e4c_disposing_;
+		/* (that actually jumps over the "disposing" stage) */
+	}
+
+	/* keep looping */
+	E4C_CONTINUE(frame->continuation);
+}
+
+# ifdef E4C_THREADSAFE
+
+static E4C_INLINE e4c_context * _e4c_context_get_current(void){
+
+	e4c_context * context = _e4c_context_get_existing();
+
+#	ifdef E4C_AUTO_CONTEXT
+	/* begin the exception context of this thread lazily */
+	if(context == NULL){
+		e4c_context_begin(E4C_FALSE);
+		context = _e4c_context_get_existing();
+	}
+#	endif
+
+	return(context);
+}
+
+static E4C_INLINE e4c_context * _e4c_context_get_existing(void){
+
+	/* the key will not exist until the library is initialized */
+	if(!environment_key_created){
+		return(NULL);
+	}
+
+	/* there is no need to walk the collection (nor lock the mutex) */
+	return( (e4c_context *)pthread_getspecific(environment_key) );
+}
+
+/* e4c_context_begin (multi-thread) */
+void e4c_context_begin(E4C_BOOL handle_signals){
+
+	e4c_context *		context;
+	e4c_environment *	environment;
+
+	INITIALIZE_ONCE;
+
+	/* check if the key could not be created (very unlikely) */
+	if(!environment_key_created){
+		INTERNAL_ERROR(DESC_KEY_ERROR, "e4c_context_begin");
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	/* get the current context */
+	context = _e4c_context_get_existing();
+
+	/* check if e4c_context_begin was called twice for this thread */
+	if(context != NULL){
+
+		/* adopt the context that was begun automatically for this thread */
+		if(ADOPT_CONTEXT){
+			if(handle_signals){
+				_e4c_context_set_signal_handlers(context, e4c_default_signal_mappings);
+			}
+			return;
+		}
+
+		MISUSE_ERROR(ContextAlreadyBegun, "e4c_context_begin: " DESC_ALREADY_BEGUN, NULL, 0, NULL);
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	/* allocate memory for the new environment */
+	environment	= _e4c_environment_allocate(__LINE__, "e4c_context_begin");
+
+	/* initialize the new environment, register uncaught handler */
+	_e4c_environment_initialize(environment, e4c_print_exception);
+
+	/* add the new environment to the collection */
+	_e4c_environment_add(environment);
+
+	if(handle_signals){
+		_e4c_context_set_signal_handlers(&environment->context, e4c_default_signal_mappings);
+	}
+}
+
+/* e4c_context_end (multi-thread) */
+void e4c_context_end(void){
+
+	e4c_context *		context;
+	e4c_frame *			frame;
+
+	/* get the current context */
+	context = _e4c_context_get_existing();
+
+	/* check if `e4c_context_end` was called before calling `e4c_context_begin` */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_end: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	/* get the current frame */
+	frame = context->current_frame;
+
+	/* check if there are no frames left (unlikely) */
+	PREVENT_PROC(frame == NULL, DESC_NO_FRAMES_LEFT, "e4c_context_end");
+
+	/* check if there are too many frames left (breaking out of a try block) */
+	if( !IS_TOP_FRAME(frame) ){
+		INTERNAL_ERROR(DESC_TOO_MANY_FRAMES, "e4c_context_end");
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	/* reset all signal handlers */
+	_e4c_context_set_signal_handlers(context, NULL);
+
+	if(context->borrowed){
+
+		/* the top frame of a boundary lives in the stack, so only its exception is deallocated */
+		_e4c_exception_deallocate(frame->thrown_exception, context);
+		frame->thrown_exception = NULL;
+
+#	ifdef E4C_STATISTICS
+		/* keep the counters of this context */
+		_e4c_statistics_retire(context);
+#	endif
+
+		/* deactivate the top frame (for sanity) */
+		context->current_frame = NULL;
+
+		/* unbind the boundary from the current thread */
+		(void)pthread_setspecific(environment_key, NULL);
+
+	}else{
+
+		/* remove the current environment from the collection and deallocate it */
+		_e4c_environment_deallocate( _e4c_environment_remove(context) );
+	}
+}
+
+# else
+
+/* e4c_context_begin (single-thread) */
+void e4c_context_begin(E4C_BOOL handle_signals){
+
+	INITIALIZE_ONCE;
+
+	/* check if e4c_context_begin was called twice for this program */
+	/* this can also happen when the program uses threads but E4C_THREADSAFE is not defined */
+	if(current_context != NULL){
+		MISUSE_ERROR(ContextAlreadyBegun, "e4c_context_begin: " DESC_ALREADY_BEGUN, NULL, 0, NULL);
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	/* check if the current frame is NOT NULL (unlikely) */
+	PREVENT_PROC(main_context.current_frame != NULL, DESC_INVALID_STATE, "e4c_context_begin");
+
+	/* initialize context, register uncaught handler */
+	_e4c_context_initialize(&main_context, e4c_print_exception, _e4c_frame_allocate(__LINE__, "e4c_context_begin") );
+
+	if(handle_signals){
+		_e4c_context_set_signal_handlers(&main_context, e4c_default_signal_mappings);
+	}
+
+	/* update global variable */
+	current_context	= &main_context;
+}
+
+/* e4c_context_end (single-thread) */
+void e4c_context_end(void){
+
+	e4c_context *		context;
+	e4c_frame *			frame;
+
+	/* get the current context */
+	context = current_context;
+
+	/* ensure that `e4c_context_end` was called after calling `e4c_context_begin` */
+	if(context != NULL){
+
+		/* get the current frame */
+		frame = context->current_frame;
+
+		/* check if there are no frames left (unlikely) */
+		PREVENT_PROC(frame == NULL, DESC_NO_FRAMES_LEFT, "e4c_context_end");
+
+		/* check if there are too many frames left (breaking out of a try block) */
+		if( !IS_TOP_FRAME(frame) ){
+			INTERNAL_ERROR(DESC_TOO_MANY_FRAMES, "e4c_context_end");
+			E4C_UNREACHABLE_VOID_RETURN;
+		}
+
+		/* reset all signal handlers */
+		_e4c_context_set_signal_handlers(context, NULL);
+
+		if(context->borrowed){
+
+			/* the top frame of a boundary lives in the stack, so only its exception is deallocated */
+			_e4c_exception_deallocate(frame->thrown_exception, context);
+			frame->thrown_exception = NULL;
+
+		}else{
+
+			/* deallocate the current, top frame */
+			_e4c_frame_deallocate(frame, context);
+		}
+
+#	ifdef E4C_STATISTICS
+		/* keep the counters of this context */
+		_e4c_statistics_retire(context);
+#	endif
+
+		/* deactivate the top frame (for sanity) */
+		current_context->current_frame = NULL;
+
+		/* deactivate the current context */
+		current_context = NULL;
+
+	}else{
+
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_end: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+	}
+}
+
+# endif
+
+static void _e4c_context_set_signal_handlers(e4c_context * context, const e4c_signal_mapping * mappings){
+
+	/* assert: context != NULL */
+
+	const e4c_signal_mapping *	next_mapping;
+	signal_handler				previous_handler;
+
+	if(context->signal_mappings != NULL){
+		next_mapping = context->signal_mappings;
+		/* reset all the previously set signal handlers */
+		while(next_mapping->signal_number != E4C_INVALID_SIGNAL_NUMBER_){
+			previous_handler = signal(next_mapping->signal_number, SIG_DFL);
+			if(previous_handler == SIG_ERR){
+				/* we were unable to reset to the default action */
+				INTERNAL_ERROR(DESC_SIGERR_DEFAULT, "e4c_set_signal_handlers");
+				E4C_UNREACHABLE_VOID_RETURN;
+			}
+			next_mapping++;
+		}
+	}
+
+	if(mappings == NULL){
+		/* disable signal handling */
+		context->signal_mappings = NULL;
+		return;
+	}
+
+	/* set up signal mapping */
+	context->signal_mappings = next_mapping = mappings;
+
+	while(next_mapping->signal_number != E4C_INVALID_SIGNAL_NUMBER_){
+
+		signal_handler	handler;
+		const char *	error_message;
+
+		if(next_mapping->exception_type != NULL){
+			/* map this signal to this exception */
+			handler			= _e4c_library_handle_signal;
+			error_message	= DESC_SIGERR_HANDLE;
+		}else{
+			/* ignore this signal */
+			handler			= SIG_IGN;
+			error_message	= DESC_SIGERR_IGNORE;
+		}
+
+		previous_handler = signal(next_mapping->signal_number, handler);
+		if(previous_handler == SIG_ERR){
+			INTERNAL_ERROR(error_message, "e4c_set_signal_handlers");
+			E4C_UNREACHABLE_VOID_RETURN;
+		}
+
+		next_mapping++;
+	}
+}
+
+static void _e4c_context_at_uncaught_exception(e4c_context * context, const e4c_exception * exception){
+
+	/* assert: exception != NULL */
+
+	if(context == NULL){
+
+		/* fatal error (likely library misuse) */
+		_e4c_print_exception(exception);
+
+	}else{
+
+		e4c_uncaught_handler handler;
+
+		STATISTICS_COUNT(context, exception->type, exception->file, exception->line, uncaught);
+
+		handler = context->uncaught_handler;
+
+		if(handler != NULL){
+			/* TODO: find the proper way to make Splint happy */
+			/*@-noeffectuncon@*/
+			handler(exception);
+			/*@=noeffectuncon@*/
+		}
+
+		/* tell what happened before the exception was uncaught */
+		if(context->flight_records != NULL){
+			_e4c_context_print_records(context);
+		}
+	}
+}
+
+void e4c_context_set_handlers(e4c_uncaught_handler uncaught_handler, void * custom_data, e4c_initialize_handler initialize_handler, e4c_finalize_handler finalize_handler){
+
+	e4c_context * context;
+
+	context = E4C_CONTEXT;
+
+	/* ensure that `e4c_context_set_handlers` was called after calling `e4c_context_begin` */
+	if(context != NULL){
+
+		context->uncaught_handler	= uncaught_handler;
+		context->custom_data		= custom_data;
+		context->initialize_handler	= initialize_handler;
+		context->finalize_handler	= finalize_handler;
+
+	}else{
+
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_set_handlers: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+	}
+}
+
+void e4c_context_set_flight_recorder(e4c_flight_record * records, int capacity){
+
+	e4c_context *	context;
+	int				index;
+
+	context = E4C_CONTEXT;
+
+	/* check if `e4c_context_set_flight_recorder` was called before calling `e4c_context_begin` */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_set_flight_recorder: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	if(records == NULL || capacity <= 0){
+		/* disable the flight recorder */
+		context->flight_records		= NULL;
+		context->flight_capacity	= 0;
+	}else{
+		/* (the records of a previous use of the array are not valid anymore) */
+		for(index = 0; index < capacity; index++){
+			records[index].sequence = 0UL;
+		}
+		context->flight_records		= records;
+		context->flight_capacity	= capacity;
+	}
+
+	context->flight_count = 0UL;
+}
+
+void e4c_context_set_type_handlers(const e4c_type_handler * type_handlers){
+
+	e4c_context * context;
+
+	context = E4C_CONTEXT;
+
+	/* check if `e4c_context_set_type_handlers` was called before calling `e4c_context_begin` */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_set_type_handlers: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	context->type_handlers = type_handlers;
+
+	/* the handlers will be resolved again */
+	_e4c_context_clear_type_handlers(context);
+}
+
+void e4c_context_set_event_handler(e4c_event_handler handler, void * data){
+
+	e4c_context * context;
+
+	context = E4C_CONTEXT;
+
+	/* check if `e4c_context_set_event_handler` was called before calling `e4c_context_begin` */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_set_event_handler: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	context->event_handler	= handler;
+	context->event_data		= data;
+}
+
+void e4c_print_flight_recorders(void){
+
+# ifdef E4C_THREADSAFE
+
+	e4c_environment *	environment;
+	e4c_context *		context;
+
+	MUTEX_LOCK(environment_collection_mutex, "e4c_print_flight_recorders")
+
+		FOREACH(environment, environment_collection){
+
+			if(environment->context.flight_records != NULL){
+				_e4c_context_print_records(&environment->context);
+			}
+		}
+
+	MUTEX_UNLOCK(environment_collection_mutex, "e4c_print_flight_recorders")
+
+	/* the boundary of the current thread is not in the collection */
+	context = E4C_EXISTING_CONTEXT;
+
+	if(context != NULL && context->borrowed && context->flight_records != NULL){
+		_e4c_context_print_records(context);
+	}
+
+# else
+
+	if(current_context != NULL && current_context->flight_records != NULL){
+		_e4c_context_print_records(current_context);
+	}
+
+# endif
+}
+
+static void _e4c_context_print_records(const e4c_context * context){
+
+	char						buffer[E4C_PRINT_BUFFER_SIZE];
+	size_t						length;
+	size_t						checkpoint;
+	unsigned long				count;
+	unsigned long				sequence;
+	unsigned long				stamp;
+	const e4c_flight_record *	slot;
+	const e4c_flight_record *	record;
+	e4c_flight_record			snapshot;
 
-		fatal_error_flag = E4C_TRUE;
+	/* assert: context->flight_records != NULL */
+
+	count		= context->flight_count;
+	sequence	= ( count > (unsigned long)context->flight_capacity ? count - (unsigned long)context->flight_capacity : 0UL );
+
+	MEMORY_BARRIER("_e4c_context_print_records")
+
+	length = _e4c_text_append(buffer, sizeof(buffer), 0, "\nFlight recorder: ");
+	length = _e4c_text_append_unsigned(buffer, sizeof(buffer), length, count, 1);
+	length = _e4c_text_append(buffer, sizeof(buffer), length, (count == 1UL ? " exception thrown.\n" : " exceptions thrown.\n") );
+
+	/* from the oldest to the most recent record */
+	while(sequence < count){
+
+		slot = &context->flight_records[sequence % (unsigned long)context->flight_capacity];
+		sequence++;
+
+		/* take a snapshot, in case the owner thread is writing the record */
+		stamp		= slot->sequence;
+		MEMORY_BARRIER("_e4c_context_print_records")
+		snapshot	= *slot;
+		MEMORY_BARRIER("_e4c_context_print_records")
+
+		/* skip the record if it is incomplete, or if it was overwritten meanwhile */
+		if(stamp != sequence || slot->sequence != stamp){
+			continue;
+		}
+
+		record = &snapshot;
+
+		do{
+			checkpoint = length;
+
+			length = _e4c_text_append(buffer, sizeof(buffer), length, "    #");
+			length = _e4c_text_append_unsigned(buffer, sizeof(buffer), length, sequence, 1);
+			length = _e4c_text_append(buffer, sizeof(buffer), length, " ");
+			length = _e4c_text_append_unsigned(buffer, sizeof(buffer), length, (unsigned long)record->seconds, 1);
+			length = _e4c_text_append(buffer, sizeof(buffer), length, ".");
+			length = _e4c_text_append_unsigned(buffer, sizeof(buffer), length, (unsigned long)record->nanoseconds, 9);
+			length = _e4c_text_append(buffer, sizeof(buffer), length, " ");
+			length = _e4c_text_append(buffer, sizeof(buffer), length, (record->type != NULL ? record->type->name : NULL) );
+			length = _e4c_text_append(buffer, sizeof(buffer), length, " at ");
+			if(record->function != NULL){
+				length = _e4c_text_append(buffer, sizeof(buffer), length, record->function);
+				length = _e4c_text_append(buffer, sizeof(buffer), length, " (");
+			}
+			length = _e4c_text_append(buffer, sizeof(buffer), length, record->file);
+			length = _e4c_text_append(buffer, sizeof(buffer), length, ":");
+			length = _e4c_text_append_number(buffer, sizeof(buffer), length, record->line);
+			length = _e4c_text_append(buffer, sizeof(buffer), length, (record->function != NULL ? ") errno " : " errno ") );
+			length = _e4c_text_append_number(buffer, sizeof(buffer), length, record->error_number);
+			length = _e4c_text_append(buffer, sizeof(buffer), length, "\n");
+
+			/* flush the buffer when the record does not fit (unless it is empty) */
+			if(length + 1 < sizeof(buffer) || checkpoint == 0){
+				break;
+			}
+
+			_e4c_text_write(buffer, checkpoint);
+			length = 0;
+
+		}while(E4C_TRUE);
 	}
 
-# ifndef NDEBUG
-	/* check for critical errors */
-	if(fatal_error_flag){
-		/* print fatal error message */
-		fprintf(stderr, MSG_AT_EXIT_ERROR);
-		(void)fflush(stderr);
+	_e4c_text_write(buffer, length);
+}
+
+void e4c_context_set_signal_mappings(const e4c_signal_mapping * mappings){
+
+	e4c_context * context;
+
+	context = E4C_CONTEXT;
+
+	/* check if `e4c_context_set_signal_mappings` was called before calling `e4c_context_begin` */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_set_signal_mappings: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	_e4c_context_set_signal_handlers(context, mappings);
+}
+
+const e4c_signal_mapping * e4c_context_get_signal_mappings(void){
+
+	e4c_context * context;
+
+	context = E4C_CONTEXT;
+
+	/* ensure that `e4c_context_get_signal_mappings` was called after calling `e4c_context_begin` */
+	if(context != NULL){
+
+		return(context->signal_mappings);
+	}
+
+	MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_get_signal_mappings: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+	E4C_UNREACHABLE_RETURN(NULL);
+}
+
+E4C_BOOL e4c_context_is_ready(void){
+
+	return(E4C_EXISTING_CONTEXT != NULL);
+}
+
+/* BOUNDARY
+ ================================================================ */
+
+E4C_BOOL e4c_boundary_borrow_(e4c_boundary * boundary){
+
+	e4c_context * context = E4C_EXISTING_CONTEXT;
+
+	/*
+	 * A live boundary cannot be at the same address as the one about to be
+	 * begun (which is not initialized yet; only its address is compared), so
+	 * the current one was left behind and its memory is stale.
+	 */
+	if(context == &boundary->context){
+		BIND_CONTEXT(NULL, "e4c_boundary_borrow_")
+		MISUSE_ERROR(ContextNotEnded, "e4c_reusing_context: " DESC_BOUNDARY_NOT_ENDED, NULL, 0, NULL);
+		E4C_UNREACHABLE_RETURN(E4C_FALSE);
+	}
+
+	return(context == NULL);
+}
+
+e4c_continuation * e4c_boundary_begin_(e4c_boundary * boundary){
+
+	INITIALIZE_ONCE;
+
+# ifdef E4C_THREADSAFE
+	/* check if the key could not be created (very unlikely) */
+	if(!environment_key_created){
+		INTERNAL_ERROR(DESC_KEY_ERROR, "e4c_boundary_begin_");
+		E4C_UNREACHABLE_RETURN(NULL);
 	}
 # endif
 
+	/* the top frame is borrowed from the caller's stack too */
+	_e4c_frame_initialize(&boundary->frame, NULL, e4c_done_);
+
+	/* initialize context, register uncaught handler */
+	_e4c_context_initialize(&boundary->context, e4c_print_exception, &boundary->frame);
+
+	/* an uncaught exception will jump back to the boundary instead of terminating */
+	boundary->context.borrowed = E4C_TRUE;
+
+	/* there is no need to allocate (nor register) an environment */
+	BIND_CONTEXT(&boundary->context, "e4c_boundary_begin_")
+
+	return( &(boundary->frame.continuation) );
 }
 
-static void _e4c_library_handle_signal(int signal_number){
+void e4c_boundary_end_(e4c_boundary * boundary){
 
-	e4c_context *				context;
-	const e4c_signal_mapping *	mapping;
-	e4c_exception *				new_exception;
-	signal_handler				previous_handler;
+	/* check if the boundary was ended prematurely (by calling `e4c_context_end`) */
+	if(E4C_EXISTING_CONTEXT != &boundary->context){
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_reusing_context: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	e4c_context_end();
+}
+
+/* FRAME
+ ================================================================ */
+
+e4c_continuation * e4c_frame_first_stage_(e4c_frame_stage stage, const char * file, int line, const char * function){
+
+	e4c_context *	context;
+	e4c_frame *		current_frame;
+	e4c_frame *		new_frame;
 
 	context = E4C_CONTEXT;
 
-	/* check if `handleSignal` was called before `e4c_context_begin` or after `e4c_context_end` (very unlikely) */
-	PREVENT_PROC(context == NULL, DESC_INVALID_CONTEXT, "_e4c_library_handle_signal");
+	/* check if 'try' was used before calling e4c_context_begin */
+	if(context == NULL){
+		if(stage == E4C_WITH_STAGE_){
+			MISUSE_ERROR(ContextHasNotBegunYet, "E4C_WITH: " DESC_NOT_BEGUN_YET, file, line, function);
+		}
+		MISUSE_ERROR(ContextHasNotBegunYet, "E4C_TRY: " DESC_NOT_BEGUN_YET, file, line, function);
+		E4C_UNREACHABLE_RETURN(NULL);
+	}
+
+	current_frame = context->current_frame;
 
 	/* check if the current frame is NULL (very unlikely) */
-	PREVENT_PROC(context->current_frame == NULL, DESC_INVALID_FRAME, "_e4c_library_handle_signal");
+	PREVENT_FUNC(current_frame == NULL, DESC_INVALID_FRAME, "e4c_frame_first_stage_", NULL);
+
+	/* create a new frame */
+	new_frame = _e4c_frame_allocate(__LINE__, "e4c_frame_first_stage_");
+
+	STATISTICS_GAUGE(context, live_frames, 1L);
+
+	_e4c_frame_initialize(new_frame, current_frame, stage);
+
+# ifdef E4C_STATISTICS
+	new_frame->file	= file;
+	new_frame->line	= line;
+	_e4c_context_monotonic_time(&new_frame->started_seconds, &new_frame->started_nanoseconds);
+# endif
+
+	/* make it the new current frame */
+	context->current_frame = new_frame;
+
+	NOTIFY_EVENT(context, e4c_event_enter, NULL, file, line, function);
+
+	return( &(new_frame->continuation) );
+}
+
+static E4C_INLINE void _e4c_frame_initialize(e4c_frame * frame, e4c_frame * previous, e4c_frame_stage stage){
+
+	frame->previous				= previous;
+	frame->stage				= stage;
+	frame->uncaught				= E4C_FALSE;
+	frame->reacquire_attempts	= 0;
+	frame->retry_attempts		= 0;
+# ifdef E4C_FAST_FAIL
+	frame->catch_count			= 0;
+	frame->has_finally			= E4C_FALSE;
+	frame->has_dispose			= (stage == e4c_registering_);
+# endif
+	frame->batch				= NULL;
+	frame->thrown_exception		= NULL;
+# ifdef E4C_STATISTICS
+	frame->file					= NULL;
+	frame->line					= 0;
+	frame->started_seconds		= 0L;
+	frame->started_nanoseconds	= 0L;
+# endif
+
+	/* jmp_buf is an implementation-defined type */
+}
+
+static E4C_INLINE e4c_frame * _e4c_frame_allocate(int line, const char * function){
+
+	e4c_frame * frame;
+
+	/* (using calloc instead of malloc so that jmp_buf is initialized to zero) */
+	frame = calloc( (size_t)1, sizeof(*frame) );
+
+	if(frame == NULL){
+		MEMORY_ERROR(DESC_MALLOC_FRAME, line, function);
+		E4C_UNREACHABLE_RETURN(NULL);
+	}
+
+	return(frame);
+}
+
+static E4C_INLINE void _e4c_frame_deallocate(e4c_frame * frame, e4c_context * context){
+
+	if(frame != NULL){
+
+		/* (the top frame is only deallocated when the context ends) */
+		STATISTICS_GAUGE(context, live_frames, -1L);
+
+		/* delete previous frame */
+		_e4c_frame_deallocate(frame->previous, context);
+		frame->previous = NULL;
+
+		/* delete thrown exception */
+		_e4c_exception_deallocate(frame->thrown_exception, context);
+		frame->thrown_exception = NULL;
+
+		free(frame);
+	}
+}
+
+e4c_frame_stage e4c_frame_get_stage_(const char * file, int line, const char * function){
+
+	e4c_context * context;
+
+	context = E4C_CONTEXT;
+
+	/* check if 'e4c_frame_get_stage_' was used before calling e4c_context_begin */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_frame_get_stage_: " DESC_NOT_BEGUN_YET, file, line, function);
+		E4C_UNREACHABLE_RETURN(e4c_done_);
+	}
 
 	/* check if the current frame is NULL (very unlikely) */
-	PREVENT_PROC(context->signal_mappings == NULL, DESC_INVALID_STATE, "_e4c_library_handle_signal");
+	PREVENT_FUNC(context->current_frame == NULL, DESC_INVALID_FRAME, "e4c_frame_get_stage_", e4c_done_);
 
-	/* try to find a mapping for this signal */
-	mapping = context->signal_mappings;
+	return(context->current_frame->stage);
+}
 
-	/* loop until we find the NULL terminator */
-	while(mapping->signal_number != E4C_INVALID_SIGNAL_NUMBER_){
+E4C_BOOL e4c_frame_catch_(const e4c_exception_type * exception_type, const char * file, int line, const char * function){
 
-		if(signal_number == mapping->signal_number){
+	e4c_context *	context;
+	e4c_frame *		frame;
 
-			const char * signal_name;
+	context = E4C_CONTEXT;
 
-			switch(signal_number){
-				WHEN_SIGNAL(SIGABRT)
-				WHEN_SIGNAL(SIGFPE)
-				WHEN_SIGNAL(SIGILL)
-				WHEN_SIGNAL(SIGSEGV)
-				WHEN_SIGNAL(SIGTERM)
-				WHEN_SIGNAL(SIGINT)
-				WHEN_SIGNAL_SIGALRM
-				WHEN_SIGNAL_SIGCHLD
-				WHEN_SIGNAL_SIGTRAP
-				WHEN_SIGNAL_SIGPIPE
-				WHEN_SIGNAL_SIGSTOP
-				WHEN_SIGNAL_SIGKILL
-				WHEN_SIGNAL_SIGHUP
-				WHEN_SIGNAL_SIGXCPU
-				WHEN_SIGNAL_SIGQUIT
-				WHEN_SIGNAL_SIGBREAK
-				WHEN_SIGNAL_SIGUSR1
-				WHEN_SIGNAL_SIGUSR2
-				default:
-					signal_name = signal_name_UNKNOWN;
-					/*@switchbreak@*/ break;
-			}
+	/* ensure that 'e4c_frame_catch_' was used after calling e4c_context_begin */
+	if(context != NULL){
 
-			/* check if we were supposed to ignore this signal (very unlikely) */
-			PREVENT_PROC(mapping->exception_type == NULL, DESC_INVALID_STATE, "_e4c_library_handle_signal");
+		frame = context->current_frame;
 
-			/* reset the handler for this signal */
-			previous_handler = signal(signal_number, _e4c_library_handle_signal);
-			if(previous_handler == SIG_ERR){
-				/* we were unable to register the signal handling procedure again */
-				INTERNAL_ERROR(DESC_SIGERR_HANDLE, "_e4c_library_handle_signal");
-				E4C_UNREACHABLE_VOID_RETURN;
+		/* check if the current frame is NULL (very unlikely) */
+		PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_catch_", E4C_FALSE);
+
+# ifdef E4C_FAST_FAIL
+		/* the first pass (before trying) registers the catch blocks for the search phase */
+		if(frame->stage < e4c_trying_){
+			/* (reacquiring does not register them again) */
+			if( frame->reacquire_attempts == 0 && !IS_CATCH_OVERFLOW(frame) ){
+				if(frame->catch_count < E4C_MAX_CATCH_TYPES){
+					frame->catch_types[frame->catch_count] = exception_type;
+				}
+				/* (too many catch blocks: the frame will be assumed to catch anything) */
+				frame->catch_count++;
 			}
+			return(E4C_FALSE);
+		}
+# endif
+
+		if(frame->stage != e4c_catching_){
+			return(E4C_FALSE);
+		}
+
+		/* passing NULL to a catch block is considered a fatal error */
+		if(exception_type == NULL){
+			MISUSE_ERROR(NullPointerException, "E4C_CATCH: " DESC_CATCH_NULL, file, line, function);
+			E4C_UNREACHABLE_RETURN(E4C_FALSE);
+		}
+
+		/* check if the thrown exception is NULL (very unlikely) */
+		PREVENT_FUNC(frame->thrown_exception == NULL, DESC_INVALID_STATE, "e4c_frame_catch_", E4C_FALSE);
+
+		/* check if the exception type is NULL (very unlikely) */
+		PREVENT_FUNC(frame->thrown_exception->type == NULL, DESC_INVALID_STATE, "e4c_frame_catch_", E4C_FALSE);
+
+		/* assert: thrown_exception is catchable (otherwise we would have skipped the "catching" stage in e4c_frame_next_stage_) */
+
+		/* does this block catch current exception? */
+		if(	frame->thrown_exception->type == exception_type || _e4c_exception_type_extends(frame->thrown_exception->type, exception_type) ){
+
+			/* yay, catch current exception by executing the handler */
+			frame->uncaught = E4C_FALSE;
 
-			/* check context and frame; initialize exception and cause */
-			new_exception = _e4c_exception_throw(context->current_frame, mapping->exception_type, signal_name, signal_number, "_e4c_library_handle_signal", errno, E4C_TRUE, NULL);
+			STATISTICS_COUNT(context, frame->thrown_exception->type, frame->thrown_exception->file, frame->thrown_exception->line, caught);
 
-			/* set initial value for custom data */
-			new_exception->custom_data = context->custom_data;
-			/* initialize custom data */
-			if(context->initialize_handler != NULL){
-				new_exception->custom_data = context->initialize_handler(new_exception);
-			}
+			NOTIFY_EVENT(context, e4c_event_catch, frame->thrown_exception, file, line, function);
 
-			/* propagate the exception up the call stack */
-			_e4c_context_propagate(context, new_exception);
+			PROBE_EXCEPTION(catch, context, frame->thrown_exception, file, line);
+
+			return(E4C_TRUE);
 		}
 
-		/* proceed to the next mapping */
-		mapping++;
+		/* nay, keep looking for an exception handler */
+		return(E4C_FALSE);
 	}
 
-	/* this should never happen, but anyway... */
-	/* we were unable to find the exception that represents the received signal number */
-	INTERNAL_ERROR(DESC_NO_MAPPING, "_e4c_library_handle_signal");
+	MISUSE_ERROR(ContextHasNotBegunYet, "e4c_frame_catch_: " DESC_NOT_BEGUN_YET, file, line, function);
+	E4C_UNREACHABLE_RETURN(E4C_FALSE);
 }
 
-static E4C_INLINE void _e4c_library_fatal_error(const e4c_exception_type * exception_type, const char * message, const char * file, int line, const char * function, int error_number){
+E4C_BOOL e4c_frame_finally_(const char * file, int line, const char * function){
 
-	e4c_exception exception;
+	e4c_context *	context;
+	e4c_frame *		frame;
 
-	_e4c_exception_initialize(&exception, exception_type, E4C_TRUE, message, file, line, function, error_number);
+	context = E4C_CONTEXT;
 
-	/* ensures library initialization so that _e4c_library_finalize will be called */
-	INITIALIZE_ONCE;
+	/* check if 'e4c_frame_finally_' was used before calling e4c_context_begin */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_frame_finally_: " DESC_NOT_BEGUN_YET, file, line, function);
+		E4C_UNREACHABLE_RETURN(E4C_FALSE);
+	}
 
-	/* prints this specific exception */
-	_e4c_context_at_uncaught_exception(E4C_CONTEXT, &exception);
+	frame = context->current_frame;
 
-	/* records critical error so that MSG_AT_EXIT_ERROR will be printed too */
-	fatal_error_flag = E4C_TRUE;
+	/* check if the current frame is NULL (very unlikely) */
+	PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_finally_", E4C_FALSE);
 
-	/*@-noeffectuncon@*/
-	STOP_EXECUTION;
-	/*@=noeffectuncon@*/
+# ifdef E4C_FAST_FAIL
+	/* the first pass (before trying) registers the finally block */
+	if(frame->stage < e4c_trying_){
+		frame->has_finally = E4C_TRUE;
+		return(E4C_FALSE);
+	}
+# endif
+
+	return(frame->stage == e4c_finalizing_);
 }
 
-long e4c_library_version(void){
+# ifdef E4C_FAST_FAIL
 
-	return( (long)E4C_VERSION_NUMBER );
-}
+static E4C_BOOL _e4c_frame_catches(const e4c_frame * frame, const e4c_exception_type * exception_type){
 
-# ifdef E4C_THREADSAFE
+	int								index;
+	const e4c_exception_type *		catch_type;
 
-/* ENVIRONMENT
- ================================================================ */
+	/* the catch blocks will not be run again, and uncatchable exceptions skip them */
+	if( frame->stage >= e4c_catching_ || IS_UNCATCHABLE_TYPE(exception_type) ){
+		return(E4C_FALSE);
+	}
 
-static e4c_environment * _e4c_environment_get_current(void){
+	/* a batch collects any catchable exception */
+	if( frame->batch != NULL || IS_CATCH_OVERFLOW(frame) ){
+		return(E4C_TRUE);
+	}
 
-	THREAD_TYPE			self		= THREAD_CURRENT;
-	/*@dependent@*/
-	e4c_environment *	environment	= NULL;
+	for(index = 0; index < frame->catch_count; index++){
+		catch_type = frame->catch_types[index];
+		/* (a null catch block must be reached in order to be reported) */
+		if( catch_type == NULL || catch_type == exception_type || _e4c_exception_type_extends(exception_type, catch_type) ){
+			return(E4C_TRUE);
+		}
+	}
 
-	MUTEX_LOCK(environment_collection_mutex, "_e4c_environment_get_current")
+	return(E4C_FALSE);
+}
 
-		FOREACH(environment, environment_collection){
+static E4C_BOOL _e4c_frame_is_transparent(const e4c_frame * frame, const e4c_exception_type * exception_type){
 
-			if( THREAD_SAME(self, environment->self) ){
-				break;
-			}
-		}
+	/* the resource of a "with" block has to be disposed */
+	if( frame->has_dispose && frame->stage == e4c_trying_ ){
+		return(E4C_FALSE);
+	}
 
-	MUTEX_UNLOCK(environment_collection_mutex, "_e4c_environment_get_current")
+	/* the finally block has not been run yet */
+	if( frame->has_finally && frame->stage < e4c_finalizing_ ){
+		return(E4C_FALSE);
+	}
 
-	return(environment);
+	return( !_e4c_frame_catches(frame, exception_type) );
 }
 
-static E4C_INLINE e4c_environment * _e4c_environment_allocate(int line, const char * function){
-
-	e4c_environment * environment;
+# endif
 
-	environment = malloc( sizeof(*environment) );
+static e4c_batch_error * _e4c_batch_add(e4c_batch * batch, const e4c_exception_type * exception_type, const char * file, int line, const char * function, int error_number){
 
-	/* ensure that there was enough memory */
-	if(environment != NULL){
+	e4c_batch_error * error;
 
-		return(environment);
+	/* once the array is full, failures are only counted */
+	if(batch->errors == NULL || batch->count >= batch->capacity){
+		batch->overflow++;
+		return(NULL);
 	}
 
-	MEMORY_ERROR(DESC_MALLOC_CONTEXT, line, function);
-	E4C_UNREACHABLE_RETURN(NULL);
-}
+	error = &batch->errors[batch->count++];
 
-static E4C_INLINE void _e4c_environment_deallocate(e4c_environment * environment){
+	error->index		= batch->index;
+	error->type			= exception_type;
+	error->file			= file;
+	error->line			= line;
+	error->function		= function;
+	error->error_number	= error_number;
 
-	if(environment != NULL){
+	/* (the caller will copy the message) */
 
-		_e4c_frame_deallocate(environment->context.current_frame, environment->context.finalize_handler);
-		environment->context.current_frame = NULL;
+	return(error);
+}
 
-		free(environment);
-	}
+E4C_BOOL e4c_frame_next_stage_(void){
+
+	return( _e4c_frame_advance(E4C_FALSE) );
 }
 
-static void _e4c_environment_initialize(e4c_environment * environment, e4c_uncaught_handler uncaught_handler){
+e4c_continuation * e4c_frame_rearm_(const char * file, int line, const char * function){
 
-	/* assert: environment != NULL */
+	e4c_context *	context;
+	e4c_frame *		frame;
 
-	/* bound the new environment to the current thread */
-	environment->self = THREAD_CURRENT;
+	context = E4C_CONTEXT;
 
-	_e4c_context_initialize(&environment->context, uncaught_handler);
-}
+	/* check if 'try_each' was used before calling e4c_context_begin */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "E4C_TRY_EACH: " DESC_NOT_BEGUN_YET, file, line, function);
+		E4C_UNREACHABLE_RETURN(NULL);
+	}
 
-static E4C_INLINE void _e4c_environment_add(e4c_environment * environment){
+	frame = context->current_frame;
 
-	/* assert: environment != NULL */
+	/* check if the current frame is NULL (very unlikely) */
+	PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_rearm_", NULL);
+
+	/* reset the frame left by the previous iteration (the first one may register the catch blocks) */
+	if(frame->stage == e4c_done_){
+		frame->stage				= e4c_acquiring_;
+		frame->uncaught				= E4C_FALSE;
+		frame->retry_attempts		= 0;
+		/* (thrown_exception was already deallocated at the end of the previous iteration) */
+# ifdef E4C_STATISTICS
+		/* (each iteration is measured separately) */
+		_e4c_context_monotonic_time(&frame->started_seconds, &frame->started_nanoseconds);
+# endif
+	}
 
-	MUTEX_LOCK(environment_collection_mutex, "_e4c_environment_add")
+	return( &(frame->continuation) );
+}
 
-		environment->next				= environment_collection.first;
-		environment_collection.first	= environment;
+E4C_BOOL e4c_frame_next_iteration_(void){
 
-	MUTEX_UNLOCK(environment_collection_mutex, "_e4c_environment_add")
+	return( _e4c_frame_advance(E4C_TRUE) );
 }
 
-static e4c_environment * _e4c_environment_remove(void){
+E4C_BOOL e4c_frame_collect_(e4c_batch * batch, int index, const char * file, int line, const char * function){
 
-	THREAD_TYPE			self		= THREAD_CURRENT;
-	e4c_environment *	previous	= NULL;
-	e4c_environment *	current;
-	e4c_environment *	found		= NULL;
+	e4c_context *	context;
+	e4c_frame *		frame;
 
-	MUTEX_LOCK(environment_collection_mutex, "_e4c_environment_remove")
+	context = E4C_CONTEXT;
 
-		FOREACH(current, environment_collection){
+	/* check if 'batch_each' was used before calling e4c_context_begin */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "E4C_BATCH_EACH: " DESC_NOT_BEGUN_YET, file, line, function);
+		E4C_UNREACHABLE_RETURN(E4C_FALSE);
+	}
 
-			if( THREAD_SAME(self, current->self) ){
-				if(previous == NULL){
-					found							= environment_collection.first /* (equals current) */;
-					environment_collection.first	= current->next;
-				}else{
-					found							= previous->next  /* (equals current) */;
-					previous->next					= current->next;
-				}
-				current->next = NULL;
-				break;
-			}
+	frame = context->current_frame;
 
-			/* keep track of the previous environment */
-			previous = current;
-		}
+	/* check if the current frame is NULL (very unlikely) */
+	PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_collect_", E4C_FALSE);
 
-	MUTEX_UNLOCK(environment_collection_mutex, "_e4c_environment_remove")
+	/* the reusable frame will record the failures of the next iteration */
+	frame->batch	= batch;
+	batch->index	= index;
 
-	return(found);
+	return(E4C_TRUE);
 }
 
-# endif
+E4C_BOOL e4c_frame_last_iteration_(const char * file, int line, const char * function){
 
-/* CONTEXT
- ================================================================ */
+	e4c_context *	context;
+	e4c_frame *		frame;
 
-static E4C_INLINE void _e4c_context_initialize(e4c_context * context, e4c_uncaught_handler uncaught_handler){
+	context = E4C_CONTEXT;
 
-	context->uncaught_handler	= uncaught_handler;
-	context->signal_mappings	= NULL;
-	context->custom_data		= NULL;
-	context->initialize_handler	= NULL;
-	context->finalize_handler	= NULL;
-	context->current_frame		= _e4c_frame_allocate(__LINE__, "_e4c_context_initialize");
+	/* check if 'try_each' was used before calling e4c_context_begin */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "E4C_TRY_EACH: " DESC_NOT_BEGUN_YET, file, line, function);
+		E4C_UNREACHABLE_RETURN(E4C_FALSE);
+	}
 
-	_e4c_frame_initialize(context->current_frame, NULL, e4c_done_);
+	frame = context->current_frame;
+
+	/* check if the current frame is NULL (very unlikely) */
+	PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_last_iteration_", E4C_FALSE);
+
+	/* check if the previous frame is NULL (unlikely) */
+	PREVENT_FUNC(frame->previous == NULL, DESC_INVALID_FRAME, "e4c_frame_last_iteration_", E4C_FALSE);
+
+	NOTIFY_EVENT(context, e4c_event_exit, NULL, file, line, function);
+
+	/* promote the previous frame to the current one */
+	context->current_frame = frame->previous;
+
+	/* delete the reusable frame */
+	frame->previous = NULL;
+	_e4c_frame_deallocate(frame, context);
+
+	/* get out of the loop */
+	return(E4C_FALSE);
 }
 
-static void _e4c_context_propagate(e4c_context * context, e4c_exception * exception){
+static E4C_INLINE E4C_BOOL _e4c_frame_advance(E4C_BOOL iterating){
 
-	/* assert: exception != NULL */
-	/* assert: context != NULL */
-	/* assert: context->current_frame != NULL */
+	e4c_context *		context;
+	e4c_frame *			frame;
+	e4c_frame *			previous;
+	e4c_exception *		thrown_exception;
+	e4c_batch_error *	error;
 
-	e4c_frame * frame;
+	context = E4C_CONTEXT;
+
+	/* check if the current exception context is NULL (unlikely) */
+	PREVENT_FUNC(context == NULL, DESC_NOT_BEGUN_YET, "e4c_frame_next_stage_", E4C_FALSE);
 
 	frame = context->current_frame;
 
-	/* update the frame with the exception information */
-	frame->uncaught			= E4C_TRUE;
+	/* check if the current frame is NULL (very unlikely) */
+	PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_next_stage_", E4C_FALSE);
 
-	/* deallocate previously thrown exception */
-	_e4c_exception_deallocate(frame->thrown_exception, context->finalize_handler);
+	frame->stage++;
 
-	/* update current thrown exception */
-	frame->thrown_exception	= exception;
+	/* a batch records the exception instead of looking for a catch block */
+	if( frame->stage == e4c_catching_ && frame->batch != NULL && frame->uncaught && frame->thrown_exception != NULL && !IS_UNCATCHABLE(frame->thrown_exception) ){
 
-	/* if this is the upper frame, then this is an uncaught exception */
-	if( IS_TOP_FRAME(frame) ){
-		_e4c_context_at_uncaught_exception(context, exception);
+		error = _e4c_batch_add(frame->batch, frame->thrown_exception->type, frame->thrown_exception->file, frame->thrown_exception->line, frame->thrown_exception->function, frame->thrown_exception->error_number);
 
-		e4c_context_end();
+		if(error != NULL){
+			VERBATIM_COPY(error->message, frame->thrown_exception->message);
+		}
 
-		/*@-noeffectuncon@*/
-		STOP_EXECUTION;
-		/*@=noeffectuncon@*/
+		frame->uncaught = E4C_FALSE;
 	}
 
-	/* otherwise, we will jump to the upper frame */
-
 	/* simple optimization */
-	if(frame->stage == e4c_acquiring_){
-		/* if we are in the middle of an acquisition, we don't need to dispose the resource */
-		frame->stage = e4c_disposing_;
-		/* (that actually jumps over the "disposing" stage) */
+	if(  frame->stage == e4c_catching_  &&  ( !frame->uncaught || (frame->thrown_exception == NULL) || IS_UNCATCHABLE(frame->thrown_exception) )  ){
+		/* if no exception was thrown, or if the thrown exception cannot be
+			caught, we don't need to go through the "catching" stage */
+		frame->stage++;
 	}
 
-	/* keep looping */
-	E4C_CONTINUE(frame->continuation);
-}
-
-# ifdef E4C_THREADSAFE
+# ifdef E4C_FAST_FAIL
+	/* the first pass registered whether there is a finally block, so the "finalizing" stage can be skipped too */
+	if( frame->stage == e4c_finalizing_ && !frame->has_finally ){
+		frame->stage++;
+	}
+# endif
 
-static E4C_INLINE e4c_context * _e4c_context_get_current(void){
+	/* keep looping until we reach the "done" stage */
+	if(frame->stage < e4c_done_){
+		return(E4C_TRUE);
+	}
 
-	e4c_environment * environment = _e4c_environment_get_current();
+	/* check if the previous frame is NULL (unlikely) */
+	PREVENT_FUNC(frame->previous == NULL, DESC_INVALID_FRAME, "e4c_frame_next_stage_", E4C_FALSE);
 
-	return(environment == NULL ? NULL : &environment->context);
-}
+	/* the exception loop is finished */
 
-/* e4c_context_begin (multi-thread) */
-void e4c_context_begin(E4C_BOOL handle_signals){
+# ifdef E4C_STATISTICS
+	if(frame->thrown_exception == NULL){
+		_e4c_latency_record(context, frame, e4c_succeeded);
+	}else{
+		_e4c_latency_record(context, frame, (frame->uncaught ? e4c_failed : e4c_recovered) );
+	}
+# endif
 
-	e4c_environment * environment;
+	/* deallocate caught exception */
+	if(frame->thrown_exception != NULL && !frame->uncaught){
+		_e4c_exception_deallocate(frame->thrown_exception, context);
+		frame->thrown_exception = NULL;
+	}
 
-	INITIALIZE_ONCE;
+	/* a reusable frame stays in place for the next iteration (unless an exception was not caught) */
+	if(iterating && frame->thrown_exception == NULL){
+		return(E4C_FALSE);
+	}
 
-	/* get the current environment */
-	environment = _e4c_environment_get_current();
+	NOTIFY_EVENT(context, e4c_event_exit, frame->thrown_exception, NULL, 0, NULL);
 
-	/* check if e4c_context_begin was called twice for this thread */
-	if(environment != NULL){
-		MISUSE_ERROR(ContextAlreadyBegun, "e4c_context_begin: " DESC_ALREADY_BEGUN, NULL, 0, NULL);
-		E4C_UNREACHABLE_VOID_RETURN;
-	}
+	/* capture temporarily the information of the current frame */
+	/* so we can propagate an exception (if it was thrown) */
+	previous			= frame->previous;
+	thrown_exception	= frame->thrown_exception;
 
-	/* allocate memory for the new environment */
-	environment	= _e4c_environment_allocate(__LINE__, "e4c_context_begin");
+	/* modify the current frame so that previous and thrown_exception don't get deallocated */
+	frame->previous			= NULL;
+	frame->thrown_exception = NULL;
 
-	/* initialize the new environment, register uncaught handler */
-	_e4c_environment_initialize(environment, e4c_print_exception);
+	/* delete the current frame */
+	_e4c_frame_deallocate(frame, context);
 
-	/* add the new environment to the collection */
-	_e4c_environment_add(environment);
+	/* promote the previous frame to the current one */
+	context->current_frame = previous;
 
-	if(handle_signals){
-		_e4c_context_set_signal_handlers(&environment->context, e4c_default_signal_mappings);
+	/* if the current frame has an uncaught exception, then we will propagate it */
+	if(thrown_exception != NULL){
+		_e4c_context_propagate(context, thrown_exception, E4C_TRUE);
 	}
-}
+	/* otherwise, we're free to go */
 
-/* e4c_context_end (multi-thread) */
-void e4c_context_end(void){
+	/* get out of the exception loop */
+	return(E4C_FALSE);
+}
+
+void e4c_frame_repeat_(int max_repeat_attempts, e4c_frame_stage stage, const char * file, int line, const char * function){
 
 	e4c_context *		context;
 	e4c_frame *			frame;
-	e4c_environment *	environment;
 
-	/* remove (and get) the current context */
-	environment = _e4c_environment_remove();
+	/* get the current context */
+	context = E4C_CONTEXT;
 
-	/* check if `e4c_context_end` was called before calling `e4c_context_begin` */
-	if(environment == NULL){
-		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_end: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+	/* check if 'e4c_frame_repeat_' was used before calling e4c_context_begin */
+	if(context == NULL){
+		if(stage == e4c_beginning_){
+			MISUSE_ERROR(ContextHasNotBegunYet, "E4C_REACQUIRE: " DESC_NOT_BEGUN_YET, file, line, function);
+		}
+		MISUSE_ERROR(ContextHasNotBegunYet, "E4C_RETRY: " DESC_NOT_BEGUN_YET, file, line, function);
 		E4C_UNREACHABLE_VOID_RETURN;
 	}
 
-	/* update local variable */
-	context = &environment->context;
-
-	/* check if the current context is NULL (unlikely) */
-	PREVENT_PROC(context == NULL, DESC_INVALID_CONTEXT, "e4c_context_end");
-
 	/* get the current frame */
 	frame = context->current_frame;
 
-	/* check if there are no frames left (unlikely) */
-	PREVENT_PROC(frame == NULL, DESC_NO_FRAMES_LEFT, "e4c_context_end");
+	/* check if the current frame is NULL (unlikely) */
+	PREVENT_PROC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_repeat_");
 
-	/* check if there are too many frames left (breaking out of a try block) */
-	if( !IS_TOP_FRAME(frame) ){
-		INTERNAL_ERROR(DESC_TOO_MANY_FRAMES, "e4c_context_end");
+	/* check if 'e4c_frame_repeat_' was used before 'try' or 'use' */
+	if( IS_TOP_FRAME(frame) ){
+		if(stage == e4c_beginning_){
+			MISUSE_ERROR(ExceptionSystemFatalError, "E4C_REACQUIRE: " DESC_CANNOT_REACQUIRE, file, line, function);
+		}
+		MISUSE_ERROR(ExceptionSystemFatalError, "E4C_RETRY: " DESC_CANNOT_RETRY, file, line, function);
 		E4C_UNREACHABLE_VOID_RETURN;
 	}
 
-	/* reset all signal handlers */
-	_e4c_context_set_signal_handlers(context, NULL);
+	/* check if "uncatchable" exception */
+	if( frame->uncaught && (frame->thrown_exception != NULL) && IS_UNCATCHABLE(frame->thrown_exception) ){
+		return;
+	}
 
-	/* deallocate the thread environment */
-	_e4c_environment_deallocate(environment);
-}
+	/* check if maximum number of attempts reached and update the number of attempts */
+	switch(stage){
 
-# else
+		case e4c_beginning_:
+			/* reacquire */
+			if(frame->reacquire_attempts >= max_repeat_attempts){
+				return;
+			}
+			frame->reacquire_attempts++;
+			/*@switchbreak@*/ break;
 
-/* e4c_context_begin (single-thread) */
-void e4c_context_begin(E4C_BOOL handle_signals){
+		case e4c_acquiring_:
+			/* retry */
+			if(frame->retry_attempts >= max_repeat_attempts){
+				return;
+			}
+			frame->retry_attempts++;
+			/*@switchbreak@*/ break;
 
-	INITIALIZE_ONCE;
+		case e4c_registering_:
+		case e4c_trying_:
+		case e4c_disposing_:
+		case e4c_catching_:
+		case e4c_finalizing_:
+		case e4c_done_:
+		default:
+			MISUSE_ERROR(ExceptionSystemFatalError, "e4c_frame_repeat: " DESC_CANNOT_REPEAT, file, line, function);
+			E4C_UNREACHABLE_VOID_RETURN;
+	}
 
-	/* check if e4c_context_begin was called twice for this program */
-	/* this can also happen when the program uses threads but E4C_THREADSAFE is not defined */
-	if(current_context != NULL){
-		MISUSE_ERROR(ContextAlreadyBegun, "e4c_context_begin: " DESC_ALREADY_BEGUN, NULL, 0, NULL);
-		E4C_UNREACHABLE_VOID_RETURN;
+# ifdef E4C_STATISTICS
+	if(frame->thrown_exception != NULL){
+		if(stage == e4c_beginning_){
+			STATISTICS_COUNT(context, frame->thrown_exception->type, frame->thrown_exception->file, frame->thrown_exception->line, reacquired);
+		}else{
+			STATISTICS_COUNT(context, frame->thrown_exception->type, frame->thrown_exception->file, frame->thrown_exception->line, retried);
+		}
 	}
+# endif
 
-	/* check if the current frame is NOT NULL (unlikely) */
-	PREVENT_PROC(main_context.current_frame != NULL, DESC_INVALID_STATE, "e4c_context_begin");
+	NOTIFY_EVENT(context, (stage == e4c_beginning_ ? e4c_event_reacquire : e4c_event_retry), frame->thrown_exception, file, line, function);
 
-	/* initialize context, register uncaught handler */
-	_e4c_context_initialize(&main_context, e4c_print_exception);
+	/* deallocate previously thrown exception */
+	_e4c_exception_deallocate(frame->thrown_exception, context);
 
-	if(handle_signals){
-		_e4c_context_set_signal_handlers(&main_context, e4c_default_signal_mappings);
-	}
+	/* reset exception information */
+	frame->thrown_exception	= NULL;
+	frame->uncaught			= E4C_FALSE;
+	frame->stage			= stage;
 
-	/* update global variable */
-	current_context	= &main_context;
+	/* keep looping */
+	E4C_CONTINUE(frame->continuation);
 }
 
-/* e4c_context_end (single-thread) */
-void e4c_context_end(void){
+e4c_status e4c_get_status(void){
 
-	e4c_context *		context;
-	e4c_frame *			frame;
+	e4c_context *	context;
+	e4c_frame *		frame;
 
-	/* get the current context */
-	context = current_context;
+	context = E4C_CONTEXT;
 
-	/* ensure that `e4c_context_end` was called after calling `e4c_context_begin` */
+	/* ensure that `e4c_get_status` was called after calling `e4c_context_begin` */
 	if(context != NULL){
 
-		/* get the current frame */
 		frame = context->current_frame;
 
-		/* check if there are no frames left (unlikely) */
-		PREVENT_PROC(frame == NULL, DESC_NO_FRAMES_LEFT, "e4c_context_end");
+		/* check if the current frame is NULL (very unlikely) */
+		PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_get_status", e4c_failed);
 
-		/* check if there are too many frames left (breaking out of a try block) */
-		if( !IS_TOP_FRAME(frame) ){
-			INTERNAL_ERROR(DESC_TOO_MANY_FRAMES, "e4c_context_end");
-			E4C_UNREACHABLE_VOID_RETURN;
+		if(frame->thrown_exception == NULL){
+			return(e4c_succeeded);
 		}
 
-		/* reset all signal handlers */
-		_e4c_context_set_signal_handlers(context, NULL);
+		if(frame->uncaught){
+			return(e4c_failed);
+		}
 
-		/* deallocate the current, top frame */
-		_e4c_frame_deallocate(frame, context->finalize_handler);
+		return(e4c_recovered);
+	}
 
-		/* deactivate the top frame (for sanity) */
-		current_context->current_frame = NULL;
+	MISUSE_ERROR(ContextHasNotBegunYet, "e4c_get_status: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+	E4C_UNREACHABLE_RETURN(e4c_failed);
+}
 
-		/* deactivate the current context */
-		current_context = NULL;
+void e4c_batch_init(e4c_batch * batch, e4c_batch_error * errors, int capacity){
 
-	}else{
+	if(batch == NULL){
+		return;
+	}
 
-		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_end: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
+	if(errors == NULL || capacity <= 0){
+		/* failures will only be counted */
+		batch->errors	= NULL;
+		batch->capacity	= 0;
+	}else{
+		batch->errors	= errors;
+		batch->capacity	= capacity;
 	}
+
+	batch->count	= 0;
+	batch->overflow	= 0;
+	batch->index	= 0;
 }
 
-# endif
+/* STATISTICS
+ ================================================================ */
 
-static void _e4c_context_set_signal_handlers(e4c_context * context, const e4c_signal_mapping * mappings){
+# ifdef E4C_STATISTICS
 
-	/* assert: context != NULL */
+static e4c_statistic * _e4c_statistics_find(e4c_context * context, const e4c_exception_type * exception_type, const char * file, int line){
 
-	const e4c_signal_mapping *	next_mapping;
-	signal_handler				previous_handler;
+	e4c_statistic * statistic;
+	e4c_statistic * table;
 
-	if(context->signal_mappings != NULL){
-		next_mapping = context->signal_mappings;
-		/* reset all the previously set signal handlers */
-		while(next_mapping->signal_number != E4C_INVALID_SIGNAL_NUMBER_){
-			previous_handler = signal(next_mapping->signal_number, SIG_DFL);
-			if(previous_handler == SIG_ERR){
-				/* we were unable to reset to the default action */
-				INTERNAL_ERROR(DESC_SIGERR_DEFAULT, "e4c_set_signal_handlers");
-				E4C_UNREACHABLE_VOID_RETURN;
-			}
-			next_mapping++;
+	/* the table is allocated when the first exception is counted */
+	if(context->statistics == NULL){
+		table = calloc( (size_t)E4C_STATISTICS_SIZE + 1, sizeof(e4c_statistic) );
+		if(table == NULL){
+			/* (counting is not worth a fatal error) */
+			return(&lost_statistic);
 		}
+		/* (other threads may read the table as soon as it is published) */
+		MEMORY_BARRIER("_e4c_statistics_find")
+		context->statistics = table;
 	}
 
-	if(mappings == NULL){
-		/* disable signal handling */
-		context->signal_mappings = NULL;
-		return;
-	}
-
-	/* set up signal mapping */
-	context->signal_mappings = next_mapping = mappings;
-
-	while(next_mapping->signal_number != E4C_INVALID_SIGNAL_NUMBER_){
-
-		signal_handler	handler;
-		const char *	error_message;
-
-		if(next_mapping->exception_type != NULL){
-			/* map this signal to this exception */
-			handler			= _e4c_library_handle_signal;
-			error_message	= DESC_SIGERR_HANDLE;
-		}else{
-			/* ignore this signal */
-			handler			= SIG_IGN;
-			error_message	= DESC_SIGERR_IGNORE;
-		}
-
-		previous_handler = signal(next_mapping->signal_number, handler);
-		if(previous_handler == SIG_ERR){
-			INTERNAL_ERROR(error_message, "e4c_set_signal_handlers");
-			E4C_UNREACHABLE_VOID_RETURN;
-		}
+	statistic = _e4c_statistics_find_in(context->statistics, exception_type, file, line);
 
-		next_mapping++;
-	}
+	/* (the last element counts the sites that do not fit in the table) */
+	return(statistic != NULL ? statistic : &context->statistics[E4C_STATISTICS_SIZE]);
 }
 
-static void _e4c_context_at_uncaught_exception(e4c_context * context, const e4c_exception * exception){
+static E4C_INLINE e4c_statistic * _e4c_statistics_find_in(e4c_statistic * table, const e4c_exception_type * exception_type, const char * file, int line){
 
-	/* assert: exception != NULL */
+	e4c_statistic *	statistic;
+	unsigned long	hash;
+	int				probe;
 
-	if(context == NULL){
+	/* (a NULL exception type will be converted to NPE) */
+	if(exception_type == NULL){
+		exception_type = &NullPointerException;
+	}
 
-		/* fatal error (likely library misuse) */
-		_e4c_print_exception(exception);
+	hash = (unsigned long)line * 31UL + (unsigned long)(size_t)exception_type / sizeof(void *) + (unsigned long)(size_t)file;
 
-	}else{
+	/* open addressing with linear probing */
+	for(probe = 0; probe < E4C_STATISTICS_SIZE; probe++){
 
-		e4c_uncaught_handler handler;
+		statistic = &table[ (hash + (unsigned long)probe) % (unsigned long)E4C_STATISTICS_SIZE ];
 
-		handler = context->uncaught_handler;
+		if(statistic->type == exception_type && statistic->line == line && statistic->file == file){
+			return(statistic);
+		}
 
-		if(handler != NULL){
-			/* TODO: find the proper way to make Splint happy */
-			/*@-noeffectuncon@*/
-			handler(exception);
-			/*@=noeffectuncon@*/
+		if(statistic->type == NULL){
+			/* (the type is set last, since it marks the element as used) */
+			statistic->file	= file;
+			statistic->line	= line;
+			MEMORY_BARRIER("_e4c_statistics_find_in")
+			statistic->type	= exception_type;
+			return(statistic);
 		}
 	}
-}
 
-void e4c_context_set_handlers(e4c_uncaught_handler uncaught_handler, void * custom_data, e4c_initialize_handler initialize_handler, e4c_finalize_handler finalize_handler){
+	return(NULL);
+}
 
-	e4c_context * context;
+static int _e4c_statistics_merge(e4c_statistic * statistics, int capacity, int count, const e4c_statistic * table){
 
-	context = E4C_CONTEXT;
+	const e4c_statistic *	source;
+	e4c_statistic *			target;
+	int						index;
 
-	/* ensure that `e4c_context_set_handlers` was called after calling `e4c_context_begin` */
-	if(context != NULL){
+	for(source = table; source <= &table[E4C_STATISTICS_SIZE]; source++){
 
-		context->uncaught_handler	= uncaught_handler;
-		context->custom_data		= custom_data;
-		context->initialize_handler	= initialize_handler;
-		context->finalize_handler	= finalize_handler;
+		/* skip unused elements (but not the last one) */
+		if(source->type == NULL && source != &table[E4C_STATISTICS_SIZE]){
+			continue;
+		}
 
-	}else{
+		/* (the site of a used element was set before its type) */
+		MEMORY_BARRIER("_e4c_statistics_merge")
 
-		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_set_handlers: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
-	}
-}
+		for(index = 0, target = NULL; index < count; index++){
+			if(statistics[index].type == source->type && statistics[index].line == source->line && statistics[index].file == source->file){
+				target = &statistics[index];
+				break;
+			}
+		}
 
-void e4c_context_set_signal_mappings(const e4c_signal_mapping * mappings){
+		if(target == NULL){
 
-	e4c_context * context;
+			if(count >= capacity || source->thrown + source->caught + source->retried + source->reacquired + source->uncaught == 0UL){
+				continue;
+			}
 
-	context = E4C_CONTEXT;
+			target				= &statistics[count++];
+			target->type		= source->type;
+			target->file		= source->file;
+			target->line		= source->line;
+			target->thrown		= 0UL;
+			target->caught		= 0UL;
+			target->retried		= 0UL;
+			target->reacquired	= 0UL;
+			target->uncaught	= 0UL;
+		}
 
-	/* check if `e4c_context_set_signal_mappings` was called before calling `e4c_context_begin` */
-	if(context == NULL){
-		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_set_signal_mappings: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
-		E4C_UNREACHABLE_VOID_RETURN;
+		target->thrown		+= source->thrown;
+		target->caught		+= source->caught;
+		target->retried		+= source->retried;
+		target->reacquired	+= source->reacquired;
+		target->uncaught	+= source->uncaught;
 	}
 
-	_e4c_context_set_signal_handlers(context, mappings);
+	return(count);
 }
 
-const e4c_signal_mapping * e4c_context_get_signal_mappings(void){
+static void _e4c_statistics_retire(e4c_context * context){
+
+	e4c_statistic *	table;
+	e4c_statistic *	source;
+	e4c_statistic *	target;
+	e4c_latency *	latencies;
+	e4c_latency *	from;
+	e4c_latency *	to;
+	int				status;
+	int				bucket;
+
+	/* the exceptions that outlive this context are no longer counted by it */
+	if(context->live_exceptions != 0L){
+		FOREIGN_EXCEPTIONS_ADD(context->live_exceptions, "_e4c_statistics_retire")
+		context->live_exceptions = 0L;
+	}
 
-	e4c_context * context;
+	table		= context->statistics;
+	latencies	= context->latencies;
 
-	context = E4C_CONTEXT;
+	if(table == NULL && latencies == NULL){
+		return;
+	}
 
-	/* ensure that `e4c_context_get_signal_mappings` was called after calling `e4c_context_begin` */
-	if(context != NULL){
+	/* keep the counters of this context once it ends */
+	MUTEX_LOCK(environment_collection_mutex, "_e4c_statistics_retire")
 
-		return(context->signal_mappings);
-	}
+		for(source = table; source != NULL && source <= &table[E4C_STATISTICS_SIZE]; source++){
 
-	MISUSE_ERROR(ContextHasNotBegunYet, "e4c_context_get_signal_mappings: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
-	E4C_UNREACHABLE_RETURN(NULL);
-}
+			if(source == &table[E4C_STATISTICS_SIZE]){
+				target = &retired_statistics[E4C_STATISTICS_SIZE];
+			}else if(source->type != NULL){
+				target = _e4c_statistics_find_in(retired_statistics, source->type, source->file, source->line);
+				if(target == NULL){
+					target = &retired_statistics[E4C_STATISTICS_SIZE];
+				}
+			}else{
+				continue;
+			}
 
-E4C_BOOL e4c_context_is_ready(void){
+			target->thrown		+= source->thrown;
+			target->caught		+= source->caught;
+			target->retried		+= source->retried;
+			target->reacquired	+= source->reacquired;
+			target->uncaught	+= source->uncaught;
+		}
 
-	return(E4C_CONTEXT != NULL);
-}
+		for(from = latencies; from != NULL && from <= &latencies[E4C_LATENCY_SIZE]; from++){
 
-/* FRAME
- ================================================================ */
+			if(from == &latencies[E4C_LATENCY_SIZE]){
+				to = &retired_latencies[E4C_LATENCY_SIZE];
+			}else if(IS_LATENCY_USED(from)){
+				to = _e4c_latency_find_in(retired_latencies, from->file, from->line);
+				if(to == NULL){
+					to = &retired_latencies[E4C_LATENCY_SIZE];
+				}
+			}else{
+				continue;
+			}
 
-e4c_continuation * e4c_frame_first_stage_(e4c_frame_stage stage, const char * file, int line, const char * function){
+			for(status = (int)e4c_succeeded; status <= (int)e4c_failed; status++){
+				to->count[status] += from->count[status];
+				for(bucket = 0; bucket < E4C_LATENCY_BUCKETS; bucket++){
+					to->buckets[status][bucket] += from->buckets[status][bucket];
+				}
+			}
+		}
 
-	e4c_context *	context;
-	e4c_frame *		current_frame;
-	e4c_frame *		new_frame;
+		/* (no other thread will read the tables from now on) */
+		context->statistics	= NULL;
+		context->latencies	= NULL;
+
+	MUTEX_UNLOCK(environment_collection_mutex, "_e4c_statistics_retire")
 
-	context = E4C_CONTEXT;
+	free(table);
+	free(latencies);
+}
 
-	/* check if 'try' was used before calling e4c_context_begin */
-	if(context == NULL){
-		if(stage == e4c_beginning_){
-			MISUSE_ERROR(ContextHasNotBegunYet, "E4C_WITH: " DESC_NOT_BEGUN_YET, file, line, function);
+static void _e4c_latency_record(e4c_context * context, const e4c_frame * frame, e4c_status status){
+
+	e4c_latency *	latency;
+	e4c_latency *	table;
+	long			seconds;
+	long			nanoseconds;
+	int				bucket;
+
+	/* the table is allocated when the first block is measured */
+	if(context->latencies == NULL){
+		table = calloc( (size_t)E4C_LATENCY_SIZE + 1, sizeof(e4c_latency) );
+		if(table != NULL){
+			/* (other threads may read the table as soon as it is published) */
+			MEMORY_BARRIER("_e4c_latency_record")
+			context->latencies = table;
 		}
-		MISUSE_ERROR(ContextHasNotBegunYet, "E4C_TRY: " DESC_NOT_BEGUN_YET, file, line, function);
-		E4C_UNREACHABLE_RETURN(NULL);
 	}
 
-	current_frame = context->current_frame;
-
-	/* check if the current frame is NULL (very unlikely) */
-	PREVENT_FUNC(current_frame == NULL, DESC_INVALID_FRAME, "e4c_frame_first_stage_", NULL);
+	if(context->latencies == NULL){
+		/* (measuring is not worth a fatal error) */
+		latency = &lost_latency;
+	}else{
+		latency = _e4c_latency_find_in(context->latencies, frame->file, frame->line);
+		/* (the last element measures the sites that do not fit in the table) */
+		if(latency == NULL){
+			latency = &context->latencies[E4C_LATENCY_SIZE];
+		}
+	}
 
-	/* create a new frame */
-	new_frame = _e4c_frame_allocate(__LINE__, "e4c_frame_first_stage_");
+	_e4c_context_monotonic_time(&seconds, &nanoseconds);
 
-	_e4c_frame_initialize(new_frame, current_frame, stage);
+	seconds		-= frame->started_seconds;
+	nanoseconds	-= frame->started_nanoseconds;
+	if(nanoseconds < 0L){
+		seconds--;
+		nanoseconds += 1000000000L;
+	}
 
-	/* make it the new current frame */
-	context->current_frame = new_frame;
+	bucket = e4c_latency_bucket(seconds, nanoseconds);
 
-	return( &(new_frame->continuation) );
+	latency->count[status]++;
+	latency->buckets[status][bucket]++;
 }
 
-static E4C_INLINE void _e4c_frame_initialize(e4c_frame * frame, e4c_frame * previous, e4c_frame_stage stage){
+static E4C_INLINE e4c_latency * _e4c_latency_find_in(e4c_latency * table, const char * file, int line){
 
-	frame->previous				= previous;
-	frame->stage				= stage;
-	frame->uncaught				= E4C_FALSE;
-	frame->reacquire_attempts	= 0;
-	frame->retry_attempts		= 0;
-	frame->thrown_exception		= NULL;
+	e4c_latency *	latency;
+	unsigned long	hash;
+	int				probe;
 
-	/* jmp_buf is an implementation-defined type */
-}
+	hash = (unsigned long)line * 31UL + (unsigned long)(size_t)file;
 
-static E4C_INLINE e4c_frame * _e4c_frame_allocate(int line, const char * function){
+	/* open addressing with linear probing */
+	for(probe = 0; probe < E4C_LATENCY_SIZE; probe++){
 
-	e4c_frame * frame;
+		latency = &table[ (hash + (unsigned long)probe) % (unsigned long)E4C_LATENCY_SIZE ];
 
-	/* (using calloc instead of malloc so that jmp_buf is initialized to zero) */
-	frame = calloc( (size_t)1, sizeof(*frame) );
+		if( !IS_LATENCY_USED(latency) ){
+			/* (the element will be marked as used by the first count) */
+			latency->file	= file;
+			latency->line	= line;
+			MEMORY_BARRIER("_e4c_latency_find_in")
+			return(latency);
+		}
 
-	if(frame == NULL){
-		MEMORY_ERROR(DESC_MALLOC_FRAME, line, function);
-		E4C_UNREACHABLE_RETURN(NULL);
+		if(latency->line == line && latency->file == file){
+			return(latency);
+		}
 	}
 
-	return(frame);
+	return(NULL);
 }
 
-static E4C_INLINE void _e4c_frame_deallocate(e4c_frame * frame, e4c_finalize_handler finalize_handler){
+static int _e4c_latency_merge(e4c_latency * latencies, int capacity, int count, const e4c_latency * table){
 
-	if(frame != NULL){
+	const e4c_latency *	source;
+	e4c_latency *		target;
+	int					index;
+	int					status;
+	int					bucket;
 
-		/* delete previous frame */
-		_e4c_frame_deallocate(frame->previous, finalize_handler);
-		frame->previous = NULL;
+	for(source = table; source <= &table[E4C_LATENCY_SIZE]; source++){
 
-		/* delete thrown exception */
-		_e4c_exception_deallocate(frame->thrown_exception, finalize_handler);
-		frame->thrown_exception = NULL;
+		if( !IS_LATENCY_USED(source) ){
+			continue;
+		}
 
-		free(frame);
+		/* (the site of a used element was set before its first count) */
+		MEMORY_BARRIER("_e4c_latency_merge")
+
+		for(index = 0, target = NULL; index < count; index++){
+			if(latencies[index].line == source->line && latencies[index].file == source->file){
+				target = &latencies[index];
+				break;
+			}
+		}
+
+		if(target == NULL){
+
+			if(count >= capacity){
+				continue;
+			}
+
+			target			= &latencies[count++];
+			target->file	= source->file;
+			target->line	= source->line;
+			for(status = (int)e4c_succeeded; status <= (int)e4c_failed; status++){
+				target->count[status] = 0UL;
+				for(bucket = 0; bucket < E4C_LATENCY_BUCKETS; bucket++){
+					target->buckets[status][bucket] = 0UL;
+				}
+			}
+		}
+
+		for(status = (int)e4c_succeeded; status <= (int)e4c_failed; status++){
+			target->count[status] += source->count[status];
+			for(bucket = 0; bucket < E4C_LATENCY_BUCKETS; bucket++){
+				target->buckets[status][bucket] += source->buckets[status][bucket];
+			}
+		}
 	}
+
+	return(count);
 }
 
-e4c_frame_stage e4c_frame_get_stage_(const char * file, int line, const char * function){
+# endif
 
-	e4c_context * context;
+int e4c_get_statistics(e4c_statistic * statistics, int capacity){
 
-	context = E4C_CONTEXT;
+	int					count		= 0;
+# if defined(E4C_STATISTICS) && defined(E4C_THREADSAFE)
+	e4c_environment *	environment;
+# endif
 
-	/* check if 'e4c_frame_get_stage_' was used before calling e4c_context_begin */
-	if(context == NULL){
-		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_frame_get_stage_: " DESC_NOT_BEGUN_YET, file, line, function);
-		E4C_UNREACHABLE_RETURN(e4c_done_);
+	if(statistics == NULL){
+		e4c_exception_throw_verbatim_(&NullPointerException, E4C_INFO_FILE_, E4C_INFO_LINE_, "e4c_get_statistics", "Null statistics.");
 	}
 
-	/* check if the current frame is NULL (very unlikely) */
-	PREVENT_FUNC(context->current_frame == NULL, DESC_INVALID_FRAME, "e4c_frame_get_stage_", e4c_done_);
+# ifdef E4C_STATISTICS
 
-	return(context->current_frame->stage);
-}
+	MUTEX_LOCK(environment_collection_mutex, "e4c_get_statistics")
 
-E4C_BOOL e4c_frame_catch_(const e4c_exception_type * exception_type, const char * file, int line, const char * function){
+		count = _e4c_statistics_merge(statistics, capacity, count, retired_statistics);
 
-	e4c_context *	context;
-	e4c_frame *		frame;
+#	ifdef E4C_THREADSAFE
+		FOREACH(environment, environment_collection){
+			if(environment->context.statistics != NULL){
+				count = _e4c_statistics_merge(statistics, capacity, count, environment->context.statistics);
+			}
+		}
+#	else
+		if(current_context != NULL && current_context->statistics != NULL){
+			count = _e4c_statistics_merge(statistics, capacity, count, current_context->statistics);
+		}
+#	endif
 
-	context = E4C_CONTEXT;
+	MUTEX_UNLOCK(environment_collection_mutex, "e4c_get_statistics")
 
-	/* ensure that 'e4c_frame_catch_' was used after calling e4c_context_begin */
-	if(context != NULL){
+# else
 
-		frame = context->current_frame;
+	/* (nothing is counted) */
+	(void)capacity;
 
-		/* check if the current frame is NULL (very unlikely) */
-		PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_catch_", E4C_FALSE);
+# endif
 
-		if(frame->stage != e4c_catching_){
-			return(E4C_FALSE);
-		}
+	return(count);
+}
 
-		/* passing NULL to a catch block is considered a fatal error */
-		if(exception_type == NULL){
-			MISUSE_ERROR(NullPointerException, "E4C_CATCH: " DESC_CATCH_NULL, file, line, function);
-			E4C_UNREACHABLE_RETURN(E4C_FALSE);
-		}
+int e4c_get_latencies(e4c_latency * latencies, int capacity){
 
-		/* check if the thrown exception is NULL (very unlikely) */
-		PREVENT_FUNC(frame->thrown_exception == NULL, DESC_INVALID_STATE, "e4c_frame_catch_", E4C_FALSE);
+	int					count		= 0;
+# if defined(E4C_STATISTICS) && defined(E4C_THREADSAFE)
+	e4c_environment *	environment;
+# endif
 
-		/* check if the exception type is NULL (very unlikely) */
-		PREVENT_FUNC(frame->thrown_exception->type == NULL, DESC_INVALID_STATE, "e4c_frame_catch_", E4C_FALSE);
+	if(latencies == NULL){
+		e4c_exception_throw_verbatim_(&NullPointerException, E4C_INFO_FILE_, E4C_INFO_LINE_, "e4c_get_latencies", "Null latencies.");
+	}
 
-		/* assert: thrown_exception is catchable (otherwise we would have skipped the "catching" stage in e4c_frame_next_stage_) */
+# ifdef E4C_STATISTICS
 
-		/* does this block catch current exception? */
-		if(	frame->thrown_exception->type == exception_type || _e4c_exception_type_extends(frame->thrown_exception->type, exception_type) ){
+	MUTEX_LOCK(environment_collection_mutex, "e4c_get_latencies")
 
-			/* yay, catch current exception by executing the handler */
-			frame->uncaught = E4C_FALSE;
+		count = _e4c_latency_merge(latencies, capacity, count, retired_latencies);
 
-			return(E4C_TRUE);
+#	ifdef E4C_THREADSAFE
+		FOREACH(environment, environment_collection){
+			if(environment->context.latencies != NULL){
+				count = _e4c_latency_merge(latencies, capacity, count, environment->context.latencies);
+			}
+		}
+#	else
+		if(current_context != NULL && current_context->latencies != NULL){
+			count = _e4c_latency_merge(latencies, capacity, count, current_context->latencies);
 		}
+#	endif
 
-		/* nay, keep looking for an exception handler */
-		return(E4C_FALSE);
-	}
+	MUTEX_UNLOCK(environment_collection_mutex, "e4c_get_latencies")
 
-	MISUSE_ERROR(ContextHasNotBegunYet, "e4c_frame_catch_: " DESC_NOT_BEGUN_YET, file, line, function);
-	E4C_UNREACHABLE_RETURN(E4C_FALSE);
+# else
+
+	/* (nothing is measured) */
+	(void)capacity;
+
+# endif
+
+	return(count);
 }
 
-E4C_BOOL e4c_frame_next_stage_(void){
+int e4c_latency_bucket(long seconds, long nanoseconds){
 
-	e4c_context *	context;
-	e4c_frame *		frame;
-	e4c_frame *		previous;
-	e4c_exception *	thrown_exception;
+	unsigned long	duration;
+	int				bucket;
 
-	context = E4C_CONTEXT;
+	/* (the nanoseconds may be out of range) */
+	seconds		+= nanoseconds / 1000000000L;
+	nanoseconds	%= 1000000000L;
+	if(nanoseconds < 0L){
+		seconds--;
+		nanoseconds += 1000000000L;
+	}
 
-	/* check if the current exception context is NULL (unlikely) */
-	PREVENT_FUNC(context == NULL, DESC_NOT_BEGUN_YET, "e4c_frame_next_stage_", E4C_FALSE);
+	if(seconds < 0L){
+		/* (the clock went backwards) */
+		return(0);
+	}
 
-	frame = context->current_frame;
+	if(seconds >= 4L){
+		/* (the duration would overflow a 32-bit number of nanoseconds) */
+		return(E4C_LATENCY_BUCKETS - 1);
+	}
 
-	/* check if the current frame is NULL (very unlikely) */
-	PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_next_stage_", E4C_FALSE);
+	duration = (unsigned long)seconds * 1000000000UL + (unsigned long)nanoseconds;
 
-	frame->stage++;
+	if(duration < 2UL){
+		return( (int)duration );
+	}
 
-	/* simple optimization */
-	if(  frame->stage == e4c_catching_  &&  ( !frame->uncaught || (frame->thrown_exception == NULL) || IS_UNCATCHABLE(frame->thrown_exception) )  ){
-		/* if no exception was thrown, or if the thrown exception cannot be
-			caught, we don't need to go through the "catching" stage */
-		frame->stage++;
+	/* two linear buckets per power of two */
+	for(bucket = 0; (duration >> bucket) > 1UL; bucket++){
+		/* (find the most significant bit) */
 	}
+	bucket = 2 * bucket + (int)( (duration >> (bucket - 1)) & 1UL );
 
-	/* keep looping until we reach the "done" stage */
-	if(frame->stage < e4c_done_){
-		return(E4C_TRUE);
+	if(bucket >= E4C_LATENCY_BUCKETS){
+		bucket = E4C_LATENCY_BUCKETS - 1;
 	}
 
-	/* check if the previous frame is NULL (unlikely) */
-	PREVENT_FUNC(frame->previous == NULL, DESC_INVALID_FRAME, "e4c_frame_next_stage_", E4C_FALSE);
+	return(bucket);
+}
 
-	/* the exception loop is finished */
+void e4c_get_live_objects(long * frames, long * exceptions){
 
-	/* deallocate caught exception */
-	if(frame->thrown_exception != NULL && !frame->uncaught){
-		_e4c_exception_deallocate(frame->thrown_exception, context->finalize_handler);
-		frame->thrown_exception = NULL;
-	}
+	long				live_frames			= 0L;
+	long				live_exceptions		= 0L;
+# if defined(E4C_STATISTICS) && defined(E4C_THREADSAFE)
+	e4c_environment *	environment;
+# endif
 
-	/* capture temporarily the information of the current frame */
-	/* so we can propagate an exception (if it was thrown) */
-	previous			= frame->previous;
-	thrown_exception	= frame->thrown_exception;
+# ifdef E4C_STATISTICS
 
-	/* modify the current frame so that previous and thrown_exception don't get deallocated */
-	frame->previous			= NULL;
-	frame->thrown_exception = NULL;
+	MUTEX_LOCK(environment_collection_mutex, "e4c_get_live_objects")
 
-	/* delete the current frame */
-	_e4c_frame_deallocate(frame, context->finalize_handler);
+#	ifdef E4C_THREADSAFE
+		FOREACH(environment, environment_collection){
+			live_frames		+= environment->context.live_frames;
+			live_exceptions	+= environment->context.live_exceptions;
+		}
+#	else
+		if(current_context != NULL){
+			live_frames		+= current_context->live_frames;
+			live_exceptions	+= current_context->live_exceptions;
+		}
+#	endif
 
-	/* promote the previous frame to the current one */
-	context->current_frame = previous;
+	MUTEX_UNLOCK(environment_collection_mutex, "e4c_get_live_objects")
 
-	/* if the current frame has an uncaught exception, then we will propagate it */
-	if(thrown_exception != NULL){
-		_e4c_context_propagate(context, thrown_exception);
+	/* merge the exceptions that are not counted by any context */
+	live_exceptions += foreign_exceptions;
+
+# endif
+
+	if(frames != NULL){
+		*frames = live_frames;
 	}
-	/* otherwise, we're free to go */
 
-	/* get out of the exception loop */
-	return(E4C_FALSE);
+	if(exceptions != NULL){
+		*exceptions = live_exceptions;
+	}
 }
 
-void e4c_frame_repeat_(int max_repeat_attempts, e4c_frame_stage stage, const char * file, int line, const char * function){
+/* TEXT
+ ================================================================ */
 
-	e4c_context *		context;
-	e4c_frame *			frame;
+static size_t _e4c_text_append(char * buffer, size_t size, size_t length, const char * text){
 
-	/* get the current context */
-	context = E4C_CONTEXT;
+	/* assert: buffer != NULL */
+	/* assert: size > 0 */
+	/* assert: length < size */
 
-	/* check if 'e4c_frame_repeat_' was used before calling e4c_context_begin */
-	if(context == NULL){
-		if(stage == e4c_beginning_){
-			MISUSE_ERROR(ContextHasNotBegunYet, "E4C_REACQUIRE: " DESC_NOT_BEGUN_YET, file, line, function);
+	if(text != NULL){
+		/* (there must always be room for the null character) */
+		while(*text != '\0' && length + 1 < size){
+			buffer[length++] = *text++;
 		}
-		MISUSE_ERROR(ContextHasNotBegunYet, "E4C_RETRY: " DESC_NOT_BEGUN_YET, file, line, function);
-		E4C_UNREACHABLE_VOID_RETURN;
 	}
 
-	/* get the current frame */
-	frame = context->current_frame;
+	buffer[length] = '\0';
 
-	/* check if the current frame is NULL (unlikely) */
-	PREVENT_PROC(frame == NULL, DESC_INVALID_FRAME, "e4c_frame_repeat_");
+	return(length);
+}
 
-	/* check if 'e4c_frame_repeat_' was used before 'try' or 'use' */
-	if( IS_TOP_FRAME(frame) ){
-		if(stage == e4c_beginning_){
-			MISUSE_ERROR(ExceptionSystemFatalError, "E4C_REACQUIRE: " DESC_CANNOT_REACQUIRE, file, line, function);
-		}
-		MISUSE_ERROR(ExceptionSystemFatalError, "E4C_RETRY: " DESC_CANNOT_RETRY, file, line, function);
-		E4C_UNREACHABLE_VOID_RETURN;
-	}
+static size_t _e4c_text_append_number(char * buffer, size_t size, size_t length, int number){
 
-	/* check if "uncatchable" exception */
-	if( frame->uncaught && (frame->thrown_exception != NULL) && IS_UNCATCHABLE(frame->thrown_exception) ){
-		return;
+	if(number < 0){
+		length = _e4c_text_append(buffer, size, length, "-");
+		return( _e4c_text_append_unsigned(buffer, size, length, 0UL - (unsigned long)number, 1) );
 	}
 
-	/* check if maximum number of attempts reached and update the number of attempts */
-	switch(stage){
+	return( _e4c_text_append_unsigned(buffer, size, length, (unsigned long)number, 1) );
+}
 
-		case e4c_beginning_:
-			/* reacquire */
-			if(frame->reacquire_attempts >= max_repeat_attempts){
-				return;
-			}
-			frame->reacquire_attempts++;
-			/*@switchbreak@*/ break;
+static size_t _e4c_text_append_unsigned(char * buffer, size_t size, size_t length, unsigned long number, int digits){
 
-		case e4c_acquiring_:
-			/* retry */
-			if(frame->retry_attempts >= max_repeat_attempts){
-				return;
-			}
-			frame->retry_attempts++;
-			/*@switchbreak@*/ break;
+	char	text[24];
+	int		index		= (int)sizeof(text) - 1;
 
-		case e4c_trying_:
-		case e4c_disposing_:
-		case e4c_catching_:
-		case e4c_finalizing_:
-		case e4c_done_:
-		default:
-			MISUSE_ERROR(ExceptionSystemFatalError, "e4c_frame_repeat: " DESC_CANNOT_REPEAT, file, line, function);
-			E4C_UNREACHABLE_VOID_RETURN;
-	}
+	text[index] = '\0';
 
-	/* deallocate previously thrown exception */
-	_e4c_exception_deallocate(frame->thrown_exception, context->finalize_handler);
+	/* (leading zeros are added until the minimum number of digits is reached) */
+	do{
+		text[--index] = (char)( '0' + (int)(number % 10UL) );
+		number /= 10UL;
+	}while( number > 0UL || ( (int)sizeof(text) - 1 - index < digits && index > 0 ) );
 
-	/* reset exception information */
-	frame->thrown_exception	= NULL;
-	frame->uncaught			= E4C_FALSE;
-	frame->stage			= stage;
+	return( _e4c_text_append(buffer, size, length, text + index) );
+}
 
-	/* keep looping */
-	E4C_CONTINUE(frame->continuation);
+static size_t _e4c_text_append_padding(char * buffer, size_t size, size_t length, int count){
+
+	while(count-- > 0 && length + 1 < size){
+		buffer[length++] = ' ';
+	}
+
+	buffer[length] = '\0';
+
+	return(length);
 }
 
-e4c_status e4c_get_status(void){
+static size_t _e4c_text_append_json(char * buffer, size_t size, size_t length, const char * text){
+
+	const char *	hex		= "0123456789abcdef";
+	char			escaped[7];
+	unsigned char	character;
+
+	if(text == NULL){
+		return( _e4c_text_append(buffer, size, length, "null") );
+	}
+
+	length = _e4c_text_append(buffer, size, length, "\"");
+
+	for(; *text != '\0'; text++){
+
+		character = (unsigned char)*text;
+
+		if(character == (unsigned char)'"' || character == (unsigned char)'\\'){
+			escaped[0] = '\\';
+			escaped[1] = (char)character;
+			escaped[2] = '\0';
+		}else if(character < (unsigned char)' '){
+			/* control characters are escaped as unicode code points */
+			escaped[0] = '\\';
+			escaped[1] = 'u';
+			escaped[2] = '0';
+			escaped[3] = '0';
+			escaped[4] = hex[character >> 4];
+			escaped[5] = hex[character & 0x0F];
+			escaped[6] = '\0';
+		}else{
+			escaped[0] = (char)character;
+			escaped[1] = '\0';
+		}
 
-	e4c_context *	context;
-	e4c_frame *		frame;
+		length = _e4c_text_append(buffer, size, length, escaped);
+	}
 
-	context = E4C_CONTEXT;
+	return( _e4c_text_append(buffer, size, length, "\"") );
+}
 
-	/* ensure that `e4c_get_status` was called after calling `e4c_context_begin` */
-	if(context != NULL){
+static void _e4c_text_write(const char * text, size_t length){
 
-		frame = context->current_frame;
+# ifdef WRITE_TO_STDERR
 
-		/* check if the current frame is NULL (very unlikely) */
-		PREVENT_FUNC(frame == NULL, DESC_INVALID_FRAME, "e4c_get_status", e4c_failed);
+	ssize_t written;
 
-		if(frame->thrown_exception == NULL){
-			return(e4c_succeeded);
-		}
+	/* (a single call is expected, unless it gets interrupted) */
+	while(length > 0){
 
-		if(frame->uncaught){
-			return(e4c_failed);
+		written = write(STDERR_FILENO, text, length);
+
+		if(written < 0){
+			if(errno == EINTR){
+				continue;
+			}
+			return;
 		}
 
-		return(e4c_recovered);
+		text	+= written;
+		length	-= (size_t)written;
 	}
 
-	MISUSE_ERROR(ContextHasNotBegunYet, "e4c_get_status: " DESC_NOT_BEGUN_YET, NULL, 0, NULL);
-	E4C_UNREACHABLE_RETURN(e4c_failed);
+# else
+
+	(void)fwrite(text, (size_t)1, length, stderr);
+
+	(void)fflush(stderr);
+
+# endif
 }
 
 /* EXCEPTION TYPE
@@ -3449,44 +7126,81 @@ E4C_BOOL e4c_is_instance_of(const e4c_exception * instance, const e4c_exception_
 	return( _e4c_exception_type_extends(instance->type, exception_type) );
 }
 
-static E4C_INLINE int _e4c_print_exception_type_node(const e4c_exception_type * exception_type){
+int e4c_map_exception(const e4c_error_mapping * mappings, const e4c_exception * exception){
+
+	if(mappings == NULL){
+		e4c_exception_throw_verbatim_(&NullPointerException, E4C_INFO_FILE_, E4C_INFO_LINE_, "e4c_map_exception", "Null error mappings.");
+	}
+
+	/* loop until we find a matching mapping or the default one */
+	while(mappings->exception_type != NULL && !e4c_is_instance_of(exception, mappings->exception_type) ){
+		mappings++;
+	}
+
+	if(mappings->error_number != 0){
+		errno = mappings->error_number;
+	}
+
+	return(mappings->error_code);
+}
 
-	int deep = -1;
+static size_t _e4c_format_exception_type_node(char * buffer, size_t size, size_t length, const e4c_exception_type * exception_type, int * deep){
 
 	if(exception_type->supertype == NULL || exception_type->supertype == exception_type){
 
-		fprintf(stderr, "    %s\n", exception_type->name);
+		*deep = 0;
+
+		length = _e4c_text_append(buffer, size, length, "    ");
+		length = _e4c_text_append(buffer, size, length, exception_type->name);
+		length = _e4c_text_append(buffer, size, length, "\n");
 
 	}else{
 
-		deep = _e4c_print_exception_type_node(exception_type->supertype);
+		length = _e4c_format_exception_type_node(buffer, size, length, exception_type->supertype, deep);
 
-		fprintf(stderr, "    %*s |\n    %*s +--%s\n", deep * 4, "", deep * 4, "", exception_type->name);
+		length = _e4c_text_append(buffer, size, length, "    ");
+		length = _e4c_text_append_padding(buffer, size, length, *deep * 4);
+		length = _e4c_text_append(buffer, size, length, " |\n    ");
+		length = _e4c_text_append_padding(buffer, size, length, *deep * 4);
+		length = _e4c_text_append(buffer, size, length, " +--");
+		length = _e4c_text_append(buffer, size, length, exception_type->name);
+		length = _e4c_text_append(buffer, size, length, "\n");
+
+		(*deep)++;
 	}
 
-	return(deep + 1);
+	return(length);
 }
 
-static E4C_INLINE void _e4c_print_exception_type(const e4c_exception_type * exception_type){
+static size_t _e4c_format_exception_type(char * buffer, size_t size, size_t length, const e4c_exception_type * exception_type){
 
 	const char *	separator	= "________________________________________________________________";
+	int				deep;
+
+	length = _e4c_text_append(buffer, size, length, "Exception hierarchy\n");
+	length = _e4c_text_append(buffer, size, length, separator);
+	length = _e4c_text_append(buffer, size, length, "\n\n");
 
-	fprintf(stderr, "Exception hierarchy\n%s\n\n", separator);
+	length = _e4c_format_exception_type_node(buffer, size, length, exception_type, &deep);
 
-	(void)_e4c_print_exception_type_node(exception_type);
+	length = _e4c_text_append(buffer, size, length, separator);
+	length = _e4c_text_append(buffer, size, length, "\n");
 
-	fprintf(stderr, "%s\n", separator);
+	return(length);
 }
 
 void e4c_print_exception_type(const e4c_exception_type * exception_type){
 
+	char	buffer[E4C_PRINT_BUFFER_SIZE];
+	size_t	length;
+
 	if(exception_type == NULL){
 		e4c_exception_throw_verbatim_(&NullPointerException, E4C_INFO_FILE_, E4C_INFO_LINE_, "e4c_print_exception_type", "Null exception type.");
 	}
 
-	_e4c_print_exception_type(exception_type);
+	length = _e4c_format_exception_type(buffer, sizeof(buffer), 0, exception_type);
 
-	(void)fflush(stderr);
+	_e4c_text_write(buffer, length);
 }
 
 /* EXCEPTION
@@ -3510,6 +7224,68 @@ const e4c_exception * e4c_get_exception(void){
 	return(context->current_frame->thrown_exception);
 }
 
+const e4c_exception * e4c_exception_retain(const e4c_exception * exception){
+
+	if(exception != NULL){
+		/* (the exception was allocated as non-const by the library itself) */
+		(void)REFERENCE_ADD( (e4c_exception *)exception, 1);
+	}
+
+	return(exception);
+}
+
+void e4c_exception_release(const e4c_exception * exception){
+
+	/* (no exception context needs to be active in the releasing thread) */
+	_e4c_exception_deallocate( (e4c_exception *)exception, E4C_EXISTING_CONTEXT);
+}
+
+void e4c_exception_rethrow_foreign_(const e4c_exception * exception, const char * file, int line, const char * function){
+
+	e4c_context *		context;
+	e4c_frame *			collector;
+	e4c_batch_error *	error;
+	e4c_exception *		foreign;
+
+	/* get the current context */
+	context = E4C_CONTEXT;
+
+	/* check if 'e4c_rethrow_foreign' was used before calling e4c_context_begin */
+	if(context == NULL){
+		MISUSE_ERROR(ContextHasNotBegunYet, "e4c_exception_rethrow_foreign_: " DESC_NOT_BEGUN_YET, file, line, function);
+		E4C_UNREACHABLE_VOID_RETURN;
+	}
+
+	if(exception == NULL){
+		e4c_exception_throw_verbatim_(&NullPointerException, file, line, function, "Null foreign exception.");
+	}
+
+	/* check if the current frame is NULL (unlikely) */
+	PREVENT_PROC(context->current_frame == NULL, DESC_INVALID_FRAME, "e4c_exception_rethrow_foreign_");
+
+	/* the reference handed over by the caller now belongs to this context */
+	foreign = (e4c_exception *)exception;
+
+	/* keep track of the exception, even if it is collected */
+	_e4c_context_record(context, foreign->type, file, line, function, foreign->error_number);
+
+	/* a batch will record the failure and release the exception */
+	collector = _e4c_context_find_collector(context, foreign->type);
+	if(collector != NULL){
+		error = _e4c_batch_add(collector->batch, foreign->type, foreign->file, foreign->line, foreign->function, foreign->error_number);
+		if(error != NULL){
+			VERBATIM_COPY(error->message, foreign->message);
+		}
+		_e4c_exception_deallocate(foreign, context);
+		_e4c_context_collect(context, collector);
+	}
+
+	PROBE_EXCEPTION(throw, context, foreign, file, line);
+
+	/* propagate the exception (and its causes) as is, up the call stack */
+	_e4c_context_dispatch(context, foreign);
+}
+
 static E4C_INLINE e4c_exception * _e4c_exception_throw(e4c_frame * frame, const e4c_exception_type * exception_type, const char * file, int line, const char * function, int error_number, E4C_BOOL set_message, const char * message){
 
 	e4c_exception *		new_exception;
@@ -3550,9 +7326,16 @@ static E4C_INLINE e4c_exception * _e4c_exception_throw(e4c_frame * frame, const
 
 void e4c_exception_throw_verbatim_(const e4c_exception_type * exception_type, const char * file, int line, const char * function, const char * message){
 
+	e4c_exception_throw_payload_(exception_type, file, line, function, message, NULL, (size_t)0);
+}
+
+void e4c_exception_throw_payload_(const e4c_exception_type * exception_type, const char * file, int line, const char * function, const char * message, const void * payload, size_t payload_size){
+
 	int					error_number;
 	e4c_context *		context;
 	e4c_frame *			frame;
+	e4c_frame *			collector;
+	e4c_batch_error *	error;
 	e4c_exception *		new_exception;
 
 	/* store the current error number up front */
@@ -3570,18 +7353,41 @@ void e4c_exception_throw_verbatim_(const e4c_exception_type * exception_type, co
 		/* check if the current frame is NULL (unlikely) */
 		PREVENT_PROC(frame == NULL, DESC_INVALID_FRAME, "e4c_exception_throw_verbatim_");
 
+		/* keep track of the exception, even if it is collected */
+		_e4c_context_record(context, exception_type, file, line, function, error_number);
+
+		/* a batch will record the failure without creating the exception */
+		collector = _e4c_context_find_collector(context, exception_type);
+		if(collector != NULL){
+			error = _e4c_batch_add(collector->batch, exception_type, file, line, function, error_number);
+			if(error != NULL){
+				VERBATIM_COPY(error->message, (message != NULL ? message : exception_type->default_message) );
+			}
+			_e4c_context_collect(context, collector);
+		}
+
 		/* check context and frame; initialize exception and cause */
 		new_exception = _e4c_exception_throw(frame, exception_type, file, line, function, error_number, E4C_TRUE, message);
 
+		/* copy the payload (the macros make sure that it fits) */
+		if(payload != NULL && payload_size > (size_t)0){
+			(void)memcpy(new_exception->payload.bytes, payload, (payload_size < sizeof(new_exception->payload) ? payload_size : sizeof(new_exception->payload) ) );
+		}
+
+		LIVE_EXCEPTION_CREATED(context, new_exception)
+
+		/* keep the chain of causes bounded */
+		_e4c_exception_limit_causes(new_exception, context);
+
+		PROBE_EXCEPTION(throw, context, new_exception, file, line);
+
 		/* set initial value for custom data */
 		new_exception->custom_data = context->custom_data;
 		/* initialize custom data */
-		if(context->initialize_handler != NULL){
-			new_exception->custom_data = context->initialize_handler(new_exception);
-		}
+		_e4c_exception_initialize_data(new_exception, context);
 
 		/* propagate the exception up the call stack */
-		_e4c_context_propagate(context, new_exception);
+		_e4c_context_dispatch(context, new_exception);
 	}
 
 	MISUSE_ERROR(ContextHasNotBegunYet, "e4c_exception_throw_verbatim_: " DESC_NOT_BEGUN_YET, file, line, function);
@@ -3594,6 +7400,8 @@ void e4c_exception_throw_format_(const e4c_exception_type * exception_type, cons
 	int					error_number;
 	e4c_context *		context;
 	e4c_frame *			frame;
+	e4c_frame *			collector;
+	e4c_batch_error *	error;
 	e4c_exception *		new_exception;
 
 	/* store the current error number up front */
@@ -3614,9 +7422,34 @@ void e4c_exception_throw_format_(const e4c_exception_type * exception_type, cons
 	/* check if the current frame is NULL (unlikely) */
 	PREVENT_PROC(frame == NULL, DESC_INVALID_FRAME, "e4c_exception_throw_format_");
 
+	/* keep track of the exception, even if it is collected */
+	_e4c_context_record(context, exception_type, file, line, function, error_number);
+
+	/* a batch will record the failure without creating the exception */
+	collector = _e4c_context_find_collector(context, exception_type);
+	if(collector != NULL){
+		error = _e4c_batch_add(collector->batch, exception_type, file, line, function, error_number);
+		if(error != NULL){
+			if(format != NULL){
+				va_list arguments_list;
+				va_start(arguments_list, format);
+				(void)vsnprintf(error->message, (size_t)E4C_EXCEPTION_MESSAGE_SIZE, format, arguments_list);
+				va_end(arguments_list);
+			}else{
+				VERBATIM_COPY(error->message, exception_type->default_message);
+			}
+		}
+		_e4c_context_collect(context, collector);
+	}
+
 	/* check context and frame; initialize exception and cause */
 	new_exception = _e4c_exception_throw(frame, exception_type, file, line, function, error_number, (format == NULL), NULL);
 
+	LIVE_EXCEPTION_CREATED(context, new_exception)
+
+	/* keep the chain of causes bounded */
+	_e4c_exception_limit_causes(new_exception, context);
+
 	/* format the message (only if feasible) */
 	if(format != NULL){
 		va_list arguments_list;
@@ -3625,15 +7458,15 @@ void e4c_exception_throw_format_(const e4c_exception_type * exception_type, cons
 		va_end(arguments_list);
 	}
 
+	PROBE_EXCEPTION(throw, context, new_exception, file, line);
+
 	/* set initial value for custom data */
 	new_exception->custom_data = context->custom_data;
 	/* initialize custom data */
-	if(context->initialize_handler != NULL){
-		new_exception->custom_data = context->initialize_handler(new_exception);
-	}
+	_e4c_exception_initialize_data(new_exception, context);
 
 	/* propagate the exception up the call stack */
-	_e4c_context_propagate(context, new_exception);
+	_e4c_context_dispatch(context, new_exception);
 }
 
 # endif
@@ -3668,6 +7501,94 @@ static E4C_INLINE void _e4c_exception_initialize(e4c_exception * exception, cons
 	 */
 }
 
+static void _e4c_exception_limit_causes(e4c_exception * exception, e4c_context * context){
+
+	e4c_exception *	last;
+	e4c_exception *	omitted;
+	e4c_exception *	summary;
+	e4c_exception *	cause;
+	long			count;
+	long			summarized;
+	int				depth;
+
+	/* find the oldest cause to be kept */
+	for(last = exception, depth = 0; depth < E4C_MAX_CAUSE_DEPTH && last->cause != NULL; depth++){
+		last = last->cause;
+	}
+
+	omitted = last->cause;
+
+	/* check if the chain is short enough, or already summarized */
+	if(omitted == NULL || (omitted->type == &OmittedCausesException && omitted->cause == NULL) ){
+		return;
+	}
+
+	/* check that the causes to be kept are not referenced elsewhere */
+	for(cause = exception->cause; cause != omitted; cause = cause->cause){
+		/* (the newest cause is also referenced by the frame that caught it) */
+		if(REFERENCE_ADD(cause, 0) > (cause == exception->cause ? 2 : 1) ){
+			/* (a shared chain is never modified; it will be limited once it is not) */
+			return;
+		}
+	}
+
+	/* (unless they were shared, chains are bounded, so there are only a few causes to count) */
+	for(count = 0L, cause = omitted; cause != NULL; cause = cause->cause){
+		if(cause->type == &OmittedCausesException){
+			(void)memcpy(&summarized, cause->payload.bytes, sizeof(summarized) );
+			count += summarized;
+		}else{
+			count++;
+		}
+	}
+
+	summary = _e4c_exception_allocate(__LINE__, "_e4c_exception_limit_causes");
+
+	_e4c_exception_initialize(summary, &OmittedCausesException, E4C_FALSE, NULL, omitted->file, omitted->line, omitted->function, 0);
+
+	(void)sprintf(summary->message, "%ld older causes were omitted.", count);
+	(void)memcpy(summary->payload.bytes, &count, sizeof(count) );
+
+	LIVE_EXCEPTION_CREATED(context, summary)
+
+	summary->custom_data = context->custom_data;
+	_e4c_exception_initialize_data(summary, context);
+
+	/* release the older causes (unless they are still referenced elsewhere) */
+	last->cause = summary;
+	_e4c_exception_deallocate(omitted, context);
+}
+
+static void _e4c_exception_initialize_data(e4c_exception * exception, e4c_context * context){
+
+	const e4c_type_handler *	type_handler;
+	e4c_initialize_handler		initialize_handler;
+	e4c_finalize_handler		finalize_handler;
+
+	initialize_handler	= context->initialize_handler;
+	finalize_handler	= context->finalize_handler;
+
+	/* the handlers of the type take precedence */
+	if(context->type_handlers != NULL){
+		type_handler = _e4c_context_find_type_handler(context, exception->type);
+		if(type_handler != NULL){
+			initialize_handler	= type_handler->initialize_handler;
+			finalize_handler	= type_handler->finalize_handler;
+			/* (the custom data of the context is not meant for opted-out types) */
+			if(initialize_handler == NULL){
+				exception->custom_data = NULL;
+			}
+		}
+	}
+
+	/* (the exception may be released by another thread, or another context) */
+	exception->_finalize = finalize_handler;
+
+	if(initialize_handler != NULL){
+		exception->custom_data = initialize_handler(exception);
+	}
+}
+
 static E4C_INLINE e4c_exception * _e4c_exception_allocate(int line, const char * function){
 
 	e4c_exception * exception;
@@ -3685,25 +7606,43 @@ static E4C_INLINE e4c_exception * _e4c_exception_allocate(int line, const char *
 	E4C_UNREACHABLE_RETURN(NULL);
 }
 
-static E4C_INLINE void _e4c_exception_deallocate(e4c_exception * exception, e4c_finalize_handler finalize_handler){
+static E4C_INLINE void _e4c_exception_deallocate(e4c_exception * exception, e4c_context * context){
 
-	if(exception != NULL){
+	e4c_exception *				cause;
 
-		exception->ref_count--;
+	/* (iterative, so that long chains of causes cannot overflow the stack) */
+	while(exception != NULL){
 
-		if(exception->ref_count <= 0){
+		if(REFERENCE_ADD(exception, -1) > 0){
+			/* the rest of the chain is still referenced */
+			break;
+		}
 
-			_e4c_exception_deallocate(exception->cause, finalize_handler);
+		cause = exception->cause;
 
-			if(finalize_handler != NULL){
-				/* TODO: find the proper way to make Splint happy */
-				/*@-noeffectuncon@*/
-				finalize_handler(exception->custom_data);
-				/*@=noeffectuncon@*/
-			}
+		/* (the handler was resolved by the context that created the exception) */
+		if(exception->_finalize != NULL){
+			/* TODO: find the proper way to make Splint happy */
+			/*@-noeffectuncon@*/
+			exception->_finalize(exception->custom_data);
+			/*@=noeffectuncon@*/
+		}
 
-			free(exception);
+# ifdef E4C_STATISTICS
+		/* (another thread, or another context, may release the exception) */
+		if(context != NULL && exception->_context == context){
+			context->live_exceptions--;
+		}else{
+			FOREIGN_EXCEPTIONS_ADD(-1L, "_e4c_exception_deallocate")
 		}
+# else
+		/* (nothing is counted) */
+		(void)context;
+# endif
+
+		free(exception);
+
+		exception = cause;
 	}
 }
 
@@ -3714,56 +7653,322 @@ static E4C_INLINE void _e4c_exception_set_cause(e4c_exception * exception, e4c_e
 
 	exception->cause = cause;
 
-	cause->ref_count++;
+	(void)REFERENCE_ADD(cause, 1);
+}
+
+# ifdef REFERENCE_MUTEX
+static int _e4c_exception_add_reference(e4c_exception * exception, int delta){
+
+	int count;
+
+	MUTEX_LOCK(reference_mutex, "_e4c_exception_add_reference")
+
+		exception->ref_count += delta;
+		count = exception->ref_count;
+
+	MUTEX_UNLOCK(reference_mutex, "_e4c_exception_add_reference")
+
+	return(count);
 }
+# endif
 
 static void _e4c_print_exception(const e4c_exception * exception){
 
+	char	buffer[E4C_PRINT_BUFFER_SIZE];
+	size_t	length;
+
 # ifdef NDEBUG
 
-	fprintf(stderr, "\n\nFatal Error: %s (%s)\n\n", exception->name, exception->message);
+	length = _e4c_text_append(buffer, sizeof(buffer), 0, "\n\nFatal Error: ");
+	length = _e4c_text_append(buffer, sizeof(buffer), length, exception->name);
+	length = _e4c_text_append(buffer, sizeof(buffer), length, " (");
+	length = _e4c_text_append(buffer, sizeof(buffer), length, exception->message);
+	length = _e4c_text_append(buffer, sizeof(buffer), length, ")\n\n");
 
 # else
 
+	length = _e4c_text_append(buffer, sizeof(buffer), 0, "\n\nUncaught ");
+
+	length = _e4c_format_exception(buffer, sizeof(buffer), length, exception, E4C_FORMAT_CAUSES | E4C_FORMAT_HIERARCHY);
+
+	/* checks whether this exception is fatal to the exception system (likely library misuse) */
+	if( e4c_is_instance_of(exception, &ExceptionSystemFatalError) ){
+
+		length = _e4c_text_append(buffer, sizeof(buffer), length, MSG_FATAL_ERROR);
+	}
+# endif
+
+	/* the whole report is printed out at once */
+	_e4c_text_write(buffer, length);
+}
+
+static size_t _e4c_format_exception(char * buffer, size_t size, size_t length, const e4c_exception * exception, int flags){
+
 	const e4c_exception * cause;
 
-	fprintf(stderr, "\n\nUncaught %s: %s\n\n", exception->name, exception->message);
+	length = _e4c_text_append(buffer, size, length, exception->name);
+	length = _e4c_text_append(buffer, size, length, ": ");
+	length = _e4c_text_append(buffer, size, length, exception->message);
+	length = _e4c_text_append(buffer, size, length, "\n\n");
+
+	length = _e4c_format_exception_site(buffer, size, length, exception);
+
+	if(flags & E4C_FORMAT_CAUSES){
+		cause = exception->cause;
+		while(cause != NULL){
+			length = _e4c_text_append(buffer, size, length, "Caused by ");
+			length = _e4c_text_append(buffer, size, length, cause->name);
+			length = _e4c_text_append(buffer, size, length, ": ");
+			length = _e4c_text_append(buffer, size, length, cause->message);
+			length = _e4c_text_append(buffer, size, length, "\n\n");
+			length = _e4c_format_exception_site(buffer, size, length, cause);
+			cause = cause->cause;
+		}
+	}
+
+	length = _e4c_text_append(buffer, size, length, "The value of errno was ");
+	length = _e4c_text_append_number(buffer, size, length, exception->error_number);
+	length = _e4c_text_append(buffer, size, length, ".\n\n");
+
+	if( (flags & E4C_FORMAT_HIERARCHY) && exception->type != NULL ){
+		length = _e4c_format_exception_type(buffer, size, length, exception->type);
+	}
+
+	return(length);
+}
+
+static size_t _e4c_format_exception_site(char * buffer, size_t size, size_t length, const e4c_exception * exception){
 
 	if(exception->file != NULL){
+		length = _e4c_text_append(buffer, size, length, "    thrown at ");
 		if(exception->function != NULL){
-			fprintf(stderr, "    thrown at %s (%s:%d)\n\n", exception->function, exception->file, exception->line);
+			length = _e4c_text_append(buffer, size, length, exception->function);
+			length = _e4c_text_append(buffer, size, length, " (");
+			length = _e4c_text_append(buffer, size, length, exception->file);
+			length = _e4c_text_append(buffer, size, length, ":");
+			length = _e4c_text_append_number(buffer, size, length, exception->line);
+			length = _e4c_text_append(buffer, size, length, ")\n\n");
 		}else{
-			fprintf(stderr, "    thrown at %s:%d\n\n", exception->file, exception->line);
+			length = _e4c_text_append(buffer, size, length, exception->file);
+			length = _e4c_text_append(buffer, size, length, ":");
+			length = _e4c_text_append_number(buffer, size, length, exception->line);
+			length = _e4c_text_append(buffer, size, length, "\n\n");
+		}
+	}
+
+	return(length);
+}
+
+size_t e4c_format_exception(char * buffer, size_t size, const e4c_exception * exception, int flags){
+
+	if(buffer == NULL){
+		e4c_exception_throw_verbatim_(&NullPointerException, E4C_INFO_FILE_, E4C_INFO_LINE_, "e4c_format_exception", "Null buffer.");
+	}
+
+	if(exception == NULL){
+		e4c_exception_throw_verbatim_(&NullPointerException, E4C_INFO_FILE_, E4C_INFO_LINE_, "e4c_format_exception", "Null exception.");
+	}
+
+	if(size == 0){
+		return(0);
+	}
+
+	return( _e4c_format_exception(buffer, size, 0, exception, flags) );
+}
+
+static size_t _e4c_format_exception_json(char * buffer, size_t size, size_t length, const e4c_exception * exception){
+
+	const e4c_exception_type *	type;
+
+	length = _e4c_text_append(buffer, size, length, "{\"name\":");
+	length = _e4c_text_append_json(buffer, size, length, exception->name);
+	length = _e4c_text_append(buffer, size, length, ",\"message\":");
+	length = _e4c_text_append_json(buffer, size, length, exception->message);
+	length = _e4c_text_append(buffer, size, length, ",\"file\":");
+	length = _e4c_text_append_json(buffer, size, length, exception->file);
+	length = _e4c_text_append(buffer, size, length, ",\"line\":");
+	length = _e4c_text_append_number(buffer, size, length, exception->line);
+	length = _e4c_text_append(buffer, size, length, ",\"function\":");
+	length = _e4c_text_append_json(buffer, size, length, exception->function);
+	length = _e4c_text_append(buffer, size, length, ",\"errno\":");
+	length = _e4c_text_append_number(buffer, size, length, exception->error_number);
+	length = _e4c_text_append(buffer, size, length, ",\"types\":[");
+
+	/* from the most specific type to the root of the hierarchy */
+	for(type = exception->type; type != NULL; type = (type->supertype == type ? NULL : type->supertype) ){
+		if(type != exception->type){
+			length = _e4c_text_append(buffer, size, length, ",");
 		}
+		length = _e4c_text_append_json(buffer, size, length, type->name);
+	}
+
+	return( _e4c_text_append(buffer, size, length, "]") );
+}
+
+void e4c_print_exception_json(const e4c_exception * exception){
+
+	/* (there must always be room enough to close the record) */
+	const size_t			reserve		= 4;
+	char					buffer[E4C_PRINT_BUFFER_SIZE];
+	size_t					length;
+	size_t					checkpoint;
+	const e4c_exception *	cause;
+
+	if(exception == NULL){
+		e4c_exception_throw_verbatim_(&NullPointerException, E4C_INFO_FILE_, E4C_INFO_LINE_, "e4c_print_exception_json", "Null exception.");
 	}
 
+	length = _e4c_format_exception_json(buffer, sizeof(buffer) - reserve, 0, exception);
+	length = _e4c_text_append(buffer, sizeof(buffer) - reserve, length, ",\"causes\":[");
+
+	/* fall back to a minimal record when the exception itself does not fit */
 	cause = exception->cause;
-	while(cause != NULL){
-		fprintf(stderr, "Caused by %s: %s\n\n", cause->name, cause->message);
-		if(cause->file != NULL){
-			if(cause->function != NULL){
-				fprintf(stderr, "    thrown at %s (%s:%d)\n\n", cause->function, cause->file, cause->line);
-			}else{
-				fprintf(stderr, "    thrown at %s:%d\n\n", cause->file, cause->line);
-			}
+	if(length + 1 >= sizeof(buffer) - reserve){
+		length = _e4c_text_append(buffer, sizeof(buffer) - reserve, 0, "{\"name\":");
+		length = _e4c_text_append_json(buffer, sizeof(buffer) - reserve, length, exception->name);
+		length = _e4c_text_append(buffer, sizeof(buffer) - reserve, length, ",\"truncated\":true,\"causes\":[");
+		if(length + 1 >= sizeof(buffer) - reserve){
+			length = _e4c_text_append(buffer, sizeof(buffer) - reserve, 0, "{\"name\":null,\"truncated\":true,\"causes\":[");
 		}
-		cause = cause->cause;
+		cause = NULL;
 	}
 
-	fprintf(stderr, "The value of errno was %d.\n\n", exception->error_number);
+	for(; cause != NULL; cause = cause->cause){
+
+		checkpoint = length;
+
+		if(cause != exception->cause){
+			length = _e4c_text_append(buffer, sizeof(buffer) - reserve, length, ",");
+		}
+		length = _e4c_format_exception_json(buffer, sizeof(buffer) - reserve, length, cause);
+		length = _e4c_text_append(buffer, sizeof(buffer) - reserve, length, "}");
 
-	if(exception->type != NULL){
-		_e4c_print_exception_type(exception->type);
+		/* drop the causes that do not fit */
+		if(length + 1 >= sizeof(buffer) - reserve){
+			length = checkpoint;
+			break;
+		}
 	}
 
-	/* checks whether this exception is fatal to the exception system (likely library misuse) */
-	if( e4c_is_instance_of(exception, &ExceptionSystemFatalError) ){
+	length = _e4c_text_append(buffer, sizeof(buffer), length, "]}\n");
+
+	_e4c_text_write(buffer, length);
+}
+
+static size_t _e4c_record_append(unsigned char * buffer, size_t size, size_t length, const unsigned char * data, size_t count){
 
-		fprintf(stderr, MSG_FATAL_ERROR);
+	/* (the length keeps growing past the size, so that overflows can be detected) */
+	for(; count > 0; count--, data++, length++){
+		if(length < size){
+			buffer[length] = *data;
+		}
 	}
-# endif
 
-	(void)fflush(stderr);
+	return(length);
+}
+
+static size_t _e4c_record_append_number(unsigned char * buffer, size_t size, size_t length, unsigned long number, int bytes){
+
+	unsigned char	data[4];
+	int				index;
+
+	/* numbers are stored in network byte order */
+	for(index = bytes - 1; index >= 0; index--){
+		data[index] = (unsigned char)(number & 0xFFUL);
+		number >>= 8;
+	}
+
+	return( _e4c_record_append(buffer, size, length, data, (size_t)bytes) );
+}
+
+static size_t _e4c_record_append_string(unsigned char * buffer, size_t size, size_t length, const char * text){
+
+	size_t count = 0;
+
+	if(text != NULL){
+		while(text[count] != '\0' && count < 0xFFFFUL){
+			count++;
+		}
+	}
+
+	length = _e4c_record_append_number(buffer, size, length, (unsigned long)count, 2);
+
+	return( count == 0 ? length : _e4c_record_append(buffer, size, length, (const unsigned char *)text, count) );
+}
+
+static size_t _e4c_format_exception_binary(unsigned char * buffer, size_t size, size_t length, const e4c_exception * exception){
+
+	const e4c_exception_type *	type;
+	size_t						count_offset;
+	unsigned long				count = 0;
+
+	length = _e4c_record_append_string(buffer, size, length, exception->name);
+	length = _e4c_record_append_string(buffer, size, length, exception->message);
+	length = _e4c_record_append_string(buffer, size, length, exception->file);
+	length = _e4c_record_append_number(buffer, size, length, (unsigned long)exception->line, 4);
+	length = _e4c_record_append_string(buffer, size, length, exception->function);
+	length = _e4c_record_append_number(buffer, size, length, (unsigned long)exception->error_number, 4);
+
+	/* the number of types will be filled in afterwards */
+	count_offset	= length;
+	length			= _e4c_record_append_number(buffer, size, length, 0UL, 1);
+
+	for(type = exception->type; type != NULL && count < 0xFFUL; type = (type->supertype == type ? NULL : type->supertype) ){
+		length = _e4c_record_append_string(buffer, size, length, type->name);
+		count++;
+	}
+
+	if(count_offset < size){
+		buffer[count_offset] = (unsigned char)count;
+	}
+
+	return(length);
+}
+
+void e4c_print_exception_binary(const e4c_exception * exception){
+
+	unsigned char			buffer[E4C_PRINT_BUFFER_SIZE];
+	size_t					length;
+	size_t					checkpoint;
+	size_t					count_offset;
+	unsigned long			count = 0;
+	const e4c_exception *	cause;
+
+	if(exception == NULL){
+		e4c_exception_throw_verbatim_(&NullPointerException, E4C_INFO_FILE_, E4C_INFO_LINE_, "e4c_print_exception_binary", "Null exception.");
+	}
+
+	/* the record is prefixed with its length and a version number */
+	length = _e4c_record_append_number(buffer, sizeof(buffer), 4, 1UL, 1);
+	length = _e4c_format_exception_binary(buffer, sizeof(buffer), length, exception);
+
+	count_offset	= length;
+	length			= _e4c_record_append_number(buffer, sizeof(buffer), length, 0UL, 1);
+
+	for(cause = exception->cause; cause != NULL && count < 0xFFUL; cause = cause->cause){
+
+		checkpoint	= length;
+		length		= _e4c_format_exception_binary(buffer, sizeof(buffer), length, cause);
+
+		/* drop the causes that do not fit */
+		if(length > sizeof(buffer)){
+			length = checkpoint;
+			break;
+		}
+
+		count++;
+	}
+
+	/* (an exception that does not fit by itself is not printed at all) */
+	if(count_offset >= sizeof(buffer)){
+		return;
+	}
+
+	buffer[count_offset] = (unsigned char)count;
+
+	(void)_e4c_record_append_number(buffer, sizeof(buffer), 0, (unsigned long)(length - 4), 4);
+
+	_e4c_text_write( (const char *)buffer, length);
 }
 
 void e4c_print_exception(const e4c_exception * exception){
@@ -90,6 +90,11 @@
 "in order to enable the multi-thread version of exceptions4c."
 # endif
 
+# if defined(E4C_AUTO_CONTEXT) && !defined(E4C_THREADSAFE)
+#	error "Please define E4C_THREADSAFE at compiler level " \
+"in order to enable automatic exception contexts."
+# endif
+
 
 /*@-exportany@*/
 
@@ -299,31 +304,120 @@
 # define E4C_VERSION_REVISION_(major, minor, revision) ( (int)revision )
 
 
+/*
+ * The E4C_FAST_FAIL compile-time parameter
+ * could be defined in order to terminate the program (or thread) as soon as an
+ * exception is thrown that no catch block will handle, skipping the pending
+ * finally blocks (the library and its clients must agree on this setting).
+ *
+ * The catch blocks of each try block are only registered for this search phase
+ * when it is defined. They are registered by an extra pass through the block
+ * before trying; in turn, blocks without a finally block skip the pass that
+ * would run it. So a try block with no finally block costs about the same
+ * as in the default mode, while one with a finally block costs one more pass
+ * (see the target `benchmark` of the test Makefile).
+ *
+ * Only in this mode does a thrown exception skip the enclosing blocks that have
+ * nothing to do for it (no matching catch block, no pending finally block and
+ * no resource to dispose). In the default mode, the exception is propagated
+ * through every enclosing block, one at a time.
+ */
+
+/*
+ * The E4C_MAX_CATCH_TYPES compile-time parameter
+ * could be defined in order to change how many catch blocks per try block are
+ * registered for the search phase (the library and its clients must agree on
+ * this value).
+ */
+# ifndef E4C_MAX_CATCH_TYPES
+#	define E4C_MAX_CATCH_TYPES			8
+# endif
+
+/*
+ * The E4C_TYPE_HANDLER_CACHE_SIZE compile-time parameter
+ * could be defined in order to change how many exception types per context
+ * remember which type handler they resolved to (the library and its clients
+ * must agree on this value).
+ */
+# ifndef E4C_TYPE_HANDLER_CACHE_SIZE
+#	define E4C_TYPE_HANDLER_CACHE_SIZE	8
+# endif
+
+/*
+ * The E4C_STATISTICS compile-time parameter
+ * could be defined in order to count how many exceptions are thrown, caught,
+ * retried and uncaught, per type and site, and to measure how long blocks take
+ * to complete, per site and status (the library and its clients must agree on
+ * this setting).
+ */
+
+
 /*
  * These undocumented macros hide implementation details from documentation.
  */
 
+/* (the search phase needs an extra pass to register the catch blocks) */
+# ifdef E4C_FAST_FAIL
+#	define E4C_TRY_STAGE_		e4c_beginning_
+#	define E4C_WITH_STAGE_		e4c_registering_
+# else
+#	define E4C_TRY_STAGE_		e4c_acquiring_
+#	define E4C_WITH_STAGE_		e4c_beginning_
+# endif
+
 # define E4C_FRAME_LOOP_(stage) \
 	if(E4C_CONTINUATION_CREATE_(e4c_frame_first_stage_(stage,E4C_INFO_)) >= 0) \
 		while( e4c_frame_next_stage_() )
 
 # define E4C_TRY \
-	E4C_FRAME_LOOP_(e4c_acquiring_) \
+	E4C_FRAME_LOOP_(E4C_TRY_STAGE_) \
 	if( ( e4c_frame_get_stage_(E4C_INFO_) == e4c_trying_ ) \
 		&& e4c_frame_next_stage_() )
 	/* simple optimization: e4c_frame_next_stage_ will avoid disposing stage */
 
+# define E4C_TRY_EACH(init, condition, step) \
+	for( (void)(init), (void)e4c_frame_first_stage_(E4C_TRY_STAGE_, E4C_INFO_); \
+		(condition) || e4c_frame_last_iteration_(E4C_INFO_); \
+		(void)(step) ) \
+		if(E4C_CONTINUATION_CREATE_(e4c_frame_rearm_(E4C_INFO_)) >= 0) \
+			while( e4c_frame_next_iteration_() ) \
+				if( ( e4c_frame_get_stage_(E4C_INFO_) == e4c_trying_ ) \
+					&& e4c_frame_next_stage_() )
+	/* the same frame is re-armed for each iteration of the loop */
+
+# define E4C_BATCH_EACH(batch, index, count) \
+	E4C_TRY_EACH( \
+		(index) = 0, \
+		(index) < (count) && e4c_frame_collect_(&(batch), (index), E4C_INFO_), \
+		(index)++ \
+	)
+
 # define E4C_CATCH(exception_type) \
 	else if( e4c_frame_catch_(&exception_type, E4C_INFO_) )
 
 # define E4C_FINALLY \
-	else if( e4c_frame_get_stage_(E4C_INFO_) == e4c_finalizing_ )
+	else if( e4c_frame_finally_(E4C_INFO_) )
 
 # define E4C_THROW(exception_type, message) \
 	e4c_exception_throw_verbatim_(&exception_type, E4C_INFO_, message )
 
+# define E4C_THROW_PAYLOAD(exception_type, message, payload) \
+	e4c_exception_throw_payload_( \
+		&exception_type, E4C_INFO_, message, \
+		&(payload), E4C_PAYLOAD_SIZE_(payload) \
+	)
+
+# define E4C_GET_PAYLOAD(exception, type) \
+	( (const type *)( (exception)->payload.bytes + 0 * E4C_PAYLOAD_SIZE_(type) ) )
+
+/* (does not compile if the payload does not fit in the exception) */
+# define E4C_PAYLOAD_SIZE_(payload) \
+	( sizeof(payload) + 0 * sizeof( char[ \
+		sizeof(payload) <= (size_t)E4C_EXCEPTION_PAYLOAD_SIZE ? 1 : -1 \
+	] ) )
+
 # define E4C_WITH(resource, dispose) \
-	E4C_FRAME_LOOP_(e4c_beginning_) \
+	E4C_FRAME_LOOP_(E4C_WITH_STAGE_) \
 	if( e4c_frame_get_stage_(E4C_INFO_) == e4c_disposing_ ){ \
 		dispose( \
 			/*@-usedef@*/ (resource) /*@=usedef@*/, \
@@ -346,28 +440,34 @@
 
 # define E4C_REUSING_CONTEXT(status, on_failure) \
 	\
-	volatile E4C_BOOL		E4C_AUTO_(BEGIN)	= !e4c_context_is_ready(); \
+	struct e4c_boundary_	E4C_AUTO_(BOUNDARY); \
+	volatile E4C_BOOL		E4C_AUTO_(BORROW)	= \
+		e4c_boundary_borrow_(&E4C_AUTO_(BOUNDARY)); \
 	volatile E4C_BOOL		E4C_AUTO_(DONE)		= E4C_FALSE; \
 	\
-	if( E4C_AUTO_(BEGIN) ){ \
-		e4c_context_begin(E4C_FALSE); \
-		E4C_TRY{ \
-			goto E4C_AUTO_(PAYLOAD); \
-			E4C_AUTO_(CLEANUP): \
-			E4C_AUTO_(DONE) = E4C_TRUE; \
-		}E4C_CATCH(RuntimeException){ \
+	if( E4C_AUTO_(BORROW) ){ \
+		if( E4C_CONTINUATION_CREATE_( \
+			e4c_boundary_begin_(&E4C_AUTO_(BOUNDARY)) \
+		) != 0 ){ \
 			(status) = (on_failure); \
+			e4c_boundary_end_(&E4C_AUTO_(BOUNDARY)); \
+			E4C_AUTO_(DONE) = E4C_TRUE; \
 		} \
-		e4c_context_end(); \
-		E4C_AUTO_(DONE)		= E4C_TRUE; \
-		E4C_AUTO_(BEGIN)	= E4C_FALSE; \
 	} \
 	\
-	E4C_AUTO_(PAYLOAD): \
-	for(; !E4C_AUTO_(DONE) || E4C_AUTO_(BEGIN); E4C_AUTO_(DONE) = E4C_TRUE) \
-		if( E4C_AUTO_(DONE) ){ \
-			goto E4C_AUTO_(CLEANUP); \
-		}else
+	for( \
+		; \
+		!E4C_AUTO_(DONE); \
+		E4C_AUTO_(DONE) = E4C_TRUE, ( E4C_AUTO_(BORROW) ? \
+			e4c_boundary_end_(&E4C_AUTO_(BOUNDARY)) : (void)0 ) \
+	)
+
+# define E4C_ERROR_BOUNDARY(status, mappings) \
+	\
+	E4C_REUSING_CONTEXT( \
+		status, \
+		e4c_map_exception( (mappings), e4c_get_exception() ) \
+	)
 
 # define E4C_USING_CONTEXT(handle_signals) \
 	\
@@ -394,6 +494,9 @@
 		E4C_INFO_, message \
 	)
 
+# define E4C_RETHROW_FOREIGN(exception) \
+	e4c_exception_rethrow_foreign_(exception, E4C_INFO_)
+
 # ifdef HAVE_C99_VARIADIC_MACROS
 #	define E4C_RETHROWF(format, ...) \
 		e4c_exception_throw_format_( \
@@ -498,6 +601,118 @@
 # define try E4C_TRY
 # endif
 
+/**
+ * Introduces a `#try` block that is repeated by a loop
+ *
+ * @param   init
+ *          The expression to evaluate before the first iteration
+ * @param   condition
+ *          The expression to evaluate before each iteration
+ * @param   step
+ *          The expression to evaluate after each iteration
+ *
+ * `try_each` works like a `for` loop whose body is a `try` block. The
+ * difference is that a single exception frame is set up before the loop and
+ * re-armed for each iteration, instead of being allocated, initialized and torn
+ * down every time. It is intended for hot loops that need to keep going even
+ * though some iterations throw exceptions.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   int index;
+ *
+ *   try_each(index = 0, index < event_count, index++){
+ *       dispatch_event(events[index]);
+ *   }catch(RuntimeException){
+ *       log_error( e4c_get_exception() );
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The `catch` and `finally` blocks are executed (at most) once per iteration,
+ * just like the ones following a regular `try` block. An exception that is not
+ * caught in one iteration terminates the loop and is propagated.
+ *
+ * @pre
+ *   - A program (or thread) **must** begin an exception context prior to using
+ *     the keyword `try_each`. Such programming error will lead to an abrupt
+ *     exit of the program (or thread).
+ *   - A `try_each` block **must** precede, at least, another block of code,
+ *     introduced by either `catch` or `finally`.
+ *   - A `try_each` block **must not** be exited through any of: `goto`,
+ *     `break`, `continue` or `return` (but it is legal to `#throw` an
+ *     exception).
+ *   - The expressions `condition` and `step` **should not** throw exceptions,
+ *     since they are evaluated outside the `try` block.
+ *
+ * @see     #try
+ * @see     #catch
+ * @see     #finally
+ */
+# ifndef E4C_NOKEYWORDS
+# define try_each(init, condition, step) E4C_TRY_EACH(init, condition, step)
+# endif
+
+/**
+ * Introduces a loop that collects the exceptions thrown by its iterations
+ *
+ * @param   batch
+ *          The batch in which the errors will be collected
+ * @param   index
+ *          The variable that holds the index of the current item
+ * @param   count
+ *          The number of items to process
+ *
+ * `batch_each` works like a `#try_each` loop that iterates `count` times,
+ * setting `index` from *zero* to `count - 1`. Whenever an iteration throws an
+ * exception, the loop records the failure in the preallocated array of the
+ * `#e4c_batch` and continues with the next item.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   e4c_batch_error errors[100];
+ *   e4c_batch batch;
+ *   int index;
+ *
+ *   e4c_batch_init(&batch, errors, 100);
+ *
+ *   batch_each(batch, index, record_count){
+ *       process_record(records[index]);
+ *   }
+ *
+ *   for(index = 0; index < batch.count; index++){
+ *       printf("record #%d: %s\n", errors[index].index, errors[index].message);
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * When the exception does not need to go through any `catch` or `finally`
+ * blocks on its way to the loop, it is recorded right away, *without being
+ * created* (the [initialize handler](@ref e4c_initialize_handler) is not
+ * called and the exception has no cause). Therefore, batches that fail often
+ * are processed at nearly the same pace as those that don't.
+ *
+ * Once the array is full, further failures are only counted.
+ *
+ * @pre
+ *   - A program (or thread) **must** begin an exception context prior to using
+ *     the keyword `batch_each`. Such programming error will lead to an abrupt
+ *     exit of the program (or thread).
+ *   - A `batch_each` block **must not** be followed by `catch` blocks, but it
+ *     may be followed by a `finally` block.
+ *   - A `batch_each` block **must not** be exited through any of: `goto`,
+ *     `break`, `continue` or `return` (but it is legal to `#throw` an
+ *     exception).
+ *
+ * @post
+ *   - Uncatchable exceptions (such as `AssertionException`) are not collected,
+ *     they terminate the loop and are propagated.
+ *
+ * @see     #e4c_batch
+ * @see     #e4c_batch_error
+ * @see     #e4c_batch_init
+ * @see     #try_each
+ */
+# ifndef E4C_NOKEYWORDS
+# define batch_each(batch, index, count) E4C_BATCH_EACH(batch, index, count)
+# endif
+
 /**
  * Introduces a block of code capable of handling a specific type of exceptions
  *
@@ -772,6 +987,57 @@
 	E4C_THROW(exception_type, message)
 # endif
 
+/**
+ * Throws an exception carrying a payload
+ *
+ * @param   exception_type
+ *          The type of exception to be thrown
+ * @param   message
+ *          The *ad-hoc* message describing the exception. If `NULL`, then the
+ *          default message for the specified exception type will be used
+ * @param   payload
+ *          The object to be copied into the exception
+ *
+ * `throw_payload` works like `#throw`, but it also copies `payload` into the
+ * payload area of the new exception. Any object can be passed, as long as it
+ * fits in `E4C_EXCEPTION_PAYLOAD_SIZE` bytes (otherwise the program will not
+ * compile). The payload is copied before the
+ * [initialize handler](@ref e4c_initialize_handler) is called, and it can be
+ * retrieved through `#e4c_get_payload`:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   struct request_error{ long request_id; int code; } error = {id, 503};
+ *
+ *   try{
+ *       throw_payload(IOException, "Service unavailable.", error);
+ *   }catch(IOException){
+ *       const struct request_error * payload;
+ *       payload = e4c_get_payload(e4c_get_exception(), struct request_error);
+ *       printf("request #%ld failed (%d)\n", payload->request_id, payload->code);
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Since the payload is stored inside the exception, attaching small pieces of
+ * data (such as request identifiers or error codes) does not need the custom
+ * data handlers to allocate any memory.
+ *
+ * @pre
+ *   - A program (or thread) **must** begin an exception context prior to using
+ *     the keyword `throw_payload`. Such programming error will lead to an
+ *     abrupt exit of the program (or thread).
+ *   - `payload` **must** be an *lvalue*.
+ * @post
+ *   - Control does not return to the `throw_payload` point.
+ *
+ * @see     #throw
+ * @see     #e4c_get_payload
+ * @see     #E4C_EXCEPTION_PAYLOAD_SIZE
+ */
+# ifndef E4C_NOKEYWORDS
+# define throw_payload(exception_type, message, payload) \
+	E4C_THROW_PAYLOAD(exception_type, message, payload)
+# endif
+
 /**
  * Throws again the currently thrown exception, with a new message
  *
@@ -1178,6 +1444,19 @@
 	\
 	E4C_VERSION_(E4C_VERSION_STRING_)
 
+/**
+ * Provides the maximum number of causes an exception can keep
+ *
+ * The E4C_MAX_CAUSE_DEPTH compile-time parameter could be defined in order to
+ * change how many causes an exception can keep; older causes are collapsed
+ * into a single `#OmittedCausesException`.
+ *
+ * @see     #OmittedCausesException
+ */
+# ifndef E4C_MAX_CAUSE_DEPTH
+#	define E4C_MAX_CAUSE_DEPTH 16
+# endif
+
 /**
  * Provides the maximum length (in bytes) of an exception message
  */
@@ -1185,6 +1464,25 @@
 #	define E4C_EXCEPTION_MESSAGE_SIZE 128
 # endif
 
+/**
+ * Provides the size (in bytes) of the payload area of an exception
+ *
+ * The E4C_EXCEPTION_PAYLOAD_SIZE compile-time parameter could be defined in
+ * order to make room for larger payloads (or to save memory).
+ *
+ * @see     #throw_payload
+ */
+# ifndef E4C_EXCEPTION_PAYLOAD_SIZE
+#	define E4C_EXCEPTION_PAYLOAD_SIZE 16
+# endif
+
+/**
+ * Provides the number of buckets of a latency histogram
+ *
+ * @see     #e4c_latency
+ */
+# define E4C_LATENCY_BUCKETS 64
+
 /**
  * Reuses an existing exception context, otherwise, begins a new one and then
  * ends it.
@@ -1295,10 +1593,14 @@
  *         code which is able to handle that exception.
  *   - If there is no exception context at the time the block starts:
  *     1. A new exception context will be begun; note that the signal handling
- *        system **WILL NOT** be set up.
+ *        system **WILL NOT** be set up. This *boundary* context is borrowed
+ *        from the stack of the calling function, so it does not allocate any
+ *        memory, and it is ended as soon as the block finishes.
  *     2. The code block will take place.
  *     3. If any exception is thrown during the execution of the block:
- *       * It will be **caught**.
+ *       * It will be **caught**, provided that it is an instance of
+ *         `#RuntimeException` (just like `catch(RuntimeException)` would do);
+ *         otherwise, it will be treated as an *uncaught* exception.
  *       * `status` will be asigned the value of the expression `on_failure`.
  *
  * If you need to perform any cleanup, you should place it *inside* a
@@ -1356,7 +1658,9 @@
  * @pre
  *   - A block introduced by `e4c_reusing_context` **must not** be exited
  *     through any of: `goto`, `break`, `continue` or `return` (but it is legal
- *     to `#throw` an exception).
+ *     to `#throw` an exception). A boundary left behind this way is reported
+ *     as `#ContextNotEnded` when the program exits, or as soon as a block at
+ *     the same place of the stack is entered again.
  * @post
  *   - A block introduced by `e4c_reusing_context` is guaranteed to take place
  *     *inside* an exception context.
@@ -1416,6 +1720,63 @@
  */
 # define E4C_ON_FAILURE(handler) handler( e4c_get_exception() )
 
+/**
+ * Reuses an existing exception context, mapping a failure to an error code
+ *
+ * @param   status
+ *          The name of a previously defined variable, or lvalue, which will be
+ *          assigned the mapped error code
+ * @param   mappings
+ *          An array of error mappings, terminated by a *default* error mapping
+ *
+ * This macro is a declarative version of `#e4c_reusing_context`. When an
+ * exception is thrown inside the block, and there was no exception context at
+ * the time the block started, `status` will be assigned the error code of the
+ * first mapping whose exception type the thrown exception is an instance of.
+ * `errno` will also be set, if the mapping specifies a non-zero error number.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   static const e4c_error_mapping my_error_mappings[] = {
+ *       E4C_ERROR_MAPPING(NotEnoughMemoryException, STATUS_MEMORY_ERROR, ENOMEM),
+ *       E4C_ERROR_MAPPING(IllegalArgumentException, STATUS_INVALID, EINVAL),
+ *       E4C_ERROR_MAPPING(MyException, STATUS_MY_ERROR, 0),
+ *       E4C_DEFAULT_ERROR_MAPPING(STATUS_ERROR, 0)
+ *   };
+ *
+ *   int library_public_function(void * pointer, int number){
+ *
+ *       volatile int status = STATUS_OK;
+ *
+ *       e4c_error_boundary(status, my_error_mappings){
+ *
+ *           if(pointer == NULL){
+ *               throw(IllegalArgumentException, NULL);
+ *           }
+ *
+ *           library_private_function(pointer, number);
+ *       }
+ *
+ *       return(status);
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Mappings are checked in order, so the most specific exception types should
+ * be placed first. No additional frames are created: the exception is mapped
+ * by the boundary of `#e4c_reusing_context` itself.
+ *
+ * @pre
+ *   - `mappings` **must not** be `NULL`
+ *   - A block introduced by `e4c_error_boundary` **must not** be exited
+ *     through any of: `goto`, `break`, `continue` or `return` (but it is legal
+ *     to `#throw` an exception).
+ *
+ * @see     #e4c_reusing_context
+ * @see     #e4c_error_mapping
+ * @see     #e4c_map_exception
+ */
+# define e4c_error_boundary(status, mappings) \
+	E4C_ERROR_BOUNDARY(status, mappings)
+
 /**
  * Marks a function which never returns
  *
@@ -1608,6 +1969,75 @@
 # define e4c_using_context(handle_signals) \
 	E4C_USING_CONTEXT(handle_signals)
 
+/**
+ * Retrieves the payload of an exception
+ *
+ * @param   exception
+ *          The exception
+ * @param   type
+ *          The type of the payload
+ * @return  A pointer to the payload of the exception
+ *
+ * The payload of the exception is *zero* unless it was thrown through
+ * `#throw_payload`. As with the exception itself, the pointer **must not** be
+ * used once the exception has been destroyed.
+ *
+ * @see     #throw_payload
+ */
+# define e4c_get_payload(exception, type) \
+	E4C_GET_PAYLOAD(exception, type)
+
+/**
+ * Throws an exception that was transferred from another exception context
+ *
+ * @param   exception
+ *          The exception to be thrown again
+ *
+ * This macro throws, in the current exception context, an exception that was
+ * caught in a different one (typically, by a different thread) and retained
+ * through `#e4c_exception_retain`. Unlike `#rethrow`, the exception is neither
+ * copied nor wrapped: the very same exception (along with its `cause` chain,
+ * message, payload and custom data) is propagated, so it can be caught as
+ * usual:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   // worker thread
+ *   try{
+ *       job->result = run(job);
+ *   }catch(RuntimeException){
+ *       job->failure = e4c_exception_retain( e4c_get_exception() );
+ *   }
+ *   ...
+ *   // waiting thread
+ *   if(job->failure != NULL){
+ *       e4c_rethrow_foreign(job->failure);
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The reference obtained through `#e4c_exception_retain` is handed over to the
+ * current exception context, which will release it as soon as the exception
+ * is no longer thrown; so there is no need to call `#e4c_exception_release`
+ * afterwards. When the exception is finally destroyed, its custom data is
+ * finalized by the handler of the exception context that created it, so that
+ * handler must be safe to call from any thread.
+ *
+ * @pre
+ *   - A program (or thread) **must** begin an exception context prior to using
+ *     `e4c_rethrow_foreign`. Such programming error will lead to an abrupt exit
+ *     of the program (or thread).
+ *   - The caller **must** own a reference to `exception`.
+ * @post
+ *   - Control does not return to the `e4c_rethrow_foreign` point.
+ * @throws  #NullPointerException
+ *          If `exception` is `NULL`
+ *
+ * @see     #e4c_exception_retain
+ * @see     #e4c_exception_release
+ * @see     #rethrow
+ */
+# define e4c_rethrow_foreign(exception) \
+	E4C_RETHROW_FOREIGN(exception)
+
 /**
  * Expresses a program assertion
  *
@@ -1893,6 +2323,103 @@
 	\
 	{E4C_INVALID_SIGNAL_NUMBER_, NULL}
 
+/**
+ * Maps a given exception type to an error code
+ *
+ * @param   exception_type
+ *          Exception type to be converted
+ * @param   error_code
+ *          Value to be returned by a function when the exception is thrown
+ * @param   error_number
+ *          Value to be assigned to `errno` (or `0`, to leave it unchanged)
+ *
+ * This macro represents an [error mapping](@ref e4c_error_mapping) literal. It
+ * comes in handy for initializing arrays of error mappings.
+ *
+ * @see     #e4c_error_mapping
+ * @see     #e4c_error_boundary
+ * @see     #E4C_DEFAULT_ERROR_MAPPING
+ */
+# define E4C_ERROR_MAPPING(exception_type, error_code, error_number) \
+	\
+	{&exception_type, error_code, error_number}
+
+/**
+ * Represents a default error mapping literal
+ *
+ * @param   error_code
+ *          Value to be returned when no other mapping matches the exception
+ * @param   error_number
+ *          Value to be assigned to `errno` (or `0`, to leave it unchanged)
+ *
+ * This macro represents a *default* [error mapping](@ref e4c_error_mapping)
+ * literal. It comes in handy for terminating arrays of `#e4c_error_mapping`.
+ *
+ * @see     #e4c_error_mapping
+ * @see     #e4c_error_boundary
+ * @see     #E4C_ERROR_MAPPING
+ */
+# define E4C_DEFAULT_ERROR_MAPPING(error_code, error_number) \
+	\
+	{NULL, error_code, error_number}
+
+/**
+ * Attaches handlers to a given exception type
+ *
+ * @param   exception_type
+ *          The exception type whose instances (and subtypes) will be handled
+ * @param   initialize_handler
+ *          The function to be executed whenever an instance is thrown
+ * @param   finalize_handler
+ *          The function to be executed whenever an instance is destroyed
+ *
+ * This macro represents a [type handler](@ref e4c_type_handler) literal. It
+ * comes in handy for initializing arrays of type handlers.
+ *
+ * @see     #e4c_type_handler
+ * @see     #e4c_context_set_type_handlers
+ * @see     #E4C_NULL_TYPE_HANDLER
+ */
+# define E4C_TYPE_HANDLER(exception_type, initialize_handler, finalize_handler) \
+	\
+	{&exception_type, initialize_handler, finalize_handler}
+
+/**
+ * Represents a null type handler literal
+ *
+ * This macro represents a *null* [type handler](@ref e4c_type_handler)
+ * literal. It comes in handy for terminating arrays of `#e4c_type_handler`.
+ *
+ * @see     #e4c_type_handler
+ * @see     #e4c_context_set_type_handlers
+ * @see     #E4C_TYPE_HANDLER
+ */
+# define E4C_NULL_TYPE_HANDLER \
+	\
+	{NULL, NULL, NULL}
+
+/**
+ * Represents an empty batch literal
+ *
+ * @param   errors
+ *          The array in which the errors will be collected
+ * @param   capacity
+ *          The number of elements of the array
+ *
+ * This macro represents an empty [batch](@ref e4c_batch) literal. It comes in
+ * handy for initializing batches of static storage duration before a
+ * `#batch_each` loop. Since the address of an automatic array is not a
+ * constant expression in ANSI C, batches of automatic storage duration should
+ * be initialized through `#e4c_batch_init` instead.
+ *
+ * @see     #e4c_batch_init
+ * @see     #e4c_batch
+ * @see     #batch_each
+ */
+# define E4C_BATCH_INITIALIZER(errors, capacity) \
+	\
+	{errors, capacity, 0, 0, 0}
+
 /** @} */
 
 
@@ -2042,6 +2569,18 @@ struct e4c_exception_{
 	/** Custom data associated to this exception */
 	/*@shared@*/ /*@null@*/
 	void *							custom_data;
+
+	/** The payload of this exception (aligned for any basic type) */
+	union{
+		long						integer_;
+		double						real_;
+		void *						pointer_;
+		unsigned char				bytes[E4C_EXCEPTION_PAYLOAD_SIZE];
+	}								payload;
+
+	/* These fields are undocumented on purpose and reserved for internal use */
+	void							(*_finalize)(void * custom_data);
+	struct e4c_context_ *			_context;
 };
 
 /**
@@ -2147,42 +2686,247 @@ struct e4c_signal_mapping_{
 };
 
 /**
- * Represents the completeness of a code block aware of exceptions
- *
- * The symbolic values representing the status of a block help to distinguish
- * between different possible situations inside a `#finally` block. For example,
- * different cleanup actions can be taken, depending on the status of the block.
- *
- * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
- *   try{
- *      ...
- *   }finally{
- *      switch( e4c_get_status() ){
+ * Represents a map between an exception type and an error code
  *
- *          case e4c_succeeded:
- *              ...
- *              break;
+ * Error mappings are used to convert exceptions into the error codes (and
+ * `errno` values) that are returned by a function exported to an
+ * *exception-unaware* client.
  *
- *          case e4c_recovered:
- *              ...
- *              break;
+ * An array of error mappings is defined through the macros `#E4C_ERROR_MAPPING`
+ * and `#E4C_DEFAULT_ERROR_MAPPING`. Every array **must** be terminated with a
+ * *default* error mapping, which will be used when the exception is not an
+ * instance of any of the mapped exception types.
  *
- *          case e4c_failed:
- *              ...
- *              break;
- *      }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   static const e4c_error_mapping my_error_mappings[] = {
+ *       E4C_ERROR_MAPPING(NullPointerException, -2, EINVAL),
+ *       E4C_ERROR_MAPPING(IllegalArgumentException, -1, EINVAL),
+ *       ...
+ *       E4C_DEFAULT_ERROR_MAPPING(-99, 0)
  *   }
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
- * @see     #e4c_get_status
- * @see     #finally
+ * @see     #e4c_error_boundary
+ * @see     #e4c_map_exception
+ * @see     #E4C_ERROR_MAPPING
+ * @see     #E4C_DEFAULT_ERROR_MAPPING
  */
-enum e4c_status_{
+typedef struct e4c_error_mapping_ e4c_error_mapping;
+struct e4c_error_mapping_{
 
-	/** There were no exceptions */
-	e4c_succeeded,
+	/** The exception type to be converted */
+	/*@dependent@*/ /*@null@*/
+	const e4c_exception_type * const	exception_type;
 
-	/** There was an exception, but it was caught */
+	/** The error code representing the exception */
+	int									error_code;
+
+	/** The value to be assigned to errno (zero to leave it unchanged) */
+	int									error_number;
+
+};
+
+/**
+ * Represents a failure collected by a batch
+ *
+ * A `#batch_each` loop records, for each iteration that throws an exception,
+ * the index of the item along with the type, message and site of the
+ * exception. The message is copied, since the exception itself is not kept.
+ *
+ * @see     #e4c_batch
+ * @see     #batch_each
+ */
+typedef struct e4c_batch_error_ e4c_batch_error;
+struct e4c_batch_error_{
+
+	/** The index of the item that failed */
+	int									index;
+
+	/** The type of the exception */
+	/*@dependent@*/ /*@null@*/
+	const e4c_exception_type *			type;
+
+	/** The message of the exception */
+	char								message[E4C_EXCEPTION_MESSAGE_SIZE];
+
+	/** The path of the source code file from which the exception was thrown */
+	/*@observer@*/ /*@null@*/
+	const char *						file;
+
+	/** The number of line from which the exception was thrown */
+	int									line;
+
+	/** The function from which the exception was thrown */
+	/*@observer@*/ /*@null@*/
+	const char *						function;
+
+	/** The value of errno at the time the exception was thrown */
+	int									error_number;
+
+};
+
+/**
+ * Represents a set of failures collected by a `#batch_each` loop
+ *
+ * A batch is initialized through the function `#e4c_batch_init` (or the macro
+ * `#E4C_BATCH_INITIALIZER`, for static batches), along with a preallocated
+ * array of `#e4c_batch_error`. The loop records up to `capacity` failures in
+ * the array; from then on, it only counts them.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   e4c_batch_error errors[100];
+ *   e4c_batch batch;
+ *
+ *   e4c_batch_init(&batch, errors, 100);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @see     #batch_each
+ * @see     #e4c_batch_error
+ * @see     #e4c_batch_init
+ * @see     #E4C_BATCH_INITIALIZER
+ */
+typedef struct e4c_batch_ e4c_batch;
+struct e4c_batch_{
+
+	/** The array in which the failures are recorded */
+	/*@dependent@*/ /*@null@*/
+	e4c_batch_error *					errors;
+
+	/** The number of elements of the array */
+	int									capacity;
+
+	/** The number of failures recorded in the array */
+	int									count;
+
+	/** The number of failures that did not fit in the array */
+	int									overflow;
+
+	/** The index of the item being processed */
+	int									index;
+
+};
+
+/**
+ * Represents an exception recorded by a flight recorder
+ *
+ * A flight recorder keeps track of the most recent exceptions thrown within
+ * an exception context, whether they were caught or not. Only the type, site
+ * and time of each exception are recorded; the exception itself is not kept.
+ *
+ * @see     #e4c_context_set_flight_recorder
+ * @see     #e4c_print_flight_recorders
+ */
+typedef struct e4c_flight_record_ e4c_flight_record;
+struct e4c_flight_record_{
+
+	/** The number of seconds since the Epoch at the time of the throw */
+	long								seconds;
+
+	/** The number of nanoseconds elapsed within the second */
+	long								nanoseconds;
+
+	/** The type of the exception */
+	/*@dependent@*/ /*@null@*/
+	const e4c_exception_type *			type;
+
+	/** The path of the source code file from which the exception was thrown */
+	/*@observer@*/ /*@null@*/
+	const char *						file;
+
+	/** The number of line from which the exception was thrown */
+	int									line;
+
+	/** The function from which the exception was thrown */
+	/*@observer@*/ /*@null@*/
+	const char *						function;
+
+	/** The value of errno at the time the exception was thrown */
+	int									error_number;
+
+	/** The sequence number of the record (zero while it is being written) */
+	unsigned long						sequence;
+
+};
+
+/**
+ * Represents how many times exceptions were thrown from a specific site
+ *
+ * When the library is compiled with `E4C_STATISTICS`, every exception context
+ * counts the exceptions that are thrown, caught, retried, reacquired and
+ * uncaught, keyed by the type of the exception and the site from which it was
+ * thrown. Each thread counts by its own, so no synchronization is needed until
+ * the counters are aggregated by `#e4c_get_statistics`.
+ *
+ * @see     #e4c_get_statistics
+ */
+typedef struct e4c_statistic_ e4c_statistic;
+struct e4c_statistic_{
+
+	/** The type of the exceptions (`NULL` for the ones that could not be keyed) */
+	/*@dependent@*/ /*@null@*/
+	const e4c_exception_type *			type;
+
+	/** The path of the source code file from which the exceptions were thrown */
+	/*@observer@*/ /*@null@*/
+	const char *						file;
+
+	/** The number of line from which the exceptions were thrown */
+	int									line;
+
+	/** The number of exceptions thrown */
+	unsigned long						thrown;
+
+	/** The number of exceptions caught by a `#catch` block */
+	unsigned long						caught;
+
+	/** The number of times a `#try` block was retried after the exception */
+	unsigned long						retried;
+
+	/** The number of times a `#with` block was reacquired after the exception */
+	unsigned long						reacquired;
+
+	/** The number of exceptions left uncaught */
+	unsigned long						uncaught;
+
+};
+
+/**
+ * Represents the completeness of a code block aware of exceptions
+ *
+ * The symbolic values representing the status of a block help to distinguish
+ * between different possible situations inside a `#finally` block. For example,
+ * different cleanup actions can be taken, depending on the status of the block.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   try{
+ *      ...
+ *   }finally{
+ *      switch( e4c_get_status() ){
+ *
+ *          case e4c_succeeded:
+ *              ...
+ *              break;
+ *
+ *          case e4c_recovered:
+ *              ...
+ *              break;
+ *
+ *          case e4c_failed:
+ *              ...
+ *              break;
+ *      }
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @see     #e4c_get_status
+ * @see     #finally
+ */
+enum e4c_status_{
+
+	/** There were no exceptions */
+	e4c_succeeded,
+
+	/** There was an exception, but it was caught */
 	e4c_recovered,
 
 	/** There was an exception and it wasn't caught */
@@ -2190,6 +2934,54 @@ enum e4c_status_{
 };
 typedef enum e4c_status_ e4c_status;
 
+/**
+ * Represents how long the blocks of a specific site took to complete
+ *
+ * When the library is compiled with `E4C_STATISTICS`, every exception context
+ * measures (through a monotonic clock) how long each block (such as `#try` or
+ * `#with`) takes, from the moment it is entered until it is done, and adds
+ * the duration to the histogram of its site and status. Each iteration of
+ * `#try_each` is measured separately. Unless the library is also compiled
+ * with `HAVE_CLOCK_GETTIME`, durations are only measured in whole seconds.
+ *
+ * The histograms are log-linear: the bucket `i` counts the durations of `i`
+ * nanoseconds for `i < 2`; otherwise, with `k = i / 2`, it counts the
+ * durations from `2^k` (included) to `1.5 * 2^k` nanoseconds (excluded) when
+ * `i` is even, or from `1.5 * 2^k` (included) to `2^(k+1)` nanoseconds
+ * (excluded) when `i` is odd. The last bucket also counts the durations that
+ * are longer than that.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   e4c_latency latencies[16];
+ *   int count = e4c_get_latencies(latencies, 16);
+ *   for(index = 0; index < count; index++){
+ *       printf("%s:%d %lu failed\n", latencies[index].file,
+ *           latencies[index].line, latencies[index].count[e4c_failed]);
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @see     #e4c_get_latencies
+ * @see     #e4c_latency_bucket
+ * @see     #e4c_status
+ */
+typedef struct e4c_latency_ e4c_latency;
+struct e4c_latency_{
+
+	/** The path of the source code file of the blocks (`NULL` for the ones that could not be keyed) */
+	/*@observer@*/ /*@null@*/
+	const char *						file;
+
+	/** The number of line of the blocks */
+	int									line;
+
+	/** The number of blocks completed, per status */
+	unsigned long						count[e4c_failed + 1];
+
+	/** The histogram of the durations, per status */
+	unsigned long						buckets[e4c_failed + 1][E4C_LATENCY_BUCKETS];
+
+};
+
 /**
  * Represents a function which will be executed in the event of an uncaught
  * exception.
@@ -2381,11 +3173,186 @@ typedef void (*e4c_finalize_handler)(void * custom_data)
 */
 ;
 
+/**
+ * Represents the handlers of an exception type
+ *
+ * Type handlers override the [initialize](@ref e4c_initialize_handler) and
+ * [finalize](@ref e4c_finalize_handler) handlers of the exception context for
+ * a specific exception type and all of its subtypes. This way, only the
+ * exceptions that need their custom data to be enriched pay for it.
+ *
+ * An array of type handlers is defined through the macros `#E4C_TYPE_HANDLER`
+ * and `#E4C_NULL_TYPE_HANDLER`. Every array **must** be terminated with a
+ * *null* type handler:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   static const e4c_type_handler my_type_handlers[] = {
+ *       E4C_TYPE_HANDLER(InputOutputException, capture_stack, free_stack),
+ *       E4C_TYPE_HANDLER(SignalException, capture_registers, free),
+ *       E4C_TYPE_HANDLER(ControlSignalException, NULL, NULL),
+ *       ...
+ *       E4C_NULL_TYPE_HANDLER
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * An exception is handled by the type handler of its own type or, if there is
+ * none, of its closest supertype. When no type handler applies, the handlers
+ * of the exception context are used. A type handler with `NULL` handlers opts
+ * its subtypes out of any handlers; their custom data is `NULL` instead of the
+ * custom data of the exception context. The same goes for a type handler with
+ * no initialize handler.
+ *
+ * @see     #e4c_context_set_type_handlers
+ * @see     #E4C_TYPE_HANDLER
+ * @see     #E4C_NULL_TYPE_HANDLER
+ */
+typedef struct e4c_type_handler_ e4c_type_handler;
+struct e4c_type_handler_{
+
+	/** The exception type to be handled */
+	/*@dependent@*/ /*@null@*/
+	const e4c_exception_type * const	exception_type;
+
+	/** The function to be executed whenever an instance is thrown */
+	/*@dependent@*/ /*@null@*/
+	e4c_initialize_handler				initialize_handler;
+
+	/** The function to be executed whenever an instance is destroyed */
+	/*@dependent@*/ /*@null@*/
+	e4c_finalize_handler				finalize_handler;
+
+};
+
+/**
+ * Represents the events notified to an event handler
+ *
+ * @see     #e4c_event_handler
+ * @see     #e4c_event_info
+ */
+enum e4c_event_{
+
+	/** A block (such as `#try` or `#with`) was entered */
+	e4c_event_enter,
+
+	/** A block was exited */
+	e4c_event_exit,
+
+	/** An exception was thrown */
+	e4c_event_throw,
+
+	/** An exception was caught by a `#catch` block */
+	e4c_event_catch,
+
+	/** A `#try` block is about to be retried */
+	e4c_event_retry,
+
+	/** A `#with` block is about to be reacquired */
+	e4c_event_reacquire,
+
+	/** An exception was not caught by a block and goes on to the enclosing one */
+	e4c_event_propagate
+};
+typedef enum e4c_event_ e4c_event;
+
+/**
+ * Represents the information passed to an event handler
+ *
+ * @see     #e4c_event_handler
+ */
+typedef struct e4c_event_info_ e4c_event_info;
+struct e4c_event_info_{
+
+	/** The number of seconds of a monotonic clock at the time of the event */
+	long								seconds;
+
+	/** The number of nanoseconds elapsed within the second */
+	long								nanoseconds;
+
+	/** The number of blocks being executed (*zero* outside of any block) */
+	int									depth;
+
+	/** The exception involved in the event (if any) */
+	/*@dependent@*/ /*@null@*/
+	const e4c_exception *				exception;
+
+	/** The path of the source code file of the event (if known) */
+	/*@observer@*/ /*@null@*/
+	const char *						file;
+
+	/** The number of line of the event (if known) */
+	int									line;
+
+	/** The function of the event (if known) */
+	/*@observer@*/ /*@null@*/
+	const char *						function;
+
+	/** The data passed to `#e4c_context_set_event_handler` */
+	/*@dependent@*/ /*@null@*/
+	void *								data;
+
+};
+
+/**
+ * Represents a function which will be executed whenever an event occurs in an
+ * exception context
+ *
+ * @param   event
+ *          The event
+ * @param   info
+ *          The information regarding the event
+ *
+ * An event handler is a means of building profilers or tracers on top of the
+ * exception system. It is notified whenever a block is entered or exited, an
+ * exception is thrown, caught or propagated, or a block is retried or
+ * reacquired.
+ *
+ * This handler can be set through the function
+ * `#e4c_context_set_event_handler`:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   void trace(e4c_event event, const e4c_event_info * info){
+ *
+ *       if(event == e4c_event_throw){
+ *           printf("%ld.%09ld %*s%s\n", info->seconds, info->nanoseconds,
+ *               info->depth, "", info->exception->name);
+ *       }
+ *   }
+ *
+ *   int main(int argc, char * argv[]){
+ *
+ *       e4c_using_context(E4C_TRUE){
+ *
+ *           e4c_context_set_event_handler(trace, NULL);
+ *           // ...
+ *       }
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @warning
+ * An event handler is not allowed to throw exceptions, nor to begin or end
+ * blocks aware of exceptions.
+ *
+ * @see     #e4c_context_set_event_handler
+ * @see     #e4c_event
+ * @see     #e4c_event_info
+ */
+typedef void (*e4c_event_handler)(e4c_event event, const e4c_event_info * info)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+*/
+;
+
 /*
  * Next types are undocumented on purpose, in order to hide implementation
  * details, subject to change.
  */
 enum e4c_frame_stage_{
+	e4c_registering_,
 	e4c_beginning_,
 	e4c_acquiring_,
 	e4c_trying_,
@@ -2395,11 +3362,86 @@ enum e4c_frame_stage_{
 	e4c_done_
 };
 
+struct e4c_type_handler_cache_{
+	/*@dependent@*/ /*@null@*/
+	const e4c_exception_type *		exception_type;
+	/*@dependent@*/ /*@null@*/
+	const e4c_type_handler *		type_handler;
+};
+
 struct e4c_continuation_{
 	/*@partial@*/ /*@dependent@*/
 	E4C_CONTINUATION_BUFFER_		buffer;
 };
 
+struct e4c_frame_{
+	/*@only@*/ /*@null@*/
+	struct e4c_frame_ *				previous;
+	enum e4c_frame_stage_			stage;
+	E4C_BOOL						uncaught;
+	/*@only@*/ /*@null@*/
+	e4c_exception *					thrown_exception;
+	int								retry_attempts;
+	int								reacquire_attempts;
+# ifdef E4C_FAST_FAIL
+	int								catch_count;
+	/*@dependent@*/ /*@null@*/
+	const e4c_exception_type *		catch_types[E4C_MAX_CATCH_TYPES];
+	E4C_BOOL						has_finally;
+	E4C_BOOL						has_dispose;
+# endif
+	/*@dependent@*/ /*@null@*/
+	struct e4c_batch_ *				batch;
+# ifdef E4C_STATISTICS
+	/*@observer@*/ /*@null@*/
+	const char *					file;
+	int								line;
+	long							started_seconds;
+	long							started_nanoseconds;
+# endif
+	struct e4c_continuation_		continuation;
+};
+
+struct e4c_context_{
+	/*@only@*/ /*@null@*/
+	struct e4c_frame_ *				current_frame;
+	/*@dependent@*/ /*@null@*/
+	const e4c_signal_mapping *		signal_mappings;
+	/*@shared@*/ /*@null@*/
+	e4c_uncaught_handler			uncaught_handler;
+	/*@shared@*/ /*@null@*/
+	void *							custom_data;
+	/*@shared@*/ /*@null@*/
+	e4c_initialize_handler			initialize_handler;
+	/*@shared@*/ /*@null@*/
+	e4c_finalize_handler			finalize_handler;
+	E4C_BOOL						borrowed;
+	/*@dependent@*/ /*@null@*/
+	e4c_flight_record *				flight_records;
+	int								flight_capacity;
+	unsigned long					flight_count;
+	/*@shared@*/ /*@null@*/
+	e4c_event_handler				event_handler;
+	/*@dependent@*/ /*@null@*/
+	void *							event_data;
+	/*@dependent@*/ /*@null@*/
+	const e4c_type_handler *		type_handlers;
+	struct e4c_type_handler_cache_	type_handler_cache[E4C_TYPE_HANDLER_CACHE_SIZE];
+# ifdef E4C_STATISTICS
+	/*@only@*/ /*@null@*/
+	e4c_statistic *					statistics;
+	/*@only@*/ /*@null@*/
+	e4c_latency *					latencies;
+	volatile long					live_frames;
+	volatile long					live_exceptions;
+# endif
+};
+
+struct e4c_boundary_{
+	struct e4c_context_				context;
+	struct e4c_frame_				frame;
+};
+
 /**
  * @name Predefined signal mappings
  *
@@ -2510,17 +3552,38 @@ E4C_DECLARE_EXCEPTION(AssertionException);
 E4C_DECLARE_EXCEPTION(InputOutputException);
 
 /**
- * This exception is the common supertype of all signal exceptions
+ * This exception stands for the older causes of an exception
  *
- * Signal exceptions are thrown when some signal is sent to the process.
+ * `#OmittedCausesException` is never thrown. When an exception is thrown while
+ * handling another exception, the latter becomes its `cause`. In order to keep
+ * the memory used by catch-and-rethrow loops bounded, an exception keeps up to
+ * `#E4C_MAX_CAUSE_DEPTH` causes (16 by default); older causes are replaced by a
+ * single `OmittedCausesException`, whose message tells how many were omitted.
+ * The number of omitted causes can also be retrieved as a `long` through
+ * `#e4c_get_payload`.
  *
- * A signal can be generated by calling `raise`.
+ * A chain of causes is never modified while any of the causes to be kept is
+ * referenced elsewhere (for example, through `#e4c_exception_retain`); such a
+ * chain is limited by the next exception thrown once it is not.
  *
  * @par     Extends:
  *          #RuntimeException
- *
- * @par     Direct known subexceptions:
- *          #SignalException,
+ */
+/*@unused@*/
+E4C_DECLARE_EXCEPTION(OmittedCausesException);
+
+/**
+ * This exception is the common supertype of all signal exceptions
+ *
+ * Signal exceptions are thrown when some signal is sent to the process.
+ *
+ * A signal can be generated by calling `raise`.
+ *
+ * @par     Extends:
+ *          #RuntimeException
+ *
+ * @par     Direct known subexceptions:
+ *          #SignalException,
  *          #SignalAlarmException,
  *          #SignalChildException,
  *          #SignalTrapException,
@@ -2942,6 +4005,15 @@ e4c_context_is_ready(
  *     Nevertheless, `#e4c_context_begin` can be called several times *if, and
  *     only if*, `e4c_context_end` is called in between.
  *
+ * @note
+ * When the library is compiled with the `E4C_AUTO_CONTEXT` *compile-time*
+ * parameter (which requires `E4C_THREADSAFE`), the exception context of each
+ * thread will be begun lazily, the first time it is needed, and it will be
+ * ended automatically when the thread exits (or when the program exits, for
+ * the thread which calls `exit`). In this mode, calling
+ * `e4c_context_begin` for a thread whose context has already begun is not an
+ * error; it will only set up the signal handling system (if requested).
+ *
  * @see     #e4c_context_end
  * @see     #e4c_context_is_ready
  * @see     #e4c_using_context
@@ -3064,6 +4136,154 @@ e4c_context_set_handlers(
 	internalState
 @*/;
 
+/**
+ * Sets the handlers of specific exception types
+ *
+ * @param   type_handlers
+ *          The array of type handlers (or `NULL` to remove them)
+ *
+ * This function attaches [initialize](@ref e4c_initialize_handler) and
+ * [finalize](@ref e4c_finalize_handler) handlers to specific exception types
+ * of the current exception context. They are inherited by the subtypes, and
+ * take precedence over the handlers set through `#e4c_context_set_handlers`
+ * (the *initial value* of the custom data is still the one set through that
+ * function).
+ *
+ * The handler that applies to each exception type is resolved only once, and
+ * then it is remembered, so exceptions are not slowed down by long arrays of
+ * type handlers or deep hierarchies.
+ *
+ * The array is not copied, so it **must** remain valid while it is set. The
+ * finalize handler that applies to an exception is captured when the
+ * exception is created, so the handlers can be changed at any time: the
+ * exceptions that are already alive will still be finalized by the handler
+ * that applied when they were created (which, therefore, must remain valid
+ * until they are destroyed).
+ *
+ * @pre
+ *   - A program (or thread) **must** begin an exception context prior to
+ *     calling `e4c_context_set_type_handlers`. Such programming error will
+ *     lead to an abrupt exit of the program (or thread).
+ *   - The array **must** be terminated by `#E4C_NULL_TYPE_HANDLER`.
+ *
+ * @see     #e4c_type_handler
+ * @see     #e4c_context_set_handlers
+ */
+/*@unused@*/ extern
+void
+e4c_context_set_type_handlers(
+	/*@dependent@*/ /*@null@*/
+	const e4c_type_handler *	type_handlers
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/**
+ * Sets the event handler of an exception context
+ *
+ * @param   handler
+ *          The function to be executed whenever an event occurs
+ * @param   data
+ *          The data to be passed to the handler
+ *
+ * This function sets the handler that will be notified of every event in the
+ * current exception context, along with a monotonic timestamp and the number
+ * of blocks being executed. Passing `NULL` removes the handler, so that no
+ * event is notified anymore; then the only cost is a single check per event.
+ *
+ * @pre
+ *   - A program (or thread) **must** begin an exception context prior to
+ *     calling `e4c_context_set_event_handler`. Such programming error will
+ *     lead to an abrupt exit of the program (or thread).
+ *
+ * @see     #e4c_event_handler
+ * @see     #e4c_event
+ * @see     #e4c_event_info
+ */
+/*@unused@*/ extern
+void
+e4c_context_set_event_handler(
+	/*@dependent@*/ /*@null@*/
+	e4c_event_handler			handler,
+	/*@dependent@*/ /*@null@*/
+	void *						data
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/**
+ * Sets the flight recorder of an exception context
+ *
+ * @param   records
+ *          The array in which the exceptions will be recorded
+ * @param   capacity
+ *          The number of elements of the array
+ *
+ * A flight recorder keeps track of the most recent exceptions thrown within
+ * the current exception context, so that you can find out what happened in
+ * the moments before an exception was left uncaught. Every time an exception
+ * is thrown (or a signal is converted into an exception), its type, site,
+ * error number and time are recorded in the next element of the array. Once
+ * the array is full, the oldest record is overwritten. The time is recorded
+ * with nanosecond resolution only when the library is compiled with the
+ * `HAVE_CLOCK_GETTIME` *compile-time* parameter.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   static e4c_flight_record records[64];
+ *
+ *   e4c_context_begin(E4C_TRUE);
+ *   e4c_context_set_flight_recorder(records, 64);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * The records of the current exception context are printed out automatically
+ * when an exception is uncaught, right after calling the uncaught handler (the
+ * flight recorders of other threads are not). All of them can be printed out
+ * on demand by calling `#e4c_print_flight_recorders`.
+ *
+ * The array is owned by the caller and is never allocated nor freed by the
+ * exception system. It **must** remain valid until the flight recorder is
+ * disabled, by calling `e4c_context_set_flight_recorder` with a `NULL` array,
+ * or the exception context ends.
+ *
+ * @pre
+ *   - A program (or thread) **must** begin an exception context prior to
+ *     calling `e4c_context_set_flight_recorder`. Such programming error will
+ *     lead to an abrupt exit of the program (or thread).
+ *
+ * @see     #e4c_flight_record
+ * @see     #e4c_print_flight_recorders
+ */
+/*@unused@*/ extern
+void
+e4c_context_set_flight_recorder(
+	/*@dependent@*/ /*@null@*/
+	e4c_flight_record *			records,
+	int							capacity
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
 /**
  * Assigns the specified signal mappings to the exception context
  *
@@ -3172,6 +4392,50 @@ e4c_get_status(
 	internalState
 @*/;
 
+/**
+ * Initializes an empty batch
+ *
+ * @param   batch
+ *          The batch to be initialized
+ * @param   errors
+ *          The array in which the errors will be collected
+ * @param   capacity
+ *          The number of elements of the array
+ *
+ * `e4c_batch_init` prepares a [batch](@ref e4c_batch) before a `#batch_each`
+ * loop. Unlike `#E4C_BATCH_INITIALIZER`, it can be used with arrays of
+ * automatic storage duration in ANSI C.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   e4c_batch_error errors[100];
+ *   e4c_batch batch;
+ *
+ *   e4c_batch_init(&batch, errors, 100);
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * If `errors` is `NULL` or `capacity` is not positive, the failures will only
+ * be counted.
+ *
+ * @pre
+ *   - `batch` **must not** be `NULL`
+ *
+ * @see     #e4c_batch
+ * @see     #batch_each
+ */
+/*@unused@*/ extern
+void
+e4c_batch_init(
+	/*@out@*/ /*@notnull@*/
+	e4c_batch *					batch,
+	/*@dependent@*/ /*@null@*/
+	e4c_batch_error *			errors,
+	int							capacity
+)
+/*@modifies
+	*batch
+@*/
+;
+
 /**
  * Returns the exception that was thrown
  *
@@ -3211,7 +4475,9 @@ e4c_get_status(
  * it would be legal to *copy* the thrown exception and access to its `name`
  * and `message` outside these blocks, care should be taken in order not to
  * dereference the `cause` of the exception, unless it is a **deep copy**
- * (as opposed to a **shallow copy**).
+ * (as opposed to a **shallow copy**). In order to keep the exception (and its
+ * causes) alive after the block, or to hand it over to a different thread, it
+ * can be retained through `#e4c_exception_retain`.
  *
  * @pre
  *   - A program (or thread) **must** begin an exception context prior to
@@ -3220,6 +4486,7 @@ e4c_get_status(
  *
  * @see     #e4c_exception
  * @see     #e4c_is_instance_of
+ * @see     #e4c_exception_retain
  * @see     #throw
  * @see     #catch
  * @see     #finally
@@ -3240,6 +4507,76 @@ e4c_get_exception(
 @*/
 ;
 
+/**
+ * Keeps an exception alive beyond its `#catch` or `#finally` block
+ *
+ * @param   exception
+ *          The exception to be retained
+ * @return  The same exception
+ *
+ * This function adds a reference to the exception, so that it (along with its
+ * `cause` chain) is not destroyed when the exception context is done with it.
+ * Each call **must** be balanced by a call to `#e4c_exception_release`, or by
+ * handing the exception over to `#e4c_rethrow_foreign`.
+ *
+ * Reference counts are updated atomically when the library is compiled with
+ * `E4C_THREADSAFE`, so a retained exception can be passed to a different
+ * thread (for example, to the one waiting for the result of a task). The
+ * exception **must not** be modified while it is shared.
+ *
+ * This function does not need an exception context, and it returns `NULL` if
+ * `exception` is `NULL`.
+ *
+ * @see     #e4c_exception_release
+ * @see     #e4c_rethrow_foreign
+ * @see     #e4c_get_exception
+ */
+/*@unused@*/ extern
+/*@null@*/
+const e4c_exception *
+e4c_exception_retain(
+	/*@temp@*/ /*@null@*/
+	const e4c_exception *		exception
+)
+/*@modifies
+	internalState
+@*/
+;
+
+/**
+ * Releases a retained exception
+ *
+ * @param   exception
+ *          The exception to be released
+ *
+ * This function removes a reference previously added through
+ * `#e4c_exception_retain`. When the last reference is removed, the exception
+ * is destroyed (along with any of its causes which are not referenced
+ * elsewhere) and its custom data is finalized by the handler of the exception
+ * context that created it, regardless of the thread releasing it.
+ *
+ * This function does not need an exception context, and it does nothing if
+ * `exception` is `NULL`.
+ *
+ * @see     #e4c_exception_retain
+ * @see     #e4c_finalize_handler
+ */
+/*@unused@*/ extern
+void
+e4c_exception_release(
+	/*@temp@*/ /*@null@*/
+	const e4c_exception *		exception
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
 /** @} */
 
 /**
@@ -3327,6 +4664,47 @@ e4c_is_instance_of(
 /*@*/
 ;
 
+/**
+ * Maps an exception to an error code
+ *
+ * @param   mappings
+ *          An array of error mappings, terminated by a *default* error mapping
+ * @param   exception
+ *          The thrown exception
+ * @return  The error code of the first mapping that matches the exception
+ *
+ * This function looks for the first mapping whose exception type the specified
+ * exception is an instance of (as determined by `#e4c_is_instance_of`). If
+ * that mapping specifies a non-zero error number, it is assigned to `errno`.
+ * If no mapping matches, the *default* mapping (the one terminating the array)
+ * is used instead.
+ *
+ * This function is used by `#e4c_error_boundary`, but it can also be called
+ * from a `#catch` block.
+ *
+ * @pre
+ *   - `mappings` **must not** be `NULL`
+ *
+ * @see     #e4c_error_mapping
+ * @see     #e4c_error_boundary
+ * @see     #e4c_is_instance_of
+ */
+/*@unused@*/ extern
+int
+e4c_map_exception(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_error_mapping *	mappings,
+	/*@temp@*/ /*@null@*/
+	const e4c_exception *		exception
+)
+/*@globals
+	internalState
+@*/
+/*@modifies
+	internalState
+@*/
+;
+
 /**
  * Prints a fatal error message regarding the specified exception
  *
@@ -3342,6 +4720,10 @@ e4c_is_instance_of(
  * the exception as it is available, whereas in presence of `NDEBUG`, only the
  * `name` and `message` of the exception are printed.
  *
+ * The whole report is rendered (through `#e4c_format_exception`) before being
+ * printed out at once, so that reports from different threads do not get
+ * interleaved.
+ *
  * @pre
  *   - `exception` **must not** be `NULL`
  * @throws  #NullPointerException
@@ -3371,50 +4753,50 @@ e4c_print_exception(
 ;
 
 /**
- * Prints an ASCII graph representing an exception type's hierarchy
+ * Prints a JSON line regarding the specified exception
  *
- * @param   exception_type
- *          An exception type
+ * @param   exception
+ *          The uncaught exception
  *
- * This is a convenience function for showing an ASCII graph representing an
- * exception type's hierarchy through the standard error output.
+ * This is an alternative to `#e4c_print_exception` that is intended to be
+ * read by programs rather than humans. It can be passed to
+ * `#e4c_context_set_handlers` as the handler for uncaught exceptions.
  *
- * For example, the output for `#ProgramSignal2Exception` would be:
+ * A single line is printed out through the standard error output, containing
+ * a JSON object with the members `name`, `message`, `file`, `line`,
+ * `function`, `errno`, `types` (the names of the type of the exception and
+ * its supertypes) and `causes` (an array of objects with the same members,
+ * except `causes`).
  *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   {"name":"IllegalArgumentException","message":"Illegal argument.","file":"main.c","line":42,"function":"main","errno":0,"types":["IllegalArgumentException","RuntimeException"],"causes":[]}
  * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
  *
- *   Exception hierarchy
- *   ________________________________________________________________
- *
- *       RuntimeException
- *        |
- *        +--SignalException
- *            |
- *            +--ProgramSignalException
- *                |
- *                +--ProgramSignal2Exception
- *   ________________________________________________________________
- *
- * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ * No memory is allocated and the whole line is printed out at once. Causes
+ * that do not fit in the buffer (`E4C_PRINT_BUFFER_SIZE`) are left out. If
+ * the exception itself does not fit, a minimal record is printed instead,
+ * containing only `name`, `"truncated":true` and an empty `causes` array, so
+ * that the line is always valid JSON.
  *
  * @pre
- *   - `exception_type` **must not** be `NULL`
+ *   - `exception` **must not** be `NULL`
  * @throws  #NullPointerException
- *          If `exception_type` is `NULL`
+ *          If `exception` is `NULL`
  *
- * @see     #e4c_exception_type
+ * @see     #e4c_print_exception
+ * @see     #e4c_print_exception_binary
+ * @see     #e4c_uncaught_handler
  */
 /*@unused@*/ extern
 void
-e4c_print_exception_type(
-	/*@shared@*/ /*@notnull@*/
-	const e4c_exception_type *	exception_type
+e4c_print_exception_json(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
 )
 /*@globals
 	fileSystem,
 	internalState,
 
-	NotEnoughMemoryException,
 	NullPointerException
 @*/
 /*@modifies
@@ -3423,29 +4805,402 @@ e4c_print_exception_type(
 @*/
 ;
 
-/** @} */
-
-/*
- * Next functions are undocumented on purpose, because they shouldn't be used
- * directly (but through the "keywords").
+/**
+ * Prints a binary record regarding the specified exception
+ *
+ * @param   exception
+ *          The uncaught exception
+ *
+ * This is a compact alternative to `#e4c_print_exception_json`. It can be
+ * passed to `#e4c_context_set_handlers` as the handler for uncaught exceptions.
+ *
+ * A single record is printed out through the standard error output. Numbers
+ * are stored in network byte order, and strings are prefixed with their
+ * length (two bytes, *zero* for `NULL`). The record consists of:
+ *
+ *   - The length of the rest of the record (four bytes)
+ *   - The version of the record format (one byte, currently `1`)
+ *   - The exception
+ *   - The number of causes (one byte)
+ *   - Each one of the causes
+ *
+ * And each exception (or cause) consists of:
+ *
+ *   - `name`, `message` and `file` (strings)
+ *   - `line` (four bytes)
+ *   - `function` (string)
+ *   - `errno` (four bytes)
+ *   - The number of types (one byte)
+ *   - The names of the type of the exception and its supertypes (strings)
+ *
+ * No memory is allocated and the whole record is printed out at once. Causes
+ * that do not fit in the buffer (`E4C_PRINT_BUFFER_SIZE`) are left out.
+ *
+ * @pre
+ *   - `exception` **must not** be `NULL`
+ * @throws  #NullPointerException
+ *          If `exception` is `NULL`
+ *
+ * @see     #e4c_print_exception
+ * @see     #e4c_print_exception_json
+ * @see     #e4c_uncaught_handler
  */
-
 /*@unused@*/ extern
-/*@notnull@*/ /*@temp@*/
-struct e4c_continuation_ *
-e4c_frame_first_stage_(
-	enum e4c_frame_stage_		stage,
-	/*@observer@*/ /*@null@*/
-	const char *				file,
-	int							line,
-	/*@observer@*/ /*@null@*/
-	const char *				function
+void
+e4c_print_exception_binary(
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception
 )
 /*@globals
 	fileSystem,
 	internalState,
 
-	NotEnoughMemoryException
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/**
+ * Aggregates the exception statistics of all exception contexts
+ *
+ * @param   statistics
+ *          The array in which the statistics will be aggregated
+ * @param   capacity
+ *          The number of elements of the array
+ * @return  The number of elements filled in
+ *
+ * This function adds up the counters of every exception context (including
+ * the ones that already ended) and fills in one element per type and site.
+ * When there are more sites than elements, the remaining ones are left out.
+ *
+ * In a multithreaded program, the counters of other threads are read while
+ * they keep running, so the numbers are a close approximation rather than an
+ * exact snapshot.
+ *
+ * If the library was compiled without `E4C_STATISTICS`, nothing is counted
+ * and this function returns *zero*.
+ *
+ * @pre
+ *   - `statistics` **must not** be `NULL`
+ * @throws  #NullPointerException
+ *          If `statistics` is `NULL`
+ *
+ * @see     #e4c_statistic
+ */
+/*@unused@*/ extern
+int
+e4c_get_statistics(
+	/*@out@*/ /*@notnull@*/
+	e4c_statistic *				statistics,
+	int							capacity
+)
+/*@globals
+	internalState,
+
+	NullPointerException
+@*/
+/*@modifies
+	statistics,
+	internalState
+@*/
+;
+
+/**
+ * Collects the latency histograms of all exception contexts
+ *
+ * @param   latencies
+ *          The array in which the histograms will be aggregated
+ * @param   capacity
+ *          The number of elements of the array
+ * @return  The number of elements filled in
+ *
+ * This function adds up the histograms of every exception context (including
+ * the ones that already ended) and fills in one element per site. When there
+ * are more sites than elements, the remaining ones are left out.
+ *
+ * As with `#e4c_get_statistics`, the histograms of other threads are read
+ * while they keep running. If the library was compiled without
+ * `E4C_STATISTICS`, nothing is measured and this function returns *zero*.
+ *
+ * @pre
+ *   - `latencies` **must not** be `NULL`
+ * @throws  #NullPointerException
+ *          If `latencies` is `NULL`
+ *
+ * @see     #e4c_latency
+ */
+/*@unused@*/ extern
+int
+e4c_get_latencies(
+	/*@out@*/ /*@notnull@*/
+	e4c_latency *				latencies,
+	int							capacity
+)
+/*@globals
+	internalState,
+
+	NullPointerException
+@*/
+/*@modifies
+	latencies,
+	internalState
+@*/
+;
+
+/**
+ * Finds the bucket of a latency histogram that counts a given duration
+ *
+ * @param   seconds
+ *          The number of whole seconds of the duration
+ * @param   nanoseconds
+ *          The remaining number of nanoseconds of the duration
+ * @return  The index of the bucket, from *zero* to `E4C_LATENCY_BUCKETS - 1`
+ *
+ * This function maps a duration to a bucket in the same way the histograms of
+ * `#e4c_latency` are filled in, so that clients can find out which durations
+ * each bucket stands for. Negative durations map to the first bucket, and
+ * durations of four seconds or longer map to the last one.
+ *
+ * @see     #e4c_latency
+ */
+/*@unused@*/ extern
+int
+e4c_latency_bucket(
+	long						seconds,
+	long						nanoseconds
+)
+/*@*/
+;
+
+/**
+ * Counts the exception frames and exceptions currently alive
+ *
+ * @param   frames
+ *          The variable in which the number of frames will be stored
+ * @param   exceptions
+ *          The variable in which the number of exceptions will be stored
+ *
+ * This function adds up, for every exception context, the number of blocks
+ * (such as `#try` or `#with`) that are currently being executed. It also
+ * counts the exceptions that have not been destroyed yet, including the ones
+ * released by a different thread than the one that threw them (see
+ * `#e4c_rethrow_foreign`) and the ones that outlive their exception context.
+ * Either pointer may be `NULL`.
+ *
+ * As with `#e4c_get_statistics`, the numbers of other threads are read while
+ * they keep running. If the library was compiled without `E4C_STATISTICS`,
+ * both numbers are *zero*.
+ *
+ * @see     #e4c_get_statistics
+ */
+/*@unused@*/ extern
+void
+e4c_get_live_objects(
+	/*@out@*/ /*@null@*/
+	long *						frames,
+	/*@out@*/ /*@null@*/
+	long *						exceptions
+)
+/*@globals
+	internalState
+@*/
+/*@modifies
+	*frames,
+	*exceptions,
+	internalState
+@*/
+;
+
+/**
+ * Prints the flight recorders of all exception contexts
+ *
+ * This function prints out, through the standard error output, the exceptions
+ * recorded by the flight recorder of every exception context, from the oldest
+ * to the most recent one:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   Flight recorder: 2 exceptions thrown.
+ *       #1 1445299200.000012345 NullPointerException at main (main.c:41) errno 0
+ *       #2 1445299200.000067890 IllegalArgumentException at main (main.c:42) errno 0
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * Contexts without a flight recorder are skipped. In a multithreaded program,
+ * the flight recorders of other threads are printed out while they keep
+ * running, so a record that is being written (or overwritten) at the same time
+ * is left out. The flight recorder of a `#e4c_reusing_context` block can only be
+ * printed out from its own thread.
+ *
+ * @see     #e4c_context_set_flight_recorder
+ * @see     #e4c_flight_record
+ */
+/*@unused@*/ extern
+void
+e4c_print_flight_recorders(
+	void
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/**
+ * Renders the causes of an exception when passed to `#e4c_format_exception`
+ */
+# define E4C_FORMAT_CAUSES			0x01
+
+/**
+ * Renders the type hierarchy of an exception when passed to
+ * `#e4c_format_exception`
+ */
+# define E4C_FORMAT_HIERARCHY		0x02
+
+/**
+ * Renders the specified exception into a buffer
+ *
+ * @param   buffer
+ *          The buffer in which the text will be rendered
+ * @param   size
+ *          The size of the buffer
+ * @param   exception
+ *          The exception to be rendered
+ * @param   flags
+ *          Any combination of `#E4C_FORMAT_CAUSES` and `#E4C_FORMAT_HIERARCHY`
+ * @return  The length of the rendered text
+ *
+ * This function renders the `name`, `message`, location and `errno` of an
+ * exception, in the same way `#e4c_print_exception` does. Depending on the
+ * `flags`, its causes and its type hierarchy are also rendered.
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~{.c}
+ *   char buffer[1024];
+ *   ...
+ *   }catch(RuntimeException){
+ *       e4c_format_exception(buffer, sizeof(buffer), e4c_get_exception(), E4C_FORMAT_CAUSES);
+ *       log_error(buffer);
+ *   }
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * No memory is allocated. The text is always terminated with a null character
+ * (unless `size` is *zero*) and, if it does not fit in the buffer, it is
+ * truncated.
+ *
+ * @pre
+ *   - `buffer` **must not** be `NULL`
+ *   - `exception` **must not** be `NULL`
+ * @throws  #NullPointerException
+ *          If either `buffer` or `exception` is `NULL`
+ *
+ * @see     #e4c_print_exception
+ * @see     #e4c_exception
+ */
+/*@unused@*/ extern
+size_t
+e4c_format_exception(
+	/*@out@*/ /*@notnull@*/
+	char *						buffer,
+	size_t						size,
+	/*@temp@*/ /*@notnull@*/
+	const e4c_exception *		exception,
+	int							flags
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	buffer
+@*/
+;
+
+/**
+ * Prints an ASCII graph representing an exception type's hierarchy
+ *
+ * @param   exception_type
+ *          An exception type
+ *
+ * This is a convenience function for showing an ASCII graph representing an
+ * exception type's hierarchy through the standard error output.
+ *
+ * For example, the output for `#ProgramSignal2Exception` would be:
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ *   Exception hierarchy
+ *   ________________________________________________________________
+ *
+ *       RuntimeException
+ *        |
+ *        +--SignalException
+ *            |
+ *            +--ProgramSignalException
+ *                |
+ *                +--ProgramSignal2Exception
+ *   ________________________________________________________________
+ *
+ * ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+ *
+ * @pre
+ *   - `exception_type` **must not** be `NULL`
+ * @throws  #NullPointerException
+ *          If `exception_type` is `NULL`
+ *
+ * @see     #e4c_exception_type
+ */
+/*@unused@*/ extern
+void
+e4c_print_exception_type(
+	/*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/** @} */
+
+/*
+ * Next functions are undocumented on purpose, because they shouldn't be used
+ * directly (but through the "keywords").
+ */
+
+/*@unused@*/ extern
+/*@notnull@*/ /*@temp@*/
+struct e4c_continuation_ *
+e4c_frame_first_stage_(
+	enum e4c_frame_stage_		stage,
+	/*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@observer@*/ /*@null@*/
+	const char *				function
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NotEnoughMemoryException
 @*/
 /*@modifies
 	fileSystem,
@@ -3453,6 +5208,59 @@ e4c_frame_first_stage_(
 @*/
 ;
 
+/*@unused@*/ extern
+E4C_BOOL
+e4c_boundary_borrow_(
+	/*@notnull@*/ /*@temp@*/
+	struct e4c_boundary_ *		boundary
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/*@unused@*/ extern
+/*@notnull@*/ /*@temp@*/
+struct e4c_continuation_ *
+e4c_boundary_begin_(
+	/*@notnull@*/ /*@out@*/
+	struct e4c_boundary_ *		boundary
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	boundary
+@*/
+;
+
+/*@unused@*/ extern
+void
+e4c_boundary_end_(
+	/*@notnull@*/
+	struct e4c_boundary_ *		boundary
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	boundary
+@*/
+;
+
 /*@unused@*/ extern
 E4C_BOOL
 e4c_frame_next_stage_(
@@ -3512,6 +5320,105 @@ e4c_frame_catch_(
 @*/
 ;
 
+/*@unused@*/ extern
+/*@notnull@*/ /*@temp@*/
+struct e4c_continuation_ *
+e4c_frame_rearm_(
+	/*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@observer@*/ /*@null@*/
+	const char *				function
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/*@unused@*/ extern
+E4C_BOOL
+e4c_frame_next_iteration_(
+	void
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	AssertionException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/*@unused@*/ extern
+E4C_BOOL
+e4c_frame_collect_(
+	/*@notnull@*/
+	struct e4c_batch_ *			batch,
+	int							index,
+	/*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@observer@*/ /*@null@*/
+	const char *				function
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState,
+
+	batch
+@*/
+;
+
+/*@unused@*/ extern
+E4C_BOOL
+e4c_frame_last_iteration_(
+	/*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@observer@*/ /*@null@*/
+	const char *				function
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
+/*@unused@*/ extern
+E4C_BOOL
+e4c_frame_finally_(
+	/*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@observer@*/ /*@null@*/
+	const char *				function
+)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+;
+
 /*@unused@*/ /*@maynotreturn@*/ extern
 void
 e4c_frame_repeat_(
@@ -3561,6 +5468,59 @@ e4c_exception_throw_verbatim_(
 @*/
 E4C_NO_RETURN;
 
+/*@unused@*/ /*@noreturn@*/ extern
+void
+e4c_exception_throw_payload_(
+	/*@shared@*/ /*@notnull@*/
+	const e4c_exception_type *	exception_type,
+	/*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@observer@*/ /*@null@*/
+	const char *				function,
+	/*@observer@*/ /*@temp@*/ /*@null@*/
+	const char *				message,
+	/*@temp@*/ /*@null@*/
+	const void *				payload,
+	size_t						payload_size
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+E4C_NO_RETURN;
+
+/*@unused@*/ /*@noreturn@*/ extern
+void
+e4c_exception_rethrow_foreign_(
+	/*@temp@*/ /*@null@*/
+	const e4c_exception *		exception,
+	/*@observer@*/ /*@null@*/
+	const char *				file,
+	int							line,
+	/*@observer@*/ /*@null@*/
+	const char *				function
+)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+E4C_NO_RETURN;
+
 # if defined(HAVE_C99_VSNPRINTF) || defined(HAVE_VSNPRINTF)
 
 /*@unused@*/ /*@noreturn@*/ extern
@@ -0,0 +1,158 @@
+
+# include <stdio.h>
+# include <stdlib.h>
+# include <time.h>
+# include "e4c.h"
+
+
+/*
+ * This program measures the cost of the exception handling system. It is not
+ * part of the test suites; it is built and run by the target `benchmark` of
+ * the Makefile, once without and once with `E4C_FAST_FAIL`.
+ *
+ * Each scenario is run several times, and the fastest run is reported, in
+ * nanoseconds per block (or per throw). Since only fast-fail builds skip the
+ * frames that have no work to do for a thrown exception, the default mode
+ * serves as the baseline for the throws through nested blocks.
+ */
+
+# ifdef E4C_FAST_FAIL
+#	define MODE						"fast-fail"
+# else
+#	define MODE						"default"
+# endif
+
+# define BLOCKS						2000000L
+# define THROWS						20000L
+# define DEPTH						64
+# define RUNS						5
+
+
+static volatile long counter = 0L;
+
+
+static void measure(const char * scenario, void (*scenario_function)(long), long operations){
+
+	clock_t	started;
+	double	seconds;
+	double	fastest		= -1.0;
+	int		run;
+
+	for(run = 0; run < RUNS; run++){
+
+		started = clock();
+
+		scenario_function(operations);
+
+		seconds = (double)(clock() - started) / (double)CLOCKS_PER_SEC;
+
+		if(fastest < 0.0 || seconds < fastest){
+			fastest = seconds;
+		}
+	}
+
+	printf("%-10s %-50s %10.1f ns\n", MODE, scenario, fastest * 1e9 / (double)operations);
+}
+
+static void try_catch(long blocks){
+
+	volatile long index;
+
+	for(index = 0L; index < blocks; index++){
+
+		E4C_TRY{
+			counter++;
+		}E4C_CATCH(IllegalArgumentException){
+			counter--;
+		}E4C_CATCH(InputOutputException){
+			counter--;
+		}
+	}
+}
+
+static void try_catch_finally(long blocks){
+
+	volatile long index;
+
+	for(index = 0L; index < blocks; index++){
+
+		E4C_TRY{
+			counter++;
+		}E4C_CATCH(IllegalArgumentException){
+			counter--;
+		}E4C_CATCH(InputOutputException){
+			counter--;
+		}E4C_FINALLY{
+			counter++;
+		}
+	}
+}
+
+static void nested_catch(int depth){
+
+	if(depth == 0){
+		E4C_THROW(IllegalArgumentException, NULL);
+	}
+
+	E4C_TRY{
+		nested_catch(depth - 1);
+	}E4C_CATCH(InputOutputException){
+		counter--;
+	}
+}
+
+static void nested_finally(int depth){
+
+	if(depth == 0){
+		E4C_THROW(IllegalArgumentException, NULL);
+	}
+
+	E4C_TRY{
+		nested_finally(depth - 1);
+	}E4C_FINALLY{
+		counter++;
+	}
+}
+
+static void throw_through_catch(long throws){
+
+	volatile long index;
+
+	for(index = 0L; index < throws; index++){
+
+		/* (the outermost block is the one that catches the exception) */
+		E4C_TRY{
+			nested_catch(DEPTH - 1);
+		}E4C_CATCH(IllegalArgumentException){
+			counter++;
+		}
+	}
+}
+
+static void throw_through_finally(long throws){
+
+	volatile long index;
+
+	for(index = 0L; index < throws; index++){
+
+		E4C_TRY{
+			nested_finally(DEPTH - 1);
+		}E4C_CATCH(IllegalArgumentException){
+			counter++;
+		}
+	}
+}
+
+int main(void){
+
+	e4c_context_begin(E4C_FALSE);
+
+	measure("try, 2 catch (nothing thrown)", try_catch, BLOCKS);
+	measure("try, 2 catch, finally (nothing thrown)", try_catch_finally, BLOCKS);
+	measure("throw at depth 64, unrelated catch at each level", throw_through_catch, THROWS);
+	measure("throw at depth 64, finally at each level", throw_through_finally, THROWS);
+
+	e4c_context_end();
+
+	return(EXIT_SUCCESS);
+}
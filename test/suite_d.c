@@ -25,6 +25,8 @@ Depending on whether the library is in thread-unsafe or thread-safe mode.\
 			TEST(d03) \
 			TEST(d04) \
 			TEST(d05) \
+			TEST(d06) \
+			TEST(d07) \
 
 END_SUITE
 
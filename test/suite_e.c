@@ -16,6 +16,8 @@ blocks, before exiting the program.\
 			TEST(e01) \
 			TEST(e02) \
 			TEST(e03) \
+			TEST(e04) \
+			TEST(e05) \
 
 END_SUITE
 
@@ -23,6 +23,8 @@ block).\
 			TEST(f05) \
 			TEST(f06) \
 			TEST(f07) \
+			TEST(f08) \
+			TEST(f09) \
 
 END_SUITE
 
@@ -25,6 +25,25 @@ exceptions to the caller, some others will return a status code. \
 			TEST(h09) \
 			TEST(h10) \
 			TEST(h11) \
+			TEST(h12) \
+			TEST(h13) \
+			TEST(h14) \
+			TEST(h15) \
+			TEST(h16) \
+			TEST(h17) \
+			TEST(h18) \
+			TEST(h19) \
+			TEST(h20) \
+			TEST(h21) \
+			TEST(h22) \
+			TEST(h23) \
+			TEST(h24) \
+			TEST(h25) \
+			TEST(h26) \
+			TEST(h27) \
+			TEST(h28) \
+			TEST(h29) \
+			TEST(h30) \
 
 END_SUITE
 
@@ -0,0 +1,49 @@
+
+# include "testing.h"
+
+
+static int leave_boundary(void)
+/*@globals
+	fileSystem,
+	internalState
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+{
+	volatile int status = 123;
+
+	e4c_reusing_context(status, -123){
+
+		ECHO(("inside_REUSING_CONTEXT_block\n"));
+
+		return(status);
+	}
+
+	return(status);
+}
+
+
+DEFINE_TEST(
+	b15,
+	"return... in the middle of a e4c_reusing_context{..} block, twice",
+	"This test uses the library in an inconsistent way, by <strong>returning from a <code>e4c_reusing_context</code> block</strong> and then calling the same function again. The library must signal the misuse by throwing the exception <code>ContextNotEnded</code> as soon as the block is entered again, instead of reusing the stale exception context.",
+	NULL,
+	EXIT_WHATEVER,
+	"before_SECOND_CALL",
+	"ContextNotEnded"
+){
+
+	ECHO(("before_FIRST_CALL\n"));
+
+	(void)leave_boundary();
+
+	ECHO(("before_SECOND_CALL\n"));
+
+	(void)leave_boundary();
+
+	ECHO(("after_SECOND_CALL\n"));
+
+	return(EXIT_SUCCESS);
+}
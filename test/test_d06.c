@@ -0,0 +1,45 @@
+# include "testing.h"
+
+
+DEFINE_TEST(
+	d06,
+	"Uncaught exception printed as a JSON line",
+	"This test sets <code>e4c_print_exception_json</code> as the handler for uncaught exceptions, then <strong>starts a <code>try</code> block and throws an exception</strong>; there is no <code>catch</code> block to handle it, so a JSON object is printed out through the standard error output.",
+	NULL,
+	IF_NOT_THREADSAFE(EXIT_FAILURE),
+	"before_THROW",
+	"{\"name\""
+){
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	e4c_context_set_handlers(e4c_print_exception_json, NULL, NULL, NULL);
+
+	ECHO(("before_TRY_block\n"));
+
+	E4C_TRY{
+
+		ECHO(("before_THROW\n"));
+
+		E4C_THROW(WildException, "Nobody will catch me.");
+
+		/*@-unreachable@*/
+
+		ECHO(("after_THROW\n"));
+
+		/*@=unreachable@*/
+
+	}
+
+	ECHO(("after_TRY_block\n"));
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	ECHO(("after_CONTEXT_END\n"));
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,57 @@
+# include <string.h>
+# include "testing.h"
+
+
+static char long_name[8192];
+
+static const e4c_exception_type LongNameException = {
+	long_name,
+	"This exception has a very long name.",
+	&RuntimeException
+};
+
+
+DEFINE_TEST(
+	d07,
+	"Oversized uncaught exception printed as a JSON line",
+	"This test sets <code>e4c_print_exception_json</code> as the handler for uncaught exceptions, then <strong>throws an exception whose name does not fit in the print buffer</strong>; there is no <code>catch</code> block to handle it, so a minimal JSON record is printed out instead.",
+	NULL,
+	IF_NOT_THREADSAFE(EXIT_FAILURE),
+	"before_THROW",
+	"{\"name\":null,\"truncated\":true,\"causes\":[]}"
+){
+
+	memset(long_name, 'X', sizeof(long_name) - 1);
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	e4c_context_set_handlers(e4c_print_exception_json, NULL, NULL, NULL);
+
+	ECHO(("before_TRY_block\n"));
+
+	E4C_TRY{
+
+		ECHO(("before_THROW\n"));
+
+		E4C_THROW(LongNameException, NULL);
+
+		/*@-unreachable@*/
+
+		ECHO(("after_THROW\n"));
+
+		/*@=unreachable@*/
+
+	}
+
+	ECHO(("after_TRY_block\n"));
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	ECHO(("after_CONTEXT_END\n"));
+
+	return(EXIT_SUCCESS);
+}
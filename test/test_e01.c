@@ -10,12 +10,12 @@ DEFINE_TEST(
 		"<li>The test starts a <code>try</code> block with a <code>finally</code> block.</li>"
 		"<li>The test throws an exception from inside the <code>try</code> block.</li>"
 		"<li>There is no <code>catch</code> block to handle it.</li>"
-		"<li>The <code>finally</code> block is executed.</li>"
+		"<li>The <code>finally</code> block is executed (unless <code>E4C_FAST_FAIL</code> was defined).</li>"
 		"<li>The program is terminated.</li>"
 		"</ol>",
 	NULL,
 	IF_NOT_THREADSAFE(EXIT_FAILURE),
-	"inside_FINALLY_block",
+	IF_FAST_FAIL("before_THROW", "inside_FINALLY_block"),
 	"WildException"
 ){
 
@@ -53,11 +53,12 @@ DEFINE_TEST_LONG_DESCRIPTION(
 		"<li>There is no <code>catch</code> block to handle it.</li>"
 		"<li>The <code>finally</code> block (of the function) is executed.</li>"
 		"<li>The <code>finally</code> block (of the test) is executed.</li>"
+		"<li>If <code>E4C_FAST_FAIL</code> was defined, neither <code>finally</code> block is executed.</li>"
 		"<li>The program is terminated.</li>"
 		"</ol>",
 	NULL,
 	IF_NOT_THREADSAFE(EXIT_FAILURE),
-	"inside_SECOND_FINALLY_block____and_then____FIRST_FINALLY_block",
+	IF_FAST_FAIL("before_THROW", "inside_SECOND_FINALLY_block____and_then____FIRST_FINALLY_block"),
 	"WildException"
 ){
 
@@ -12,12 +12,12 @@ DEFINE_TEST_LONG_DESCRIPTION(
 		"<li>The test throws an exception from inside the <code>try</code> block.</li>"
 		"<li>The <code>catch</code> block handles it.</li>"
 		"<li>The exception is <em>rethrown</em> from inside the <code>catch</code> block.</li>"
-		"<li>the <code>finally</code> block is executed.</li>"
+		"<li>the <code>finally</code> block is executed (unless <code>E4C_FAST_FAIL</code> was defined).</li>"
 		"<li>the program is terminated.</li>"
 		"</ol>",
 	NULL,
 	IF_NOT_THREADSAFE(EXIT_FAILURE),
-	"inside_FINALLY_block",
+	IF_FAST_FAIL("before_RETHROW", "inside_FINALLY_block"),
 	"WildException"
 ){
 
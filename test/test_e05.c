@@ -0,0 +1,73 @@
+
+# include "testing.h"
+
+
+DEFINE_TEST_LONG_DESCRIPTION(
+	e05,
+	"Uncaught exception with too many catch{...} blocks in fast-fail mode",
+	"This test checks the search phase of a fast-fail build when a <code>try</code> block has more than <code>E4C_MAX_CATCH_TYPES</code> <code>catch</code> blocks. The expected behavior is:"
+		"<ol>"
+		"<li>The test starts a <code>try</code> block with nine <code>catch</code> blocks and a <code>finally</code> block.</li>"
+		"<li>The test throws an exception from inside the <code>try</code> block.</li>",
+		"<li>None of the <code>catch</code> blocks handles it.</li>"
+		"<li>The search phase cannot tell, so the <code>finally</code> block is executed either way.</li>"
+		"<li>The program is terminated.</li>"
+		"</ol>",
+	NULL,
+	IF_NOT_THREADSAFE(EXIT_FAILURE),
+	"inside_FINALLY_block",
+	"WildException"
+){
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	ECHO(("before_TRY_CATCH_FINALLY_block\n"));
+
+	E4C_TRY{
+
+		ECHO(("before_THROW\n"));
+
+		E4C_THROW(WildException, "Nobody will catch me.");
+
+		/*@-unreachable@*/
+
+		ECHO(("after_THROW\n"));
+
+		/*@=unreachable@*/
+
+	}E4C_CATCH(NotEnoughMemoryException){
+		ECHO(("inside_CATCH_block\n"));
+	}E4C_CATCH(IllegalArgumentException){
+		ECHO(("inside_CATCH_block\n"));
+	}E4C_CATCH(InputOutputException){
+		ECHO(("inside_CATCH_block\n"));
+	}E4C_CATCH(ArithmeticException){
+		ECHO(("inside_CATCH_block\n"));
+	}E4C_CATCH(BrokenPipeException){
+		ECHO(("inside_CATCH_block\n"));
+	}E4C_CATCH(BadPointerException){
+		ECHO(("inside_CATCH_block\n"));
+	}E4C_CATCH(NullPointerException){
+		ECHO(("inside_CATCH_block\n"));
+	}E4C_CATCH(IllegalInstructionException){
+		ECHO(("inside_CATCH_block\n"));
+	}E4C_CATCH(SignalException){
+		ECHO(("inside_CATCH_block\n"));
+	}E4C_FINALLY{
+
+		ECHO(("inside_FINALLY_block\n"));
+
+	}
+
+	ECHO(("after_TRY_CATCH_FINALLY_block\n"));
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	ECHO(("after_CONTEXT_END\n"));
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,71 @@
+
+# include "testing.h"
+
+
+static void aux(int index)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+{
+
+	if(index % 2 != 0){
+
+		ECHO(("before_THROW_%d\n", index));
+
+		E4C_THROW(TamedException, "I'm going to be caught.");
+	}
+
+	ECHO(("no_exception_was_thrown_%d\n", index));
+}
+
+DEFINE_TEST(
+	f08,
+	"Catching exceptions thrown in a loop",
+	"This test starts a <code>try_each</code> block that iterates six times. The odd iterations throw an exception that is caught by a <code>catch(TamedException)</code> right next to the <code>try_each</code> block. The loop keeps going after each caught exception, and the <code>finally</code> block is executed once per iteration.",
+	NULL,
+	EXIT_SUCCESS,
+	"caught_3_finalized_6",
+	NULL
+){
+
+	volatile int	caught		= 0;
+	volatile int	finalized	= 0;
+	int				index;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	ECHO(("before_TRY_EACH_block\n"));
+
+	E4C_TRY_EACH(index = 0, index < 6, index++){
+
+		aux(index);
+
+	}E4C_CATCH(TamedException){
+
+		caught++;
+
+		ECHO(("inside_CATCH_block_%d\n", index));
+
+	}E4C_FINALLY{
+
+		finalized++;
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	ECHO(("caught_%d_finalized_%d\n", caught, finalized));
+
+	return(EXIT_SUCCESS);
+}
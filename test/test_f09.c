@@ -0,0 +1,77 @@
+
+# include "testing.h"
+
+
+static void aux(int index)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+{
+
+	if(index % 3 != 0){
+
+		ECHO(("no_exception_was_thrown_%d\n", index));
+
+	}else if(index == 3){
+
+		/* this exception will go through a finally block before being collected */
+		E4C_TRY{
+
+			E4C_THROW(TamedException, "Item #3 is wrong.");
+
+		}E4C_FINALLY{
+
+			ECHO(("inside_FINALLY_block_%d\n", index));
+		}
+
+	}else{
+
+		E4C_THROW(TamedException, "This item is wrong.");
+	}
+}
+
+DEFINE_TEST(
+	f09,
+	"Collecting exceptions thrown in a batch",
+	"This test starts a <code>batch_each</code> block that processes ten items. Every third item throws an exception (one of them through an inner <code>finally</code> block), and the batch records the failures in an array that can only hold three of them. The loop keeps going after each failure; eventually, the batch holds three failures and counts one more as overflow.",
+	NULL,
+	EXIT_SUCCESS,
+	"count_3_overflow_1_indices_0_3_6",
+	NULL
+){
+
+	e4c_batch_error	errors[3];
+	e4c_batch		batch;
+	int				index;
+
+	e4c_batch_init(&batch, errors, 3);
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	ECHO(("before_BATCH_EACH_block\n"));
+
+	E4C_BATCH_EACH(batch, index, 10){
+
+		aux(index);
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	ECHO(("message_was_%s\n", errors[1].message));
+
+	ECHO(("count_%d_overflow_%d_indices_%d_%d_%d\n", batch.count, batch.overflow, errors[0].index, errors[1].index, errors[2].index));
+
+	return(EXIT_SUCCESS);
+}
@@ -185,7 +185,7 @@ DEFINE_TEST_LONG_DESCRIPTION(
 		"Then the external function calls some function from another library, which opens another <code>e4c_reusing_context</code>. The exception context is <em>reused</em> again. Then, an exception is thrown. The second external function does not catch it. The exception is propagated to the first external function, which does not catch it either. Finally, the caller of the first external function catches the exception and then continues.",
 	NULL,
 	IF_NOT_THREADSAFE(EXIT_FAILURE),
-	"inside_FINALLY_block",
+	IF_FAST_FAIL("______aux_before_THROW", "inside_FINALLY_block"),
 	"WildException"
 ){
 
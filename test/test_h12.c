@@ -0,0 +1,100 @@
+
+# include <errno.h>
+# include "testing.h"
+
+
+static const e4c_error_mapping error_mappings[] = {
+	E4C_ERROR_MAPPING(IllegalArgumentException,	-1,		EDOM),
+	E4C_ERROR_MAPPING(BadPointerException,		-2,		ERANGE),
+	E4C_ERROR_MAPPING(RuntimeException,			-3,		EDOM),
+	E4C_DEFAULT_ERROR_MAPPING(					-99,	0)
+};
+
+static void aux(/*@null@*/ void * pointer)
+/*@globals
+	fileSystem,
+	internalState,
+
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+{
+	if(pointer == NULL){
+		ECHO(("____aux_before_THROW\n"));
+		E4C_THROW(NullPointerException, "The ERROR_BOUNDARY block will map me.");
+	}else{
+		ECHO(("____aux_no_exception_was_thrown\n"));
+	}
+}
+
+static int ext(void)
+/*@globals
+	fileSystem,
+	internalState,
+
+	error_mappings,
+
+	NotEnoughMemoryException,
+	NullPointerException
+@*/
+/*@modifies
+	fileSystem,
+	internalState
+@*/
+{
+
+	volatile int status = 0;
+
+	ECHO(("__ext_before_ERROR_BOUNDARY\n"));
+
+	{
+		e4c_error_boundary(status, error_mappings){
+
+			ECHO(("__ext_before_CALL_FUNCTION_aux\n"));
+
+			aux(NULL);
+
+			ECHO(("__ext_after_CALL_FUNCTION_aux\n"));
+		}
+	}
+
+	ECHO(("__ext_after_ERROR_BOUNDARY\n"));
+
+	if( e4c_context_is_ready() ){
+		ECHO(("__ext_oops_the_context_IS_ready\n"));
+	}
+
+	return(status);
+}
+
+DEFINE_TEST(
+	h12,
+	"A library maps an uncaught exception to an error code",
+	"This tests simulates a call to an external function (as in a library function). The client code is <em>exception-unaware</em>, but the external function uses the exception framework. So the external function opens a <code>e4c_error_boundary</code> block, along with a static table of error mappings. The external function does not catch an exception, but the table maps it (through its supertype) to the error code that is returned to its caller, and to the value of <code>errno</code>.",
+	NULL,
+	EXIT_SUCCESS,
+	"result_was_-2",
+	NULL
+){
+	int result;
+
+	errno = 0;
+
+	ECHO(("before_CALL_FUNCTION_ext\n"));
+
+	result = ext();
+
+	ECHO(("after_CALL_FUNCTION_ext\n"));
+
+	if(errno == ERANGE){
+		ECHO(("result_was_%d\n", result));
+	}else{
+		ECHO(("oops_errno_was_NOT_mapped\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,62 @@
+
+# include <string.h>
+# include "testing.h"
+
+
+DEFINE_TEST(
+	h13,
+	"Formatting an exception into a buffer",
+	"This test catches an exception (which was caused by another one) and renders it into a buffer through <code>e4c_format_exception</code>. The rendered text must include the cause, but not the type hierarchy, since only the flag <code>E4C_FORMAT_CAUSES</code> is passed. Then the exception is rendered into a very small buffer, so the text must be truncated.",
+	NULL,
+	EXIT_SUCCESS,
+	"formatted_properly",
+	NULL
+){
+
+	char		buffer[1024];
+	char		small_buffer[16];
+	size_t		length			= 0;
+	size_t		small_length	= 0;
+	E4C_BOOL	has_cause		= E4C_FALSE;
+	E4C_BOOL	has_hierarchy	= E4C_TRUE;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	E4C_TRY{
+
+		E4C_TRY{
+
+			E4C_THROW(NullPointerException, "I'm the cause.");
+
+		}E4C_CATCH(NullPointerException){
+
+			E4C_THROW(TamedException, "I'm the effect.");
+		}
+
+	}E4C_CATCH(TamedException){
+
+		length = e4c_format_exception(buffer, sizeof(buffer), e4c_get_exception(), E4C_FORMAT_CAUSES);
+
+		small_length = e4c_format_exception(small_buffer, sizeof(small_buffer), e4c_get_exception(), E4C_FORMAT_CAUSES | E4C_FORMAT_HIERARCHY);
+
+		has_cause		= ( strstr(buffer, "Caused by NullPointerException: I'm the cause.") != NULL );
+		has_hierarchy	= ( strstr(buffer, "Exception hierarchy") != NULL );
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	if(has_cause && !has_hierarchy && length == strlen(buffer) && small_length == sizeof(small_buffer) - 1 && strncmp(small_buffer, "TamedException:", small_length) == 0){
+
+		ECHO(("formatted_properly\n"));
+
+	}else{
+
+		ECHO(("oops_formatted_wrong\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,57 @@
+
+# include "testing.h"
+
+
+DEFINE_TEST(
+	h14,
+	"Flight recorder",
+	"This test sets a flight recorder with room for two records, then throws and catches three exceptions. The flight recorder must keep the last two of them, overwriting the oldest one. Then the flight recorders are printed out through <code>e4c_print_flight_recorders</code>.",
+	NULL,
+	EXIT_SUCCESS,
+	"recorded_properly",
+	"recorder"
+){
+
+	e4c_flight_record	records[2];
+	int					index;
+	int					line			= 0;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	e4c_context_set_flight_recorder(records, 2);
+
+	for(index = 0; index < 3; index++){
+
+		E4C_TRY{
+
+			if(index == 1){
+				E4C_THROW(IllegalArgumentException, NULL);
+			}
+
+			line = __LINE__; E4C_THROW(TamedException, NULL);
+
+		}E4C_CATCH(RuntimeException){
+
+			ECHO(("caught_%s\n", e4c_get_exception()->name));
+		}
+	}
+
+	e4c_print_flight_recorders();
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	if(records[0].type == &TamedException && records[1].type == &IllegalArgumentException && records[0].line == line && records[1].function != NULL){
+
+		ECHO(("recorded_properly\n"));
+
+	}else{
+
+		ECHO(("oops_recorded_wrong\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,68 @@
+
+# include "testing.h"
+
+
+DEFINE_TEST(
+	h15,
+	"Exception statistics",
+	"This test throws an exception from the same site three times, catching it and retrying the <code>try</code> block twice. Then it aggregates the statistics through <code>e4c_get_statistics</code>. If the library was compiled with <code>E4C_STATISTICS</code>, the site must have been counted three times as thrown and caught, and twice as retried; otherwise, nothing must have been counted.",
+	NULL,
+	EXIT_SUCCESS,
+	"counted_properly",
+	NULL
+){
+
+	e4c_statistic	statistics[16];
+	int				count;
+	int				index;
+	volatile int	line			= 0;
+	E4C_BOOL		counted			= E4C_FALSE;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	E4C_TRY{
+
+		line = __LINE__; E4C_THROW(TamedException, NULL);
+
+	}E4C_CATCH(TamedException){
+
+		ECHO(("caught_exception\n"));
+
+		E4C_RETRY(2);
+	}
+
+	count = e4c_get_statistics(statistics, 16);
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+# ifdef E4C_STATISTICS
+
+	for(index = 0; index < count; index++){
+		if(statistics[index].type == &TamedException && statistics[index].line == line){
+			counted = (statistics[index].thrown == 3UL && statistics[index].caught == 3UL && statistics[index].retried == 2UL && statistics[index].uncaught == 0UL);
+		}
+	}
+
+# else
+
+	/* (the site was reached, but nothing must have been counted) */
+	index	= 0;
+	counted	= (count == index && line != 0);
+
+# endif
+
+	if(counted){
+
+		ECHO(("counted_properly\n"));
+
+	}else{
+
+		ECHO(("oops_counted_wrong\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,63 @@
+
+# include "testing.h"
+
+
+DEFINE_TEST(
+	h16,
+	"Live frames and exceptions",
+	"This test counts the frames and exceptions alive through <code>e4c_get_live_objects</code>, from within two nested <code>try</code> blocks and from a <code>catch</code> block. If the library was compiled with <code>E4C_STATISTICS</code>, there must be two frames alive in the inner block, and one exception alive in the <code>catch</code> block; then, once the blocks are completed, there must be nothing alive. Otherwise, nothing must have been counted.",
+	NULL,
+	EXIT_SUCCESS,
+	"counted_properly",
+	NULL
+){
+
+	long		frames			= -1L;
+	long		exceptions		= -1L;
+	long		frames_caught	= -1L;
+	long		exceptions_caught = -1L;
+	long		frames_after	= -1L;
+	long		exceptions_after = -1L;
+	E4C_BOOL	counted;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	E4C_TRY{
+
+		E4C_TRY{
+
+			e4c_get_live_objects(&frames, &exceptions);
+
+			E4C_THROW(TamedException, NULL);
+
+		}E4C_CATCH(TamedException){
+
+			e4c_get_live_objects(&frames_caught, &exceptions_caught);
+		}
+	}
+
+	e4c_get_live_objects(&frames_after, &exceptions_after);
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+# ifdef E4C_STATISTICS
+	counted = (frames == 2L && exceptions == 0L && frames_caught == 2L && exceptions_caught == 1L && frames_after == 0L && exceptions_after == 0L);
+# else
+	counted = (frames == 0L && exceptions == 0L && frames_caught == 0L && exceptions_caught == 0L && frames_after == 0L && exceptions_after == 0L);
+# endif
+
+	if(counted){
+
+		ECHO(("counted_properly\n"));
+
+	}else{
+
+		ECHO(("oops_counted_wrong\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
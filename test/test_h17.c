@@ -0,0 +1,108 @@
+
+# include "testing.h"
+
+
+static int events[e4c_event_propagate + 1];
+static int max_depth = 0;
+
+static void count_event(e4c_event event, const e4c_event_info * info){
+
+	events[event]++;
+
+	if(info->depth > max_depth){
+		max_depth = info->depth;
+	}
+
+	if( (event == e4c_event_throw || event == e4c_event_catch) && info->exception == NULL ){
+		ECHO(("oops_no_exception\n"));
+	}
+
+	if(info->data != (void *)events){
+		ECHO(("oops_wrong_data\n"));
+	}
+}
+
+DEFINE_TEST_LONG_DESCRIPTION(
+	h17,
+	"Event handler",
+	"This test sets an event handler, then throws an exception from a nested <code>try</code> block, which propagates through a <code>try</code> block with a <code>finally</code> block and two <code>try</code> blocks whose <code>catch</code> blocks do not handle it, up to the outer block, where it is caught and retried once.",
+	" The handler must be notified of every event (exactly once for every block left by the exception, even if there was nothing to do in it), along with the data passed to <code>e4c_context_set_event_handler</code> and the depth of the blocks.",
+	NULL,
+	EXIT_SUCCESS,
+	"notified_properly",
+	NULL
+){
+
+	volatile int retries = 0;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	e4c_context_set_event_handler(count_event, events);
+
+	E4C_TRY{
+
+		E4C_TRY{
+
+			E4C_TRY{
+
+				E4C_TRY{
+
+					E4C_TRY{
+
+						if(retries == 0){
+							E4C_THROW(IllegalArgumentException, NULL);
+						}
+
+					}E4C_CATCH(NullPointerException){
+
+						ECHO(("oops_caught_npe\n"));
+					}
+
+				}E4C_FINALLY{
+
+					ECHO(("finally_%d\n", retries));
+				}
+
+			}E4C_CATCH(NullPointerException){
+
+				ECHO(("oops_caught_npe\n"));
+			}
+
+		}E4C_CATCH(NullPointerException){
+
+			ECHO(("oops_caught_npe\n"));
+		}
+
+	}E4C_CATCH(IllegalArgumentException){
+
+		ECHO(("caught_%s\n", e4c_get_exception()->name));
+
+		retries++;
+		E4C_RETRY(1);
+	}
+
+	e4c_context_set_event_handler(NULL, NULL);
+
+	E4C_TRY{
+		ECHO(("not_notified\n"));
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	ECHO(("enter=%d exit=%d throw=%d catch=%d retry=%d propagate=%d depth=%d\n", events[e4c_event_enter], events[e4c_event_exit], events[e4c_event_throw], events[e4c_event_catch], events[e4c_event_retry], events[e4c_event_propagate], max_depth));
+
+	if(events[e4c_event_enter] == 9 && events[e4c_event_exit] == 9 && events[e4c_event_throw] == 1 && events[e4c_event_catch] == 1 && events[e4c_event_retry] == 1 && events[e4c_event_reacquire] == 0 && events[e4c_event_propagate] == 4 && max_depth == 5){
+
+		ECHO(("notified_properly\n"));
+
+	}else{
+
+		ECHO(("oops_notified_wrong\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,116 @@
+# include "testing.h"
+
+
+static e4c_latency latencies[16];
+
+# ifdef E4C_STATISTICS
+
+static E4C_BOOL check_latency(const e4c_latency * latency, unsigned long succeeded, unsigned long recovered, unsigned long failed){
+
+	unsigned long	total;
+	int				status;
+	int				bucket;
+
+	if(latency->count[e4c_succeeded] != succeeded || latency->count[e4c_recovered] != recovered || latency->count[e4c_failed] != failed){
+		return(E4C_FALSE);
+	}
+
+	for(status = (int)e4c_succeeded; status <= (int)e4c_failed; status++){
+		for(bucket = 0, total = 0UL; bucket < E4C_LATENCY_BUCKETS; bucket++){
+			total += latency->buckets[status][bucket];
+		}
+		if(total != latency->count[status]){
+			return(E4C_FALSE);
+		}
+	}
+
+	return(E4C_TRUE);
+}
+
+# endif
+
+DEFINE_TEST(
+	h18,
+	"Latency histograms",
+	"This test executes a <code>try</code> block three times, throwing and catching an exception in the second one. Then another <code>try</code> block lets an exception go uncaught. Finally, it aggregates the latencies through <code>e4c_get_latencies</code>. If the library was compiled with <code>E4C_STATISTICS</code>, the first site must have been measured twice as succeeded and once as recovered, and the second one once as failed; otherwise, nothing must have been measured.",
+	NULL,
+	EXIT_SUCCESS,
+	"measured_properly",
+	NULL
+){
+
+	volatile int	iteration;
+	int				count;
+	volatile int	line_a			= 0;
+	volatile int	line_b			= 0;
+# ifdef E4C_STATISTICS
+	int				index;
+# endif
+	E4C_BOOL		measured_a		= E4C_FALSE;
+	E4C_BOOL		measured_b		= E4C_FALSE;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	for(iteration = 0; iteration < 3; iteration++){
+
+		line_a = __LINE__; E4C_TRY{
+
+			if(iteration == 1){
+				E4C_THROW(TamedException, NULL);
+			}
+
+		}E4C_CATCH(TamedException){
+
+			ECHO(("caught_exception\n"));
+		}
+	}
+
+	E4C_TRY{
+
+		line_b = __LINE__; E4C_TRY{
+
+			E4C_THROW(TamedException, NULL);
+		}
+
+	}E4C_CATCH(TamedException){
+
+		ECHO(("caught_exception\n"));
+	}
+
+	count = e4c_get_latencies(latencies, 16);
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+# ifdef E4C_STATISTICS
+
+	for(index = 0; index < count; index++){
+		if(latencies[index].line == line_a){
+			measured_a = check_latency(&latencies[index], 2UL, 1UL, 0UL);
+		}else if(latencies[index].line == line_b){
+			measured_b = check_latency(&latencies[index], 0UL, 0UL, 1UL);
+		}
+	}
+
+# else
+
+	/* (the sites were not measured, no matter their lines) */
+	measured_a	= (count == 0 && line_a != 0);
+	measured_b	= (count == 0 && line_b != 0);
+
+# endif
+
+	if(measured_a && measured_b){
+
+		ECHO(("measured_properly\n"));
+
+	}else{
+
+		ECHO(("oops_measured_wrong\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
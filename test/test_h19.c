@@ -0,0 +1,78 @@
+
+# include "testing.h"
+
+
+struct request_error{
+
+	long	request_id;
+	int		code;
+};
+
+static long initialized_request_id = 0L;
+
+static void * initialize_handler(const e4c_exception * exception){
+
+	/* the payload is already there when the custom data is initialized */
+	initialized_request_id = E4C_GET_PAYLOAD(exception, struct request_error)->request_id;
+
+	return(NULL);
+}
+
+
+DEFINE_TEST(
+	h19,
+	"Exception payload",
+	"This test throws an exception carrying a payload (a request id and an error code) through <code>E4C_THROW_PAYLOAD</code>. The payload must be readable from the initialize handler and from the <code>catch</code> block, and the payload of an exception thrown through <code>E4C_THROW</code> must be zero.",
+	NULL,
+	EXIT_SUCCESS,
+	"payload_carried",
+	NULL
+){
+
+	struct request_error	error			= {42L, 503};
+	long					request_id		= 0L;
+	int						code			= 0;
+	int						plain_payload	= -1;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_FALSE);
+
+	e4c_context_set_handlers(NULL, NULL, initialize_handler, NULL);
+
+	E4C_TRY{
+
+		E4C_THROW_PAYLOAD(IllegalArgumentException, "Service unavailable.", error);
+
+	}E4C_CATCH(RuntimeException){
+
+		request_id	= E4C_GET_PAYLOAD(e4c_get_exception(), struct request_error)->request_id;
+		code		= E4C_GET_PAYLOAD(e4c_get_exception(), struct request_error)->code;
+	}
+
+	e4c_context_set_handlers(NULL, NULL, NULL, NULL);
+
+	E4C_TRY{
+
+		E4C_THROW(IllegalArgumentException, NULL);
+
+	}E4C_CATCH(RuntimeException){
+
+		plain_payload = *E4C_GET_PAYLOAD(e4c_get_exception(), int);
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	if(request_id == 42L && code == 503 && initialized_request_id == 42L && plain_payload == 0){
+
+		ECHO(("payload_carried\n"));
+
+	}else{
+
+		ECHO(("oops_payload_lost\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,105 @@
+
+# include "testing.h"
+
+
+static int context_initialized	= 0;
+static int context_finalized	= 0;
+static int type_initialized		= 0;
+static int type_finalized		= 0;
+static int context_data			= 0;
+
+static void * initialize_context_data(const e4c_exception * exception){
+
+	context_initialized++;
+
+	return(exception->custom_data);
+}
+
+static void finalize_context_data(void * custom_data){
+
+	(void)custom_data;
+
+	context_finalized++;
+}
+
+static void * initialize_type_data(const e4c_exception * exception){
+
+	type_initialized++;
+
+	return(exception->custom_data);
+}
+
+static void finalize_type_data(void * custom_data){
+
+	(void)custom_data;
+
+	type_finalized++;
+}
+
+static const e4c_type_handler type_handlers[] = {
+	E4C_TYPE_HANDLER(SignalException, initialize_type_data, finalize_type_data),
+	E4C_TYPE_HANDLER(ControlSignalException, NULL, NULL),
+	E4C_NULL_TYPE_HANDLER
+};
+
+
+DEFINE_TEST_LONG_DESCRIPTION(
+	h20,
+	"Type handlers",
+	"This test sets the handlers and custom data of the exception context, along with handlers for <code>SignalException</code> and no handlers for <code>ControlSignalException</code>.",
+	" Then it throws an <code>ArithmeticException</code> (handled by the handlers of its closest supertype that has them), a <code>StopException</code> (not handled at all, so its custom data must be <code>NULL</code>) and an <code>IllegalArgumentException</code> (handled by the handlers of the context), twice each, so that the resolved handlers are cached.",
+	NULL,
+	EXIT_SUCCESS,
+	"handled_per_type",
+	NULL
+){
+
+	int			index;
+	E4C_BOOL	opted_out	= E4C_TRUE;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_FALSE);
+
+	e4c_context_set_handlers(NULL, &context_data, initialize_context_data, finalize_context_data);
+	e4c_context_set_type_handlers(type_handlers);
+
+	for(index = 0; index < 2; index++){
+
+		E4C_TRY{
+			E4C_THROW(ArithmeticException, NULL);
+		}E4C_CATCH(RuntimeException){
+			ECHO(("caught_%s\n", e4c_get_exception()->name));
+		}
+
+		E4C_TRY{
+			E4C_THROW(StopException, NULL);
+		}E4C_CATCH(RuntimeException){
+			ECHO(("caught_%s\n", e4c_get_exception()->name));
+			if(e4c_get_exception()->custom_data != NULL){
+				opted_out = E4C_FALSE;
+			}
+		}
+
+		E4C_TRY{
+			E4C_THROW(IllegalArgumentException, NULL);
+		}E4C_CATCH(RuntimeException){
+			ECHO(("caught_%s\n", e4c_get_exception()->name));
+		}
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	if(opted_out && type_initialized == 2 && type_finalized == 2 && context_initialized == 2 && context_finalized == 2){
+
+		ECHO(("handled_per_type\n"));
+
+	}else{
+
+		ECHO(("oops_handled_wrong_%d_%d_%d_%d_%d\n", (int)opted_out, type_initialized, type_finalized, context_initialized, context_finalized));
+	}
+
+	return(EXIT_SUCCESS);
+}
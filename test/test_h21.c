@@ -0,0 +1,95 @@
+
+# include "testing.h"
+
+
+# define REPETITIONS (E4C_MAX_CAUSE_DEPTH * 2 + 8)
+
+
+static int initialized	= 0;
+static int finalized	= 0;
+
+static void * initialize_data(const e4c_exception * exception){
+
+	initialized++;
+
+	return(exception->custom_data);
+}
+
+static void finalize_data(void * custom_data){
+
+	(void)custom_data;
+
+	finalized++;
+}
+
+static void rethrow(int times){
+
+	E4C_TRY{
+
+		if(times == 0){
+			E4C_THROW(IllegalArgumentException, NULL);
+		}
+
+		rethrow(times - 1);
+
+	}E4C_CATCH(RuntimeException){
+
+		E4C_THROW(IllegalArgumentException, NULL);
+	}
+}
+
+
+DEFINE_TEST(
+	h21,
+	"Bounded chain of causes",
+	"This test rethrows an exception many more times than <code>E4C_MAX_CAUSE_DEPTH</code>, so that each new exception gets the previous one as its cause. The chain of causes must be bounded: the oldest causes must be replaced by a single <code>OmittedCausesException</code> that carries the number of omitted causes, and every exception must be finalized.",
+	NULL,
+	EXIT_SUCCESS,
+	"causes_bounded",
+	NULL
+){
+
+	const e4c_exception *	cause;
+	int						length		= 0;
+	long					omitted		= 0L;
+	E4C_BOOL				summarized	= E4C_FALSE;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_FALSE);
+
+	e4c_context_set_handlers(NULL, NULL, initialize_data, finalize_data);
+
+	E4C_TRY{
+
+		rethrow(REPETITIONS);
+
+	}E4C_CATCH(RuntimeException){
+
+		for(cause = e4c_get_exception()->cause; cause != NULL; cause = cause->cause){
+
+			length++;
+
+			if(cause->type == &OmittedCausesException && cause->cause == NULL){
+				summarized	= E4C_TRUE;
+				omitted		= *E4C_GET_PAYLOAD(cause, long);
+			}
+		}
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	/* (the exception thrown and its causes add up to REPETITIONS + 2) */
+	if(summarized && length == E4C_MAX_CAUSE_DEPTH + 1 && omitted == REPETITIONS + 1 - E4C_MAX_CAUSE_DEPTH && initialized == finalized){
+
+		ECHO(("causes_bounded\n"));
+
+	}else{
+
+		ECHO(("oops_causes_unbounded_%d_%ld_%d_%d\n", length, omitted, initialized, finalized));
+	}
+
+	return(EXIT_SUCCESS);
+}
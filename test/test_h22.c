@@ -0,0 +1,95 @@
+
+# include <string.h>
+# include "testing.h"
+
+
+static int first_finalized	= 0;
+static int second_finalized	= 0;
+
+static void finalize_first(void * custom_data){
+
+	(void)custom_data;
+
+	first_finalized++;
+}
+
+static void finalize_second(void * custom_data){
+
+	(void)custom_data;
+
+	second_finalized++;
+}
+
+
+DEFINE_TEST(
+	h22,
+	"Foreign exception",
+	"This test retains an exception (caused by another one) from a <code>catch</code> block and ends the exception context. Then it begins a new exception context, with a different finalize handler, and throws the retained exception through <code>e4c_rethrow_foreign</code>. The very same exception (and its cause) must be caught, and it must be finalized by the handler of the first context only when the last reference is released, outside any exception context.",
+	NULL,
+	EXIT_SUCCESS,
+	"foreign_rethrown",
+	NULL
+){
+
+	const e4c_exception *	transferred		= NULL;
+	E4C_BOOL				same_exception	= E4C_FALSE;
+	E4C_BOOL				same_cause		= E4C_FALSE;
+	int						finalized_early;
+
+	ECHO(("before_FIRST_CONTEXT\n"));
+
+	e4c_context_begin(E4C_FALSE);
+
+	e4c_context_set_handlers(NULL, NULL, NULL, finalize_first);
+
+	E4C_TRY{
+
+		E4C_TRY{
+			E4C_THROW(IllegalArgumentException, "first");
+		}E4C_CATCH(RuntimeException){
+			E4C_RETHROW("second");
+		}
+
+	}E4C_CATCH(RuntimeException){
+
+		/* one reference is handed over, the other one is released later */
+		transferred = e4c_exception_retain( e4c_exception_retain( e4c_get_exception() ) );
+	}
+
+	e4c_context_end();
+
+	ECHO(("before_SECOND_CONTEXT\n"));
+
+	e4c_context_begin(E4C_FALSE);
+
+	e4c_context_set_handlers(NULL, NULL, NULL, finalize_second);
+
+	E4C_TRY{
+
+		e4c_rethrow_foreign(transferred);
+
+	}E4C_CATCH(IllegalArgumentException){
+
+		same_exception	= (e4c_get_exception() == transferred);
+		same_cause		= (e4c_get_exception()->cause != NULL && strcmp(e4c_get_exception()->cause->message, "first") == 0);
+	}
+
+	e4c_context_end();
+
+	finalized_early = first_finalized;
+
+	ECHO(("before_RELEASE\n"));
+
+	e4c_exception_release(transferred);
+
+	if(same_exception && same_cause && finalized_early == 0 && first_finalized == 2 && second_finalized == 0){
+
+		ECHO(("foreign_rethrown\n"));
+
+	}else{
+
+		ECHO(("oops_foreign_lost_%d_%d_%d_%d_%d\n", same_exception, same_cause, finalized_early, first_finalized, second_finalized));
+	}
+
+	return(EXIT_SUCCESS);
+}
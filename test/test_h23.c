@@ -0,0 +1,34 @@
+
+# include "testing.h"
+
+
+E4C_DEFINE_EXCEPTION(IndependentException, "This exception does not extend RuntimeException.", IndependentException);
+
+
+DEFINE_TEST(
+	h23,
+	"Boundary and exceptions not extending RuntimeException",
+	"This test starts a <code>e4c_reusing_context</code> block when there is no exception context, and throws an exception whose type does not extend <code>RuntimeException</code>. Since a <code>catch(RuntimeException)</code> block would not catch it, the boundary must not convert it into a status value either; it must be reported as an uncaught exception.",
+	NULL,
+	IF_NOT_THREADSAFE(EXIT_FAILURE),
+	"before_THROW",
+	"IndependentException"
+){
+
+	volatile int status = 123;
+
+	ECHO(("before_REUSING_CONTEXT\n"));
+
+	{
+		e4c_reusing_context(status, -123){
+
+			ECHO(("before_THROW\n"));
+
+			E4C_THROW(IndependentException, "The boundary will not convert me.");
+		}
+	}
+
+	ECHO(("after_REUSING_CONTEXT_%d\n", status));
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,57 @@
+# include "testing.h"
+
+
+DEFINE_TEST(
+	h24,
+	"Search phase finding an outer catch{...} block",
+	"This test throws an exception from a <code>try</code> block nested inside a <code>try</code> block whose <code>catch</code> blocks do not handle it, which is in turn nested inside a <code>try</code> block that does. The search phase of a fast-fail build must find the outermost <code>catch</code> block, so the program is not terminated and the pending <code>finally</code> blocks are executed, just like in any other build.",
+	NULL,
+	EXIT_SUCCESS,
+	"after_CONTEXT_END",
+	NULL
+){
+
+	volatile E4C_BOOL finalized	= E4C_FALSE;
+	volatile E4C_BOOL caught	= E4C_FALSE;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	E4C_TRY{
+
+		E4C_TRY{
+
+			E4C_TRY{
+
+				ECHO(("before_THROW\n"));
+
+				E4C_THROW(WildException, "Somebody will catch me.");
+
+			}E4C_FINALLY{
+
+				ECHO(("inside_FINALLY_block\n"));
+
+				finalized = E4C_TRUE;
+			}
+
+		}E4C_CATCH(NullPointerException){
+
+			ECHO(("inside_wrong_CATCH_block\n"));
+		}
+
+	}E4C_CATCH(RuntimeException){
+
+		ECHO(("inside_CATCH_block\n"));
+
+		caught = E4C_TRUE;
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	ECHO(("after_CONTEXT_END\n"));
+
+	return( finalized && caught ? EXIT_SUCCESS : EXIT_FAILURE );
+}
@@ -0,0 +1,94 @@
+# include "testing.h"
+
+# define DEPTH 64
+
+
+static int finalized	= 0;
+static int disposed		= 0;
+static int acquired		= 0;
+
+
+static void dispose_level(int level, E4C_BOOL failed){
+
+	(void)level;
+
+	if(failed){
+		disposed++;
+	}
+}
+
+static void nest(int level){
+
+	volatile int resource;
+
+	if(level == DEPTH){
+
+		ECHO(("before_THROW\n"));
+
+		E4C_THROW(WildException, "Somebody will catch me.");
+	}
+
+	switch(level % 3){
+
+		case 0:
+			E4C_TRY{
+				nest(level + 1);
+			}E4C_FINALLY{
+				finalized++;
+			}
+			break;
+
+		case 1:
+			E4C_WITH(resource, dispose_level){
+				resource = level;
+				acquired++;
+			}E4C_USE{
+				nest(resource + 1);
+			}
+			break;
+
+		default:
+			E4C_TRY{
+				nest(level + 1);
+			}E4C_CATCH(NullPointerException){
+				ECHO(("inside_wrong_CATCH_block\n"));
+			}
+	}
+}
+
+
+DEFINE_TEST(
+	h25,
+	"Propagation through frames with and without pending work",
+	"This test throws an exception from a deep chain of nested blocks: <code>try</code> blocks with a <code>finally</code> block, <code>with... use</code> blocks, and <code>try</code> blocks whose <code>catch</code> blocks do not handle it. The exception is caught by the outermost <code>try</code> block. Every <code>finally</code> block must be executed and every resource must be disposed, even when the frames in between are skipped.",
+	NULL,
+	EXIT_SUCCESS,
+	"after_CONTEXT_END",
+	NULL
+){
+
+	volatile E4C_BOOL caught = E4C_FALSE;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_TRUE);
+
+	E4C_TRY{
+
+		nest(0);
+
+	}E4C_CATCH(RuntimeException){
+
+		ECHO(("inside_CATCH_block\n"));
+
+		caught = E4C_TRUE;
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	ECHO(("after_CONTEXT_END\n"));
+
+	return( caught && finalized == (DEPTH + 2) / 3 && acquired == (DEPTH + 1) / 3 && disposed == acquired ? EXIT_SUCCESS : EXIT_FAILURE );
+}
@@ -0,0 +1,70 @@
+# include "testing.h"
+
+
+static const struct{
+	long	seconds;
+	long	nanoseconds;
+	int		bucket;
+} durations[] = {
+	{ 0L,	0L,				0 },
+	{ 0L,	1L,				1 },
+	{ 0L,	2L,				2 },
+	{ 0L,	3L,				3 },
+	{ 0L,	4L,				4 },
+	{ 0L,	5L,				4 },
+	{ 0L,	6L,				5 },
+	{ 0L,	7L,				5 },
+	{ 0L,	8L,				6 },
+	{ 0L,	1023L,			19 },
+	{ 0L,	1024L,			20 },
+	{ 0L,	1535L,			20 },
+	{ 0L,	1536L,			21 },
+	{ 1L,	0L,				59 },
+	{ 0L,	1000000000L,	59 },
+	{ 2L,	147483647L,		61 },
+	{ 2L,	147483648L,		62 },
+	{ 3L,	221225471L,		62 },
+	{ 3L,	221225472L,		63 },
+	{ 3L,	999999999L,		63 },
+	{ 4L,	0L,				E4C_LATENCY_BUCKETS - 1 },
+	{ 3600L,	0L,				E4C_LATENCY_BUCKETS - 1 },
+	{ 0L,	-1L,			0 },
+	{ -1L,	999999999L,		0 }
+};
+
+DEFINE_TEST(
+	h26,
+	"Latency buckets",
+	"This test maps a number of durations to the buckets of a latency histogram through <code>e4c_latency_bucket</code>, including the first linear buckets, the boundaries between two buckets, the durations of four seconds or longer and the negative ones. Every duration must be mapped to the expected bucket.",
+	NULL,
+	EXIT_SUCCESS,
+	"mapped_properly",
+	NULL
+){
+
+	int			index;
+	int			bucket;
+	E4C_BOOL	mapped		= E4C_TRUE;
+
+	for(index = 0; index < (int)( sizeof(durations) / sizeof(durations[0]) ); index++){
+
+		bucket = e4c_latency_bucket(durations[index].seconds, durations[index].nanoseconds);
+
+		if(bucket != durations[index].bucket){
+
+			ECHO(("duration_%lds_%ldns_mapped_to_%d\n", durations[index].seconds, durations[index].nanoseconds, bucket));
+			mapped = E4C_FALSE;
+		}
+	}
+
+	if(mapped){
+
+		ECHO(("mapped_properly\n"));
+
+	}else{
+
+		ECHO(("oops_mapped_wrong\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
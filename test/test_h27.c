@@ -0,0 +1,87 @@
+# include "testing.h"
+
+
+# define REPETITIONS (E4C_MAX_CAUSE_DEPTH + 8)
+
+
+static const e4c_exception * retained[REPETITIONS + 1];
+
+static void rethrow(int times){
+
+	E4C_TRY{
+
+		if(times == 0){
+			E4C_THROW(IllegalArgumentException, NULL);
+		}
+
+		rethrow(times - 1);
+
+	}E4C_CATCH(RuntimeException){
+
+		/* (every exception of the chain is referenced elsewhere too) */
+		retained[times] = e4c_exception_retain( e4c_get_exception() );
+
+		E4C_THROW(IllegalArgumentException, NULL);
+	}
+}
+
+
+DEFINE_TEST(
+	h27,
+	"Shared chain of causes",
+	"This test rethrows an exception many more times than <code>E4C_MAX_CAUSE_DEPTH</code>, retaining every exception as soon as it is caught. Since the causes are referenced elsewhere, the chain of causes must not be modified: every retained exception must still have all of its causes, down to the first exception thrown.",
+	NULL,
+	EXIT_SUCCESS,
+	"causes_preserved",
+	NULL
+){
+
+	const e4c_exception *	cause;
+	int						index;
+	int						length;
+	E4C_BOOL				preserved	= E4C_TRUE;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_FALSE);
+
+	E4C_TRY{
+
+		rethrow(REPETITIONS);
+
+	}E4C_CATCH(RuntimeException){
+
+		ECHO(("caught_%s\n", e4c_get_exception()->name));
+	}
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+	/* (the exception retained at each level has as many causes as the level) */
+	for(index = 0; index <= REPETITIONS; index++){
+
+		for(length = 0, cause = retained[index]; cause->cause != NULL; cause = cause->cause){
+			length++;
+		}
+
+		if(length != index || cause != retained[0]){
+			preserved = E4C_FALSE;
+		}
+	}
+
+	for(index = 0; index <= REPETITIONS; index++){
+		e4c_exception_release(retained[index]);
+	}
+
+	if(preserved){
+
+		ECHO(("causes_preserved\n"));
+
+	}else{
+
+		ECHO(("oops_causes_modified\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
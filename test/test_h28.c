@@ -0,0 +1,70 @@
+# include "testing.h"
+
+
+DEFINE_TEST(
+	h28,
+	"Live foreign exceptions",
+	"This test retains an exception from a <code>catch</code> block and ends the exception context. Then it begins a new exception context and throws the retained exception through <code>e4c_rethrow_foreign</code>. If the library was compiled with <code>E4C_STATISTICS</code>, the exception must be counted as alive, exactly once, until it is caught in the new context; then there must be no exceptions alive. Otherwise, nothing must have been counted.",
+	NULL,
+	EXIT_SUCCESS,
+	"counted_properly",
+	NULL
+){
+
+	const e4c_exception *	foreign				= NULL;
+	long					exceptions_held		= -1L;
+	long					exceptions_caught	= -1L;
+	long					exceptions_after	= -1L;
+	E4C_BOOL				counted;
+
+	ECHO(("before_CONTEXT_BEGIN\n"));
+
+	e4c_context_begin(E4C_FALSE);
+
+	E4C_TRY{
+
+		E4C_THROW(TamedException, NULL);
+
+	}E4C_CATCH(TamedException){
+
+		foreign = e4c_exception_retain( e4c_get_exception() );
+	}
+
+	e4c_context_end();
+
+	e4c_context_begin(E4C_FALSE);
+
+	e4c_get_live_objects(NULL, &exceptions_held);
+
+	E4C_TRY{
+
+		E4C_RETHROW_FOREIGN(foreign);
+
+	}E4C_CATCH(TamedException){
+
+		e4c_get_live_objects(NULL, &exceptions_caught);
+	}
+
+	e4c_get_live_objects(NULL, &exceptions_after);
+
+	ECHO(("before_CONTEXT_END\n"));
+
+	e4c_context_end();
+
+# ifdef E4C_STATISTICS
+	counted = (exceptions_held == 1L && exceptions_caught == 1L && exceptions_after == 0L);
+# else
+	counted = (exceptions_held == 0L && exceptions_caught == 0L && exceptions_after == 0L);
+# endif
+
+	if(counted){
+
+		ECHO(("counted_properly\n"));
+
+	}else{
+
+		ECHO(("oops_counted_wrong_%ld_%ld_%ld\n", exceptions_held, exceptions_caught, exceptions_after));
+	}
+
+	return(EXIT_SUCCESS);
+}
@@ -0,0 +1,41 @@
+# include "testing.h"
+
+
+DEFINE_TEST(
+	h29,
+	"Automatic exception context",
+	"This test throws and catches an exception without calling <code>e4c_context_begin</code>. If the library was compiled with <code>E4C_AUTO_CONTEXT</code>, the exception context must be begun lazily by the <code>try</code> block and ended automatically when the program exits. Otherwise, the test begins and ends the exception context explicitly.",
+	NULL,
+	EXIT_SUCCESS,
+	"after_TRY_block",
+	NULL
+){
+
+# ifndef E4C_AUTO_CONTEXT
+	/* (without automatic contexts, the context has to be begun explicitly) */
+	e4c_context_begin(E4C_FALSE);
+# endif
+
+	ECHO(("before_TRY_block\n"));
+
+	E4C_TRY{
+
+		ECHO(("before_THROW\n"));
+
+		E4C_THROW(TamedException, NULL);
+
+		ECHO(("after_THROW\n"));
+
+	}E4C_CATCH(TamedException){
+
+		ECHO(("caught_exception\n"));
+	}
+
+	ECHO(("after_TRY_block\n"));
+
+# ifndef E4C_AUTO_CONTEXT
+	e4c_context_end();
+# endif
+
+	return(EXIT_SUCCESS);
+}
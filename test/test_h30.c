@@ -0,0 +1,73 @@
+# include "testing.h"
+
+
+# if defined(E4C_AUTO_CONTEXT) && defined(E4C_STATISTICS)
+
+# include <pthread.h>
+
+static long frames_inside = -1L;
+
+static void * throw_and_catch(void * arg){
+
+	E4C_TRY{
+
+		E4C_THROW(TamedException, NULL);
+
+	}E4C_CATCH(TamedException){
+
+		e4c_get_live_objects(&frames_inside, NULL);
+	}
+
+	/* (the exception context of this thread is ended when it exits) */
+	return(arg);
+}
+
+# endif
+
+DEFINE_TEST(
+	h30,
+	"Automatic exception context of a thread",
+	"This test starts a thread which throws and catches an exception without calling <code>e4c_context_begin</code>, and then waits for it to exit. If the library was compiled with <code>E4C_AUTO_CONTEXT</code> and <code>E4C_STATISTICS</code>, there must be live frames while the exception is caught; then, once the thread has exited, its exception context must have been destroyed, so there must be no frames or exceptions alive. Otherwise, nothing is checked.",
+	NULL,
+	EXIT_SUCCESS,
+	"destroyed_properly",
+	NULL
+){
+
+	E4C_BOOL		destroyed;
+# if defined(E4C_AUTO_CONTEXT) && defined(E4C_STATISTICS)
+	pthread_t		thread;
+	long			frames_after		= -1L;
+	long			exceptions_after	= -1L;
+
+	ECHO(("before_THREAD\n"));
+
+	if(pthread_create(&thread, NULL, throw_and_catch, NULL) != 0 || pthread_join(thread, NULL) != 0){
+
+		ECHO(("oops_no_thread\n"));
+
+		return(EXIT_FAILURE);
+	}
+
+	e4c_get_live_objects(&frames_after, &exceptions_after);
+
+	destroyed = (frames_inside > 0L && frames_after == 0L && exceptions_after == 0L);
+
+# else
+
+	/* (there is no automatic context to destroy) */
+	destroyed = E4C_TRUE;
+
+# endif
+
+	if(destroyed){
+
+		ECHO(("destroyed_properly\n"));
+
+	}else{
+
+		ECHO(("oops_destroyed_wrong\n"));
+	}
+
+	return(EXIT_SUCCESS);
+}
@@ -18,6 +18,12 @@
 #	define IF_NOT_THREADSAFE(EXIT_CODE) EXIT_CODE
 # endif
 
+# ifdef E4C_FAST_FAIL
+#	define IF_FAST_FAIL(OUTPUT, OTHERWISE) OUTPUT
+# else
+#	define IF_FAST_FAIL(OUTPUT, OTHERWISE) OTHERWISE
+# endif
+
 # define SEVERITY_CRITICAL		E4C_TRUE
 # define SEVERITY_NOT_CRITICAL	E4C_FALSE
 